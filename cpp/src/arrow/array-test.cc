@@ -17,8 +17,11 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -964,6 +967,29 @@ TEST_F(TestStringBuilder, TestZeroLength) {
   Done();
 }
 
+TEST_F(TestStringBuilder, BulkAppend) {
+  vector<string> strings = {"", "bb", "a", "dd", "ccc"};
+  vector<uint8_t> valid_bytes = {1, 1, 1, 0, 1};
+
+  ASSERT_OK(builder_->Append("first"));
+  ASSERT_OK(builder_->Append(strings, valid_bytes.data()));
+  ASSERT_OK(builder_->Append(strings));
+  Done();
+
+  ASSERT_EQ(11, result_->length());
+  ASSERT_EQ(1, result_->null_count());
+  ASSERT_EQ(5 + 6 + 8, result_->value_data()->size());
+  ASSERT_EQ("first", result_->GetString(0));
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(valid_bytes[i] == 0, result_->IsNull(i + 1));
+    if (valid_bytes[i]) {
+      ASSERT_EQ(strings[i], result_->GetString(i + 1));
+    }
+    ASSERT_EQ(strings[i], result_->GetString(i + 6));
+  }
+  ASSERT_EQ(result_->value_offset(4), result_->value_offset(5));
+}
+
 // Binary container type
 // TODO(emkornfield) there should be some way to refactor these to avoid code duplicating
 // with String
@@ -1137,6 +1163,88 @@ TEST_F(TestBinaryBuilder, TestZeroLength) {
   Done();
 }
 
+TEST_F(TestBinaryBuilder, AppendValues) {
+  // Offsets into a larger buffer, as produced by a decoder.
+  const std::string data = "xxabbcccdddd";
+  vector<int32_t> offsets = {2, 3, 5, 5, 8, 12};
+  vector<uint8_t> valid_bytes = {1, 1, 0, 1, 1};
+  vector<string> expected = {"a", "bb", "", "ccc", "dddd"};
+
+  ASSERT_OK(builder_->Append("first"));
+  ASSERT_OK(builder_->AppendValues(offsets.data(),
+                                   reinterpret_cast<const uint8_t*>(data.data()), 5,
+                                   valid_bytes.data()));
+  ASSERT_OK(builder_->AppendValues(offsets.data(),
+                                   reinterpret_cast<const uint8_t*>(data.data()), 5));
+  ASSERT_OK(builder_->AppendNull());
+  // An empty sequence is a no-op.
+  ASSERT_OK(builder_->AppendValues(offsets.data(),
+                                   reinterpret_cast<const uint8_t*>(data.data()), 0));
+  ASSERT_EQ(12, builder_->length());
+  ASSERT_EQ(25, builder_->value_data_length());
+
+  vector<int32_t> too_large = {0, std::numeric_limits<int32_t>::max()};
+  ASSERT_RAISES(Invalid,
+                builder_->AppendValues(too_large.data(),
+                                       reinterpret_cast<const uint8_t*>(data.data()), 1));
+  Done();
+
+  ASSERT_EQ(12, result_->length());
+  ASSERT_EQ(2, result_->null_count());
+  ASSERT_EQ(25, result_->value_data()->size());
+  ASSERT_EQ("first", result_->GetString(0));
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(valid_bytes[i] == 0, result_->IsNull(i + 1));
+    ASSERT_EQ(expected[i], result_->GetString(i + 1));
+    ASSERT_FALSE(result_->IsNull(i + 6));
+    ASSERT_EQ(expected[i], result_->GetString(i + 6));
+  }
+  ASSERT_TRUE(result_->IsNull(11));
+}
+
+TEST_F(TestBinaryBuilder, ReserveData) {
+  ASSERT_OK(builder_->Reserve(10));
+  ASSERT_OK(builder_->ReserveData(1000));
+  ASSERT_EQ(1024, builder_->value_data_capacity());
+  const uint8_t* data = nullptr;
+  int32_t length;
+
+  string value(100, 'x');
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(builder_->Append(value));
+    if (i == 0) {
+      data = builder_->GetValue(0, &length);
+    }
+  }
+  // Nothing was reallocated.
+  ASSERT_EQ(1024, builder_->value_data_capacity());
+  ASSERT_EQ(data, builder_->GetValue(0, &length));
+  ASSERT_EQ(16, builder_->capacity());
+
+  ASSERT_OK(builder_->ReserveData(24));
+  ASSERT_EQ(1024, builder_->value_data_capacity());
+  ASSERT_RAISES(Invalid, builder_->ReserveData(std::numeric_limits<int32_t>::max()));
+
+  Done();
+  ASSERT_EQ(10, result_->length());
+  ASSERT_EQ(1000, result_->value_data()->size());
+}
+
+TEST_F(TestBinaryBuilder, GrowthFactor) {
+  ASSERT_OK(builder_->SetGrowthFactor(1.25));
+  ASSERT_EQ(1.25, builder_->growth_factor());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(builder_->Append("abcdefghij"));
+  }
+  // Grown in steps of 25% instead of doubling.
+  ASSERT_EQ(118, builder_->capacity());
+  ASSERT_LT(builder_->value_data_capacity(), 1280);
+
+  Done();
+  ASSERT_EQ(100, result_->length());
+  ASSERT_EQ(1000, result_->value_data()->size());
+}
+
 // ----------------------------------------------------------------------
 // Slice tests
 
@@ -1736,6 +1844,28 @@ TEST(TestStringDictionaryBuilder, Basic) {
   ASSERT_TRUE(expected.Equals(result));
 }
 
+TEST(TestStringDictionaryBuilder, LengthAndNullCount) {
+  StringDictionaryBuilder builder(default_memory_pool());
+  ASSERT_OK(builder.Reserve(100));
+  ASSERT_EQ(128, builder.capacity());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(builder.Append("test"));
+    ASSERT_OK(builder.AppendNull());
+  }
+  ASSERT_EQ(200, builder.length());
+  ASSERT_EQ(100, builder.null_count());
+  ASSERT_EQ(256, builder.capacity());
+  // The validity bitmap is built by the indices builder only.
+  ASSERT_EQ(nullptr, builder.null_bitmap());
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK(builder.Finish(&result));
+  ASSERT_EQ(200, result->length());
+  ASSERT_EQ(100, result->null_count());
+  ASSERT_EQ(0, builder.length());
+  ASSERT_EQ(0, builder.capacity());
+}
+
 TEST(TestStringDictionaryBuilder, DoubleTableSize) {
   // Build the dictionary Array
   StringDictionaryBuilder builder(default_memory_pool());
@@ -2155,6 +2285,32 @@ TEST_F(TestListArray, TestBasics) {
   ValidateBasicListArray(result_.get(), values, is_valid);
 }
 
+TEST_F(TestListArray, ReserveValues) {
+  vector<int32_t> values = {0, 1, 2, 3, 4, 5, 6};
+  vector<int> lengths = {3, 0, 4};
+  vector<uint8_t> is_valid = {1, 0, 1};
+
+  ASSERT_OK(builder_->SetGrowthFactor(1.5));
+  Int32Builder* vb = static_cast<Int32Builder*>(builder_->value_builder());
+  ASSERT_EQ(1.5, vb->growth_factor());
+
+  ASSERT_OK(builder_->Reserve(lengths.size()));
+  ASSERT_OK(builder_->ReserveValues(values.size()));
+  ASSERT_EQ(kMinBuilderCapacity, vb->capacity());
+
+  int pos = 0;
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    ASSERT_OK(builder_->Append(is_valid[i] > 0));
+    for (int j = 0; j < lengths[i]; ++j) {
+      ASSERT_OK(vb->Append(values[pos++]));
+    }
+  }
+  ASSERT_EQ(kMinBuilderCapacity, vb->capacity());
+
+  Done();
+  ValidateBasicListArray(result_.get(), values, is_valid);
+}
+
 TEST_F(TestListArray, BulkAppend) {
   vector<int32_t> values = {0, 1, 2, 3, 4, 5, 6};
   vector<int> lengths = {3, 0, 4};
@@ -2172,6 +2328,29 @@ TEST_F(TestListArray, BulkAppend) {
   ValidateBasicListArray(result_.get(), values, is_valid);
 }
 
+TEST_F(TestListArray, AppendValues) {
+  vector<int32_t> values = {0, 1, 2, 3, 4, 5, 6};
+  vector<uint8_t> is_valid = {1, 0, 1};
+  // Offsets of a slice of another list array.
+  vector<int32_t> offsets = {10, 13, 13, 17};
+
+  Int32Builder* vb = static_cast<Int32Builder*>(builder_->value_builder());
+  ASSERT_OK(builder_->AppendValues(offsets.data(), 3, is_valid.data()));
+  ASSERT_OK(vb->Append(values.data(), values.size()));
+  ASSERT_OK(builder_->AppendValues(offsets.data(), 3, is_valid.data()));
+  ASSERT_OK(vb->Append(values.data(), values.size()));
+  Done();
+
+  ASSERT_OK(ValidateArray(*result_));
+  ASSERT_EQ(6, result_->length());
+  ASSERT_EQ(2, result_->null_count());
+  vector<int32_t> ex_offsets = {0, 3, 3, 7, 10, 10, 14};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result_->value_offset(i));
+  }
+  ASSERT_EQ(14, result_->values()->length());
+}
+
 TEST_F(TestListArray, BulkAppendInvalid) {
   vector<int32_t> values = {0, 1, 2, 3, 4, 5, 6};
   vector<int> lengths = {3, 0, 4};
@@ -2720,6 +2899,339 @@ TEST(TestUnionArrayAdHoc, TestSliceEquals) {
   CheckUnion(batch->column(2));
 }
 
+// ----------------------------------------------------------------------
+// Concatenation tests
+
+typedef Status MakeRecordBatch(std::shared_ptr<RecordBatch>* out);
+
+class TestConcatenate : public ::testing::TestWithParam<MakeRecordBatch*> {
+ public:
+  // Split the array into slices at unaligned positions and concatenate them
+  void CheckSlices(const std::shared_ptr<Array>& array) {
+    const int64_t length = array->length();
+    std::vector<int64_t> splits = {0, 1, 3, 3, 11, length / 2, length};
+    for (auto& split : splits) {
+      split = std::min(split, length);
+    }
+    std::sort(splits.begin(), splits.end());
+    std::vector<std::shared_ptr<Array>> slices;
+    for (size_t i = 1; i < splits.size(); ++i) {
+      slices.push_back(array->Slice(splits[i - 1], splits[i] - splits[i - 1]));
+    }
+    std::shared_ptr<Array> result;
+    ASSERT_OK(Concatenate(slices, default_memory_pool(), &result));
+    ASSERT_OK(ValidateArray(*result));
+    int64_t null_count = array->type_id() == Type::NA ? length : 0;
+    for (int64_t i = 0; i < length; ++i) {
+      null_count += array->IsNull(i);
+    }
+    ASSERT_EQ(null_count, result->null_count());
+    AssertArraysEqual(*array, *result);
+
+    // Skipping a part of the array
+    const int64_t quarter = length / 4;
+    std::vector<std::shared_ptr<Array>> parts = {array->Slice(0, quarter),
+                                                 array->Slice(length - quarter)};
+    ASSERT_OK(Concatenate(parts, default_memory_pool(), &result));
+    ASSERT_EQ(2 * quarter, result->length());
+    ASSERT_TRUE(result->RangeEquals(0, quarter, 0, array));
+    ASSERT_TRUE(result->RangeEquals(quarter, 2 * quarter, length - quarter, array));
+  }
+};
+
+TEST_P(TestConcatenate, SliceRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK((*GetParam())(&batch));
+  for (int i = 0; i < batch->num_columns(); ++i) {
+    CheckSlices(batch->column(i));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ConcatenateTypes, TestConcatenate,
+    ::testing::Values(&ipc::MakeIntRecordBatch, &ipc::MakeBooleanBatch,
+                      &ipc::MakeStringTypesRecordBatch, &ipc::MakeNullRecordBatch,
+                      &ipc::MakeListRecordBatch, &ipc::MakeDeeplyNestedList,
+                      &ipc::MakeStruct, &ipc::MakeUnion, &ipc::MakeDictionary,
+                      &ipc::MakeDates, &ipc::MakeTimestamps, &ipc::MakeTimes,
+                      &ipc::MakeFWBinary, &ipc::MakeDecimal, &ipc::MakeNull));
+
+TEST(Concatenate, Errors) {
+  std::shared_ptr<Array> result;
+  ASSERT_RAISES(Invalid, Concatenate({}, default_memory_pool(), &result));
+
+  std::shared_ptr<Array> ints, strings;
+  ArrayFromVector<Int32Type, int32_t>({1, 2}, &ints);
+  StringBuilder builder;
+  ASSERT_OK(builder.Append("a"));
+  ASSERT_OK(builder.Finish(&strings));
+  ASSERT_RAISES(Invalid, Concatenate({ints, strings}, default_memory_pool(), &result));
+
+  ASSERT_OK(Concatenate({ints, ints->Slice(1)}, default_memory_pool(), &result));
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int32Type, int32_t>({1, 2, 2}, &expected);
+  AssertArraysEqual(*expected, *result);
+}
+
+// ----------------------------------------------------------------------
+// Dictionary unification tests
+
+TEST(TestDictionaryUnifier, Basic) {
+  std::shared_ptr<Array> dict1, dict2, dict3, expected_dict;
+  ArrayFromVector<StringType, std::string>({"foo", "bar"}, &dict1);
+  ArrayFromVector<StringType, std::string>({"baz", "bar"}, &dict2);
+  ArrayFromVector<StringType, std::string>({}, &dict3);
+  ArrayFromVector<StringType, std::string>({"foo", "bar", "baz"}, &expected_dict);
+
+  std::unique_ptr<DictionaryUnifier> unifier;
+  ASSERT_OK(DictionaryUnifier::Make(default_memory_pool(), utf8(), &unifier));
+  ASSERT_OK(unifier->Unify(*dict1));
+  ASSERT_OK(unifier->Unify(*dict2));
+  ASSERT_OK(unifier->Unify(*dict3));
+
+  std::shared_ptr<DataType> type;
+  std::vector<std::vector<int32_t>> transpose_maps;
+  ASSERT_OK(unifier->GetResult(&type, &transpose_maps));
+  ASSERT_TRUE(type->Equals(*dictionary(int8(), expected_dict)));
+  ASSERT_EQ(3, transpose_maps.size());
+  ASSERT_EQ(std::vector<int32_t>({0, 1}), transpose_maps[0]);
+  ASSERT_EQ(std::vector<int32_t>({2, 1}), transpose_maps[1]);
+  ASSERT_EQ(std::vector<int32_t>(), transpose_maps[2]);
+
+  // The unifier starts over after GetResult
+  ASSERT_OK(unifier->Unify(*dict2));
+  ASSERT_OK(unifier->GetResult(&type, &transpose_maps));
+  ASSERT_TRUE(type->Equals(*dictionary(int8(), dict2)));
+  ASSERT_EQ(1, transpose_maps.size());
+  ASSERT_EQ(std::vector<int32_t>({0, 1}), transpose_maps[0]);
+}
+
+TEST(TestDictionaryUnifier, Errors) {
+  std::unique_ptr<DictionaryUnifier> unifier;
+  ASSERT_RAISES(NotImplemented,
+                DictionaryUnifier::Make(default_memory_pool(), list(int8()), &unifier));
+  ASSERT_OK(DictionaryUnifier::Make(default_memory_pool(), int32(), &unifier));
+
+  std::shared_ptr<Array> with_nulls, other_type;
+  ArrayFromVector<Int32Type, int32_t>({true, false}, {1, 2}, &with_nulls);
+  ArrayFromVector<Int64Type, int64_t>({1, 2}, &other_type);
+  ASSERT_RAISES(Invalid, unifier->Unify(*with_nulls));
+  ASSERT_RAISES(Invalid, unifier->Unify(*other_type));
+}
+
+TEST(TestDictionaryArray, Transpose) {
+  std::shared_ptr<Array> dict, indices, new_dict;
+  ArrayFromVector<StringType, std::string>({"foo", "bar", "baz"}, &dict);
+  ArrayFromVector<Int16Type, int16_t>({true, true, false, true, true, true},
+                                      {1, 2, 7, 0, 2, 1}, &indices);
+  ArrayFromVector<StringType, std::string>({"quux", "baz", "foo", "bar"}, &new_dict);
+  DictionaryArray array(dictionary(int16(), dict), indices);
+  const std::vector<int32_t> transpose_map = {2, 3, 1};
+
+  std::shared_ptr<Array> result, expected_indices;
+  auto new_type = dictionary(int8(), new_dict);
+  ASSERT_OK(array.Transpose(default_memory_pool(), new_type, transpose_map, &result));
+  ArrayFromVector<Int8Type, int8_t>({true, true, false, true, true, true},
+                                    {3, 1, 0, 2, 1, 3}, &expected_indices);
+  AssertArraysEqual(DictionaryArray(new_type, expected_indices), *result);
+
+  // Slices keep their offset into the shared null bitmap
+  ASSERT_OK(static_cast<const DictionaryArray&>(*array.Slice(2)).Transpose(
+      default_memory_pool(), new_type, transpose_map, &result));
+  AssertArraysEqual(*DictionaryArray(new_type, expected_indices).Slice(2), *result);
+
+  ASSERT_RAISES(Invalid,
+                array.Transpose(default_memory_pool(), new_type, {0, 1}, &result));
+  ASSERT_RAISES(Invalid,
+                array.Transpose(default_memory_pool(), utf8(), transpose_map, &result));
+
+  // In place, the index type stays the same
+  ASSERT_OK(TransposeIndicesInPlace(transpose_map, *indices->Slice(1)));
+  ArrayFromVector<Int16Type, int16_t>({true, true, false, true, true, true},
+                                      {1, 1, 0, 2, 1, 3}, &expected_indices);
+  AssertArraysEqual(*expected_indices, *indices);
+
+  auto immutable = std::make_shared<Buffer>(indices->data()->buffers[1]->data(),
+                                            indices->data()->buffers[1]->size());
+  auto immutable_indices = std::make_shared<Int16Array>(
+      indices->length(), immutable, indices->data()->buffers[0], indices->null_count());
+  ASSERT_RAISES(Invalid, TransposeIndicesInPlace(transpose_map, *immutable_indices));
+}
+
+TEST(TestDictionaryUnifier, UnifyDictionaries) {
+  std::shared_ptr<Array> chunk1, chunk2, dense;
+  ArrayFromVector<StringType, std::string>({true, true, false, true},
+                                           {"foo", "bar", "", "foo"}, &chunk1);
+  ArrayFromVector<StringType, std::string>({true, false, true},
+                                           {"baz", "", "foo"}, &chunk2);
+  ArrayFromVector<StringType, std::string>({true, true, false, true, true, false, true},
+                                           {"foo", "bar", "", "foo", "baz", "", "foo"},
+                                           &dense);
+  ArrayVector encoded(2);
+  ASSERT_OK(EncodeArrayToDictionary(*chunk1, default_memory_pool(), &encoded[0]));
+  ASSERT_OK(EncodeArrayToDictionary(*chunk2, default_memory_pool(), &encoded[1]));
+
+  ArrayVector unified;
+  ASSERT_OK(UnifyDictionaries(encoded, default_memory_pool(), &unified));
+  ASSERT_EQ(2, unified.size());
+  ASSERT_TRUE(unified[0]->type()->Equals(*unified[1]->type()));
+
+  std::shared_ptr<Array> result, expected;
+  ASSERT_OK(Concatenate(unified, default_memory_pool(), &result));
+  ASSERT_OK(EncodeArrayToDictionary(*dense, default_memory_pool(), &expected));
+  AssertArraysEqual(*expected, *result);
+
+  // The inputs are left untouched
+  const auto& dict1 = static_cast<const DictionaryArray&>(*encoded[1]).dictionary();
+  ASSERT_EQ(2, dict1->length());
+  ASSERT_EQ(0, static_cast<const Int8Array&>(
+                   *static_cast<const DictionaryArray&>(*encoded[1]).indices())
+                   .Value(0));
+
+  ASSERT_RAISES(Invalid, UnifyDictionaries({chunk1}, default_memory_pool(), &unified));
+}
+
+// ----------------------------------------------------------------------
+// ConcurrentArrayBuilder tests
+
+namespace {
+
+// Partition i holds the values i * 1000, i * 1000 + 1, ... modulo the given
+// number of distinct values
+std::string ConcurrentTestValue(int partition, int64_t i, int64_t num_distinct) {
+  return "value" + std::to_string((partition * 1000 + i) % num_distinct);
+}
+
+void AppendConcurrentTestValues(int partition, int64_t length, int64_t num_distinct,
+                                std::function<Status(const std::string&)> append,
+                                std::function<Status()> append_null) {
+  // Every seventh slot is null, starting with the first
+  for (int64_t i = 0; i < length; ++i) {
+    if (i % 7 == 0) {
+      ASSERT_OK(append_null());
+    } else {
+      ASSERT_OK(append(ConcurrentTestValue(partition, i, num_distinct)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TestConcurrentArrayBuilder, Strings) {
+  const int kNumPartitions = 4;
+  const int64_t kLength = 1000;
+  std::unique_ptr<ConcurrentArrayBuilder> builder;
+  ASSERT_RAISES(Invalid,
+                ConcurrentArrayBuilder::Make(default_memory_pool(), utf8(), 0, &builder));
+  ASSERT_OK(ConcurrentArrayBuilder::Make(default_memory_pool(), utf8(), kNumPartitions,
+                                         &builder));
+  ASSERT_EQ(kNumPartitions, builder->num_partitions());
+
+  StringBuilder expected_builder;
+  for (int round = 0; round < 2; ++round) {
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kNumPartitions; ++p) {
+      // Partitions of different lengths put the joins at odd bit offsets
+      const int64_t length = kLength + p * 3;
+      auto partition = static_cast<StringBuilder*>(builder->partition(p));
+      threads.emplace_back([partition, p, length]() {
+        AppendConcurrentTestValues(
+            p, length, length, [partition](const std::string& value) {
+              return partition->Append(value);
+            },
+            [partition]() { return partition->AppendNull(); });
+      });
+      if (round == 0) {
+        AppendConcurrentTestValues(p, length, length,
+                                   [&expected_builder](const std::string& value) {
+                                     return expected_builder.Append(value);
+                                   },
+                                   [&expected_builder]() {
+                                     return expected_builder.AppendNull();
+                                   });
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(kNumPartitions * kLength + 18, builder->length());
+
+    if (round == 0) {
+      std::shared_ptr<Array> result, expected;
+      ASSERT_OK(builder->Finish(&result));
+      ASSERT_OK(expected_builder.Finish(&expected));
+      ASSERT_OK(ValidateArray(*result));
+      AssertArraysEqual(*expected, *result);
+      ASSERT_EQ(0, builder->length());
+    } else {
+      std::shared_ptr<ChunkedArray> result;
+      ASSERT_OK(builder->Finish(&result));
+      ASSERT_EQ(kNumPartitions, result->num_chunks());
+      ASSERT_EQ(kNumPartitions * kLength + 18, result->length());
+      ASSERT_EQ(kLength + 9, result->chunk(3)->length());
+    }
+  }
+}
+
+TEST(TestConcurrentArrayBuilder, Dictionary) {
+  const int kNumPartitions = 3;
+  const int64_t kLength = 500;
+  std::unique_ptr<ConcurrentArrayBuilder> builder;
+  ASSERT_OK(ConcurrentArrayBuilder::MakeDictionary(default_memory_pool(), utf8(),
+                                                   kNumPartitions, &builder));
+
+  std::vector<std::thread> threads;
+  StringBuilder dense_builder;
+  for (int p = 0; p < kNumPartitions; ++p) {
+    // The dictionaries overlap, and the last partition has enough distinct
+    // values for 16-bit indices
+    const int64_t num_distinct = p == kNumPartitions - 1 ? kLength : 50;
+    auto partition = static_cast<StringDictionaryBuilder*>(builder->partition(p));
+    threads.emplace_back([partition, p, num_distinct]() {
+      AppendConcurrentTestValues(
+          p, kLength, num_distinct, [partition](const std::string& value) {
+            return partition->Append(value);
+          },
+          [partition]() { return partition->AppendNull(); });
+    });
+    AppendConcurrentTestValues(p, kLength, num_distinct,
+                               [&dense_builder](const std::string& value) {
+                                 return dense_builder.Append(value);
+                               },
+                               [&dense_builder]() { return dense_builder.AppendNull(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The unified dictionary lists the values in order of first appearance, like
+  // encoding the whole column at once
+  std::shared_ptr<Array> dense, expected, result;
+  ASSERT_OK(dense_builder.Finish(&dense));
+  ASSERT_OK(EncodeArrayToDictionary(*dense, default_memory_pool(), &expected));
+  ASSERT_OK(builder->Finish(&result));
+  ASSERT_TRUE(result->type()->Equals(*expected->type()));
+  AssertArraysEqual(*expected, *result);
+
+  // Every chunk refers to the unified dictionary
+  for (int p = 0; p < kNumPartitions; ++p) {
+    auto partition = static_cast<StringDictionaryBuilder*>(builder->partition(p));
+    ASSERT_OK(partition->Append(ConcurrentTestValue(kNumPartitions - 1 - p, 0, 100000)));
+  }
+  std::shared_ptr<ChunkedArray> chunked;
+  ASSERT_OK(builder->Finish(&chunked));
+  ASSERT_EQ(kNumPartitions, chunked->num_chunks());
+  const auto& dict_type = static_cast<const DictionaryType&>(*chunked->type());
+  ASSERT_EQ(kNumPartitions, dict_type.dictionary()->length());
+  for (int p = 0; p < kNumPartitions; ++p) {
+    ASSERT_TRUE(chunked->chunk(p)->type()->Equals(*chunked->type()));
+    const auto& indices =
+        static_cast<const Int8Array&>(*static_cast<const DictionaryArray&>(
+                                           *chunked->chunk(p)).indices());
+    ASSERT_EQ(p, indices.Value(0));
+  }
+}
+
 using DecimalVector = std::vector<Decimal128>;
 
 class DecimalTest : public ::testing::TestWithParam<int> {
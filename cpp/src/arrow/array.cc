@@ -20,7 +20,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "arrow/buffer.h"
 #include "arrow/compare.h"
@@ -442,6 +445,111 @@ std::shared_ptr<Array> DictionaryArray::dictionary() const {
   return dict_type_->dictionary();
 }
 
+namespace {
+
+template <typename InType, typename OutType>
+void TransposeIndicesImpl(const Array& indices, const int32_t* transpose_map,
+                          typename OutType::c_type* out) {
+  using out_type = typename OutType::c_type;
+  const auto in = static_cast<const NumericArray<InType>&>(indices).raw_values();
+  for (int64_t i = 0; i < indices.length(); ++i) {
+    // The index stored in a null slot is undefined
+    out[i] = indices.IsValid(i) ? static_cast<out_type>(transpose_map[in[i]]) : 0;
+  }
+}
+
+template <typename OutType>
+Status TransposeIndicesTo(const Array& indices, const int32_t* transpose_map,
+                          uint8_t* out_data) {
+  auto out = reinterpret_cast<typename OutType::c_type*>(out_data);
+  switch (indices.type_id()) {
+    case Type::INT8:
+      TransposeIndicesImpl<Int8Type, OutType>(indices, transpose_map, out);
+      break;
+    case Type::INT16:
+      TransposeIndicesImpl<Int16Type, OutType>(indices, transpose_map, out);
+      break;
+    case Type::INT32:
+      TransposeIndicesImpl<Int32Type, OutType>(indices, transpose_map, out);
+      break;
+    case Type::INT64:
+      TransposeIndicesImpl<Int64Type, OutType>(indices, transpose_map, out);
+      break;
+    default:
+      return Status::Invalid("Dictionary indices must be signed integers");
+  }
+  return Status::OK();
+}
+
+// Write the transposed indices as out_type to out_data, which holds the first
+// slot of the indices
+Status TransposeIndices(const Array& indices, const int32_t* transpose_map,
+                        const DataType& out_type, uint8_t* out_data) {
+  switch (out_type.id()) {
+    case Type::INT8:
+      return TransposeIndicesTo<Int8Type>(indices, transpose_map, out_data);
+    case Type::INT16:
+      return TransposeIndicesTo<Int16Type>(indices, transpose_map, out_data);
+    case Type::INT32:
+      return TransposeIndicesTo<Int32Type>(indices, transpose_map, out_data);
+    case Type::INT64:
+      return TransposeIndicesTo<Int64Type>(indices, transpose_map, out_data);
+    default:
+      return Status::Invalid("Dictionary indices must be signed integers");
+  }
+}
+
+}  // namespace
+
+Status DictionaryArray::Transpose(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+                                  const std::vector<int32_t>& transpose_map,
+                                  std::shared_ptr<Array>* out) const {
+  if (type->id() != Type::DICTIONARY) {
+    return Status::Invalid("Cannot transpose onto non-dictionary type");
+  }
+  if (static_cast<int64_t>(transpose_map.size()) != dictionary()->length()) {
+    return Status::Invalid("Transpose map does not match the dictionary length");
+  }
+  const auto& out_index_type =
+      *static_cast<const DictionaryType&>(*type).index_type();
+  if (!is_integer(out_index_type.id())) {
+    return Status::Invalid("Dictionary indices must be signed integers");
+  }
+  const int64_t byte_width =
+      static_cast<const FixedWidthType&>(out_index_type).bit_width() / 8;
+
+  // The new indices keep the offset so that the null bitmap can be shared
+  std::shared_ptr<Buffer> values;
+  RETURN_NOT_OK(
+      AllocateBuffer(pool, (data_->offset + data_->length) * byte_width, &values));
+  RETURN_NOT_OK(TransposeIndices(*indices_, transpose_map.data(), out_index_type,
+                                 values->mutable_data() + data_->offset * byte_width));
+
+  auto data = std::make_shared<ArrayData>(type, data_->length,
+                                          BufferVector{data_->buffers[0], values},
+                                          data_->null_count, data_->offset);
+  *out = MakeArray(data);
+  return Status::OK();
+}
+
+Status TransposeIndicesInPlace(const std::vector<int32_t>& transpose_map,
+                               const Array& indices) {
+  const std::shared_ptr<Buffer>& values = indices.data()->buffers[1];
+  if (!is_integer(indices.type_id())) {
+    return Status::Invalid("Dictionary indices must be signed integers");
+  }
+  if (indices.length() == 0) {
+    return Status::OK();
+  }
+  if (values == nullptr || !values->is_mutable()) {
+    return Status::Invalid("Cannot transpose immutable indices in place");
+  }
+  const int64_t byte_width =
+      static_cast<const FixedWidthType&>(*indices.type()).bit_width() / 8;
+  return TransposeIndices(indices, transpose_map.data(), *indices.type(),
+                          values->mutable_data() + indices.offset() * byte_width);
+}
+
 // ----------------------------------------------------------------------
 // Implement Array::Accept as inline visitor
 
@@ -592,6 +700,239 @@ Status ValidateArray(const Array& array) {
   return VisitArrayInline(array, &validate_visitor);
 }
 
+// ----------------------------------------------------------------------
+// Concatenation
+
+namespace {
+
+class ConcatenateImpl {
+ public:
+  ConcatenateImpl(const std::vector<std::shared_ptr<Array>>& arrays, MemoryPool* pool)
+      : arrays_(arrays), pool_(pool) {}
+
+  Status Concatenate(std::shared_ptr<ArrayData>* out) {
+    int64_t length = 0;
+    int64_t null_count = 0;
+    for (const auto& array : arrays_) {
+      length += array->length();
+      null_count += array->null_count();
+    }
+    out_ = std::make_shared<ArrayData>(arrays_[0]->type(), length, null_count);
+    out_->buffers.resize(1);
+    if (null_count > 0 && out_->type->id() != Type::NA) {
+      RETURN_NOT_OK(ConcatenateBitmaps(0, &out_->buffers[0]));
+    }
+    RETURN_NOT_OK(VisitTypeInline(*out_->type, this));
+    *out = out_;
+    return Status::OK();
+  }
+
+  Status Visit(const NullType&) { return Status::OK(); }
+
+  Status Visit(const BooleanType&) {
+    out_->buffers.resize(2);
+    return ConcatenateBitmaps(1, &out_->buffers[1]);
+  }
+
+  // Also handles dictionary arrays, which are their indices. Their types, and
+  // so their dictionaries, are equal.
+  Status Visit(const FixedWidthType& type) {
+    out_->buffers.resize(2);
+    return ConcatenateValues(1, type.bit_width() / 8, &out_->buffers[1]);
+  }
+
+  Status Visit(const BinaryType&) {
+    std::vector<std::pair<int64_t, int64_t>> value_ranges;
+    out_->buffers.resize(3);
+    RETURN_NOT_OK(ConcatenateOffsets(&out_->buffers[1], &value_ranges));
+    int64_t values_length = 0;
+    for (const auto& range : value_ranges) {
+      values_length += range.second;
+    }
+    RETURN_NOT_OK(AllocateBuffer(pool_, values_length, &out_->buffers[2]));
+    uint8_t* dest = out_->buffers[2]->mutable_data();
+    for (size_t i = 0; i < arrays_.size(); ++i) {
+      if (value_ranges[i].second > 0) {
+        std::memcpy(dest, arrays_[i]->data()->buffers[2]->data() + value_ranges[i].first,
+                    static_cast<size_t>(value_ranges[i].second));
+        dest += value_ranges[i].second;
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Visit(const ListType&) {
+    std::vector<std::pair<int64_t, int64_t>> value_ranges;
+    out_->buffers.resize(2);
+    RETURN_NOT_OK(ConcatenateOffsets(&out_->buffers[1], &value_ranges));
+    std::vector<std::shared_ptr<Array>> values;
+    for (size_t i = 0; i < arrays_.size(); ++i) {
+      values.push_back(MakeArray(arrays_[i]->data()->child_data[0])
+                           ->Slice(value_ranges[i].first, value_ranges[i].second));
+    }
+    return ConcatenateChild(values);
+  }
+
+  Status Visit(const StructType& type) {
+    for (int i = 0; i < type.num_children(); ++i) {
+      RETURN_NOT_OK(ConcatenateChild(SlicedChildren(i)));
+    }
+    return Status::OK();
+  }
+
+  Status Visit(const UnionType& type) {
+    out_->buffers.resize(3);
+    RETURN_NOT_OK(ConcatenateValues(1, sizeof(uint8_t), &out_->buffers[1]));
+    if (type.mode() == UnionMode::SPARSE) {
+      for (int i = 0; i < type.num_children(); ++i) {
+        RETURN_NOT_OK(ConcatenateChild(SlicedChildren(i)));
+      }
+      return Status::OK();
+    }
+
+    // The children of dense unions are concatenated as a whole, so the offsets
+    // into a child are shifted by the lengths of the preceding arrays' child.
+    std::vector<int> child_index(std::numeric_limits<uint8_t>::max() + 1, 0);
+    for (int i = 0; i < type.num_children(); ++i) {
+      child_index[type.type_codes()[i]] = i;
+    }
+    std::vector<int64_t> child_offsets(type.num_children(), 0);
+    RETURN_NOT_OK(
+        AllocateBuffer(pool_, out_->length * sizeof(int32_t), &out_->buffers[2]));
+    auto dest = reinterpret_cast<int32_t*>(out_->buffers[2]->mutable_data());
+    for (const auto& array : arrays_) {
+      const auto& union_array = static_cast<const UnionArray&>(*array);
+      const uint8_t* type_ids = union_array.raw_type_ids();
+      const int32_t* offsets = union_array.raw_value_offsets();
+      for (int64_t i = 0; i < array->length(); ++i) {
+        const int64_t offset = offsets[i] + child_offsets[child_index[type_ids[i]]];
+        if (offset > std::numeric_limits<int32_t>::max()) {
+          return Status::Invalid("Concatenated union child is too large");
+        }
+        *dest++ = static_cast<int32_t>(offset);
+      }
+      for (int i = 0; i < type.num_children(); ++i) {
+        child_offsets[i] += array->data()->child_data[i]->length;
+      }
+    }
+    for (int i = 0; i < type.num_children(); ++i) {
+      std::vector<std::shared_ptr<Array>> children;
+      for (const auto& array : arrays_) {
+        children.push_back(MakeArray(array->data()->child_data[i]));
+      }
+      RETURN_NOT_OK(ConcatenateChild(children));
+    }
+    return Status::OK();
+  }
+
+ private:
+  Status ConcatenateBitmaps(int index, std::shared_ptr<Buffer>* out) {
+    RETURN_NOT_OK(GetEmptyBitmap(pool_, out_->length, out));
+    uint8_t* dest = (*out)->mutable_data();
+    int64_t position = 0;
+    for (const auto& array : arrays_) {
+      const ArrayData& data = *array->data();
+      const std::shared_ptr<Buffer>& bitmap = data.buffers[index];
+      if (bitmap != nullptr) {
+        CopyBitmap(bitmap->data(), data.offset, data.length, dest, position);
+      } else {
+        // Only the null bitmap may be absent, if there are no nulls
+        for (int64_t i = 0; i < data.length; ++i) {
+          BitUtil::SetBit(dest, position + i);
+        }
+      }
+      position += data.length;
+    }
+    return Status::OK();
+  }
+
+  Status ConcatenateValues(int index, int64_t byte_width, std::shared_ptr<Buffer>* out) {
+    RETURN_NOT_OK(AllocateBuffer(pool_, out_->length * byte_width, out));
+    uint8_t* dest = (*out)->mutable_data();
+    for (const auto& array : arrays_) {
+      const ArrayData& data = *array->data();
+      const int64_t nbytes = data.length * byte_width;
+      if (nbytes > 0) {
+        std::memcpy(dest, data.buffers[index]->data() + data.offset * byte_width,
+                    static_cast<size_t>(nbytes));
+        dest += nbytes;
+      }
+    }
+    return Status::OK();
+  }
+
+  // Concatenate the offsets of binary and list arrays, and return the range
+  // of values (offset and length) that each array refers to
+  Status ConcatenateOffsets(std::shared_ptr<Buffer>* out,
+                            std::vector<std::pair<int64_t, int64_t>>* value_ranges) {
+    RETURN_NOT_OK(AllocateBuffer(pool_, (out_->length + 1) * sizeof(int32_t), out));
+    auto dest = reinterpret_cast<int32_t*>((*out)->mutable_data());
+    int64_t values_length = 0;
+    for (const auto& array : arrays_) {
+      const ArrayData& data = *array->data();
+      if (data.length == 0) {
+        value_ranges->emplace_back(0, 0);
+        continue;
+      }
+      auto offsets =
+          reinterpret_cast<const int32_t*>(data.buffers[1]->data()) + data.offset;
+      const int64_t first = offsets[0];
+      const int64_t length = offsets[data.length] - first;
+      if (values_length + length > std::numeric_limits<int32_t>::max()) {
+        return Status::Invalid("Concatenated array has more than INT32_MAX values");
+      }
+      for (int64_t i = 0; i < data.length; ++i) {
+        *dest++ = static_cast<int32_t>(values_length + offsets[i] - first);
+      }
+      value_ranges->emplace_back(first, length);
+      values_length += length;
+    }
+    *dest = static_cast<int32_t>(values_length);
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<Array>> SlicedChildren(int i) const {
+    std::vector<std::shared_ptr<Array>> children;
+    for (const auto& array : arrays_) {
+      children.push_back(MakeArray(array->data()->child_data[i])
+                             ->Slice(array->offset(), array->length()));
+    }
+    return children;
+  }
+
+  Status ConcatenateChild(const std::vector<std::shared_ptr<Array>>& children) {
+    std::shared_ptr<ArrayData> child;
+    RETURN_NOT_OK(ConcatenateImpl(children, pool_).Concatenate(&child));
+    out_->child_data.push_back(child);
+    return Status::OK();
+  }
+
+  const std::vector<std::shared_ptr<Array>>& arrays_;
+  MemoryPool* pool_;
+  std::shared_ptr<ArrayData> out_;
+};
+
+}  // namespace
+
+Status Concatenate(const std::vector<std::shared_ptr<Array>>& arrays, MemoryPool* pool,
+                   std::shared_ptr<Array>* out) {
+  if (arrays.empty()) {
+    return Status::Invalid("Must pass at least one array");
+  }
+  for (const auto& array : arrays) {
+    if (!array->type()->Equals(arrays[0]->type())) {
+      std::stringstream ss;
+      ss << "Cannot concatenate arrays of different types: "
+         << arrays[0]->type()->ToString() << " and " << array->type()->ToString();
+      return Status::Invalid(ss.str());
+    }
+  }
+  std::shared_ptr<ArrayData> data;
+  RETURN_NOT_OK(ConcatenateImpl(arrays, pool).Concatenate(&data));
+  *out = MakeArray(data);
+  return Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // Loading from ArrayData
 
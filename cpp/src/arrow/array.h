@@ -670,6 +670,22 @@ class ARROW_EXPORT DictionaryArray : public Array {
 
   const DictionaryType* dict_type() const { return dict_type_; }
 
+  /// \brief Re-encode the array against another dictionary
+  ///
+  /// Index i of this array's dictionary becomes transpose_map[i] in the new
+  /// dictionary (see DictionaryUnifier). The null bitmap is shared with this
+  /// array; the new indices are allocated from pool.
+  ///
+  /// \param[in] pool memory pool to allocate the new indices from
+  /// \param[in] type the DictionaryType of the result, whose index type must
+  /// hold every mapped index
+  /// \param[in] transpose_map the new index of each dictionary value
+  /// \param[out] out the transposed DictionaryArray
+  /// \return Status
+  Status Transpose(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+                   const std::vector<int32_t>& transpose_map,
+                   std::shared_ptr<Array>* out) const;
+
  private:
   void SetData(const std::shared_ptr<ArrayData>& data);
 
@@ -708,6 +724,36 @@ ARROW_EXTERN_TEMPLATE NumericArray<TimestampType>;
 ARROW_EXPORT
 Status ValidateArray(const Array& array);
 
+/// \brief Map dictionary indices through transpose_map in place
+///
+/// The kernel behind DictionaryArray::Transpose, for callers that own the
+/// indices and keep their index type: the values buffer of indices is
+/// overwritten, so it must be mutable and must not be shared with arrays that
+/// expect the old indices. Null slots are set to 0.
+///
+/// \param[in] transpose_map the new index of each dictionary value
+/// \param[in] indices signed integer dictionary indices
+/// \return Status, Invalid if the indices are not signed integers or their
+/// buffer is immutable
+ARROW_EXPORT
+Status TransposeIndicesInPlace(const std::vector<int32_t>& transpose_map,
+                               const Array& indices);
+
+/// \brief Concatenate arrays of the same type into one contiguous array
+///
+/// The buffers of the result are newly allocated. The arrays may be slices:
+/// null bitmaps are stitched together at any bit offset, and the offsets of
+/// binary, list and dense union arrays are rebased onto the concatenated
+/// values. Dictionary arrays must all have the same dictionary.
+///
+/// \param[in] arrays the arrays to concatenate, at least one
+/// \param[in] pool memory pool to allocate the result's buffers from
+/// \param[out] out the concatenated array
+/// \return Status, Invalid if the types differ or the result is too large
+ARROW_EXPORT
+Status Concatenate(const std::vector<std::shared_ptr<Array>>& arrays, MemoryPool* pool,
+                   std::shared_ptr<Array>* out);
+
 }  // namespace arrow
 
 #endif  // ARROW_ARRAY_H
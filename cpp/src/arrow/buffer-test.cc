@@ -20,6 +20,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -194,4 +195,124 @@ TEST(TestBuffer, SliceMutableBuffer) {
   ASSERT_TRUE(slice->Equals(expected));
 }
 
+TEST(TestRecyclingBufferPool, Reuse) {
+  RecyclingBufferPool pool(default_memory_pool(), 2);
+
+  std::shared_ptr<ResizableBuffer> buffer;
+  ASSERT_OK(pool.Get(100, &buffer));
+  ASSERT_EQ(100, buffer->size());
+  ASSERT_TRUE(buffer->is_mutable());
+  const uint8_t* data = buffer->data();
+
+  // The memory comes back when the last slice is released
+  std::shared_ptr<Buffer> slice = SliceBuffer(buffer, 10, 20);
+  buffer.reset();
+  ASSERT_EQ(0, pool.num_cached_buffers());
+  slice.reset();
+  ASSERT_EQ(1, pool.num_cached_buffers());
+  ASSERT_EQ(128, pool.bytes_cached());
+
+  ASSERT_OK(pool.Get(50, &buffer));
+  ASSERT_EQ(data, buffer->data());
+  ASSERT_EQ(50, buffer->size());
+  ASSERT_EQ(0, pool.num_cached_buffers());
+
+  // A cached buffer that is too small is grown
+  buffer.reset();
+  ASSERT_OK(pool.Get(1000, &buffer));
+  ASSERT_EQ(1000, buffer->size());
+  ASSERT_EQ(0, pool.num_cached_buffers());
+  buffer.reset();
+  ASSERT_EQ(1024, pool.bytes_cached());
+}
+
+TEST(TestRecyclingBufferPool, BestFitAndLimit) {
+  RecyclingBufferPool pool(default_memory_pool(), 2);
+
+  std::shared_ptr<ResizableBuffer> small, large, extra;
+  ASSERT_OK(pool.Get(64, &small));
+  ASSERT_OK(pool.Get(1024, &large));
+  ASSERT_OK(pool.Get(4096, &extra));
+  const uint8_t* small_data = small->data();
+  const uint8_t* large_data = large->data();
+  small.reset();
+  large.reset();
+  extra.reset();
+  // Only two buffers are kept
+  ASSERT_EQ(2, pool.num_cached_buffers());
+  ASSERT_EQ(64 + 1024, pool.bytes_cached());
+
+  std::shared_ptr<ResizableBuffer> buffer;
+  ASSERT_OK(pool.Get(500, &buffer));
+  ASSERT_EQ(large_data, buffer->data());
+  std::shared_ptr<ResizableBuffer> other;
+  ASSERT_OK(pool.Get(10, &other));
+  ASSERT_EQ(small_data, other->data());
+}
+
+TEST(TestRecyclingBufferPool, OutlivesPool) {
+  std::shared_ptr<ResizableBuffer> buffer;
+  {
+    RecyclingBufferPool pool;
+    ASSERT_OK(pool.Get(100, &buffer));
+  }
+  buffer->mutable_data()[99] = 1;
+  buffer.reset();
+}
+
+TEST(TestBufferBuilder, GrowthFactor) {
+  BufferBuilder builder(default_memory_pool());
+  ASSERT_EQ(kDefaultGrowthFactor, builder.growth_factor());
+  std::vector<uint8_t> data(1000, 7);
+
+  // By default the capacity grows to powers of two.
+  ASSERT_OK(builder.Append(data.data(), 100));
+  ASSERT_EQ(128, builder.capacity());
+  ASSERT_OK(builder.Append(data.data(), 100));
+  ASSERT_EQ(256, builder.capacity());
+
+  ASSERT_RAISES(Invalid, builder.SetGrowthFactor(1.0));
+  ASSERT_RAISES(Invalid, builder.SetGrowthFactor(0.5));
+  ASSERT_EQ(kDefaultGrowthFactor, builder.growth_factor());
+
+  ASSERT_OK(builder.SetGrowthFactor(1.5));
+  // 256 * 1.5
+  ASSERT_OK(builder.Append(data.data(), 100));
+  ASSERT_EQ(384, builder.capacity());
+  // More than 384 * 1.5 is required: 1300, rounded up to a multiple of 64 bytes.
+  ASSERT_OK(builder.Append(data.data(), 1000));
+  ASSERT_EQ(1344, builder.capacity());
+  ASSERT_EQ(1300, builder.length());
+
+  // Reserving within the capacity does not grow the buffer.
+  ASSERT_OK(builder.Reserve(44));
+  ASSERT_EQ(1344, builder.capacity());
+  // 1344 * 1.5, rounded up.
+  ASSERT_OK(builder.Reserve(45));
+  ASSERT_EQ(2048, builder.capacity());
+  ASSERT_EQ(1300, builder.length());
+
+  std::shared_ptr<Buffer> out;
+  ASSERT_OK(builder.Finish(&out));
+  ASSERT_EQ(1300, out->size());
+  ASSERT_EQ(7, out->data()[1299]);
+}
+
+TEST(GrowCapacity, Basics) {
+  // The default factor grows to the next power of two.
+  ASSERT_EQ(64, GrowCapacity(0, 33, kDefaultGrowthFactor));
+  ASSERT_EQ(128, GrowCapacity(64, 100, kDefaultGrowthFactor));
+  ASSERT_EQ(1024, GrowCapacity(512, 1024, kDefaultGrowthFactor));
+  // Other factors grow the current capacity.
+  ASSERT_EQ(150, GrowCapacity(100, 101, 1.5));
+  ASSERT_EQ(1010, GrowCapacity(1000, 1001, 1.01));
+  ASSERT_EQ(11, GrowCapacity(7, 8, 1.5));
+  // Unless more is required.
+  ASSERT_EQ(33, GrowCapacity(0, 33, 1.5));
+  ASSERT_EQ(5000, GrowCapacity(1000, 5000, 1.5));
+  // Growth stops at the required capacity instead of overflowing.
+  const int64_t huge = std::numeric_limits<int64_t>::max() - 1;
+  ASSERT_EQ(huge, GrowCapacity(huge / 3 * 2, huge, 1.5));
+}
+
 }  // namespace arrow
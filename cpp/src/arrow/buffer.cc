@@ -18,6 +18,9 @@
 #include "arrow/buffer.h"
 
 #include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "arrow/memory_pool.h"
 #include "arrow/status.h"
@@ -140,4 +143,101 @@ Status AllocateResizableBuffer(MemoryPool* pool, const int64_t size,
   return Status::OK();
 }
 
+// ----------------------------------------------------------------------
+// RecyclingBufferPool implementation
+
+class RecyclingBufferPool::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(MemoryPool* pool, int max_cached_buffers)
+      : pool_(pool), max_cached_buffers_(max_cached_buffers) {}
+
+  Status Get(int64_t size, std::shared_ptr<ResizableBuffer>* out) {
+    std::unique_ptr<PoolBuffer> buffer = TakeCachedBuffer(size);
+    if (buffer == nullptr) {
+      buffer.reset(new PoolBuffer(pool_));
+    }
+    RETURN_NOT_OK(buffer->Resize(size, false));
+
+    // The deleter runs when the buffer and all its slices are gone. It only
+    // holds a weak reference so that the pool may go away first
+    std::weak_ptr<Impl> weak_impl = shared_from_this();
+    out->reset(buffer.release(), [weak_impl](ResizableBuffer* released) {
+      std::unique_ptr<PoolBuffer> owned(static_cast<PoolBuffer*>(released));
+      std::shared_ptr<Impl> impl = weak_impl.lock();
+      if (impl != nullptr) {
+        impl->Return(std::move(owned));
+      }
+    });
+    return Status::OK();
+  }
+
+  int num_cached_buffers() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return static_cast<int>(cached_.size());
+  }
+
+  int64_t bytes_cached() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    int64_t total = 0;
+    for (const auto& buffer : cached_) {
+      total += buffer->capacity();
+    }
+    return total;
+  }
+
+ private:
+  std::unique_ptr<PoolBuffer> TakeCachedBuffer(int64_t size) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (cached_.empty()) {
+      return nullptr;
+    }
+    size_t best = 0;
+    for (size_t i = 1; i < cached_.size(); ++i) {
+      const int64_t capacity = cached_[i]->capacity();
+      const int64_t best_capacity = cached_[best]->capacity();
+      const bool fits = capacity >= size;
+      const bool best_fits = best_capacity >= size;
+      if (fits ? (!best_fits || capacity < best_capacity)
+               : (!best_fits && capacity > best_capacity)) {
+        best = i;
+      }
+    }
+    std::unique_ptr<PoolBuffer> buffer = std::move(cached_[best]);
+    cached_.erase(cached_.begin() + best);
+    return buffer;
+  }
+
+  void Return(std::unique_ptr<PoolBuffer> buffer) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (static_cast<int>(cached_.size()) < max_cached_buffers_) {
+      cached_.push_back(std::move(buffer));
+    }
+  }
+
+  MemoryPool* pool_;
+  const int max_cached_buffers_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<PoolBuffer>> cached_;
+};
+
+RecyclingBufferPool::RecyclingBufferPool(MemoryPool* pool, int max_cached_buffers) {
+  if (pool == nullptr) {
+    pool = default_memory_pool();
+  }
+  impl_ = std::make_shared<Impl>(pool, max_cached_buffers);
+}
+
+RecyclingBufferPool::~RecyclingBufferPool() {}
+
+Status RecyclingBufferPool::Get(int64_t size, std::shared_ptr<ResizableBuffer>* out) {
+  return impl_->Get(size, out);
+}
+
+int RecyclingBufferPool::num_cached_buffers() const {
+  return impl_->num_cached_buffers();
+}
+
+int64_t RecyclingBufferPool::bytes_cached() const { return impl_->bytes_cached(); }
+
 }  // namespace arrow
@@ -19,8 +19,10 @@
 #define ARROW_BUFFER_H
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -190,10 +192,39 @@ class ARROW_EXPORT PoolBuffer : public ResizableBuffer {
   MemoryPool* pool_;
 };
 
+/// The factor by which builders grow their capacity by default
+constexpr double kDefaultGrowthFactor = 2.0;
+
+/// \brief Return the capacity to grow to when the required capacity exceeds the
+/// current one
+///
+/// The current capacity is multiplied by the factor (rounded up), or grown to
+/// the required capacity if that is larger. With the default factor the
+/// result is the next power of two of the required capacity. Smaller factors
+/// waste less memory on large buffers, larger ones copy less often.
+///
+/// \param[in] capacity the current capacity
+/// \param[in] required the capacity needed
+/// \param[in] factor the growth factor, greater than 1
+inline int64_t GrowCapacity(int64_t capacity, int64_t required, double factor) {
+  if (factor == kDefaultGrowthFactor) {
+    return BitUtil::NextPower2(required);
+  }
+  const double grown = std::ceil(static_cast<double>(capacity) * factor);
+  if (grown >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+    return required;
+  }
+  return std::max(required, static_cast<int64_t>(grown));
+}
+
 class ARROW_EXPORT BufferBuilder {
  public:
   explicit BufferBuilder(MemoryPool* pool)
-      : pool_(pool), data_(NULLPTR), capacity_(0), size_(0) {}
+      : pool_(pool),
+        data_(NULLPTR),
+        capacity_(0),
+        size_(0),
+        growth_factor_(kDefaultGrowthFactor) {}
 
   /// Resizes the buffer to the nearest multiple of 64 bytes per Layout.md
   Status Resize(const int64_t elements) {
@@ -214,11 +245,20 @@ class ARROW_EXPORT BufferBuilder {
     return Status::OK();
   }
 
-  Status Append(const uint8_t* data, int64_t length) {
-    if (capacity_ < length + size_) {
-      int64_t new_capacity = BitUtil::NextPower2(length + size_);
-      RETURN_NOT_OK(Resize(new_capacity));
+  /// \brief Ensure that at least the given number of bytes can be appended
+  /// without growing the buffer again
+  ///
+  /// The capacity grows by the growth factor, so reserving a few bytes at a
+  /// time does not copy the buffer every time.
+  Status Reserve(const int64_t additional_bytes) {
+    if (capacity_ < additional_bytes + size_) {
+      return Resize(GrowCapacity(capacity_, additional_bytes + size_, growth_factor_));
     }
+    return Status::OK();
+  }
+
+  Status Append(const uint8_t* data, int64_t length) {
+    RETURN_NOT_OK(Reserve(length));
     UnsafeAppend(data, length);
     return Status::OK();
   }
@@ -226,10 +266,7 @@ class ARROW_EXPORT BufferBuilder {
   template <size_t NBYTES>
   Status Append(const std::array<uint8_t, NBYTES>& data) {
     constexpr auto nbytes = static_cast<int64_t>(NBYTES);
-    if (capacity_ < nbytes + size_) {
-      int64_t new_capacity = BitUtil::NextPower2(nbytes + size_);
-      RETURN_NOT_OK(Resize(new_capacity));
-    }
+    RETURN_NOT_OK(Reserve(nbytes));
 
     std::copy(data.cbegin(), data.cend(), data_ + size_);
     size_ += nbytes;
@@ -238,10 +275,7 @@ class ARROW_EXPORT BufferBuilder {
 
   // Advance pointer and zero out memory
   Status Advance(const int64_t length) {
-    if (capacity_ < length + size_) {
-      int64_t new_capacity = BitUtil::NextPower2(length + size_);
-      RETURN_NOT_OK(Resize(new_capacity));
-    }
+    RETURN_NOT_OK(Reserve(length));
     memset(data_ + size_, 0, static_cast<size_t>(length));
     size_ += length;
     return Status::OK();
@@ -272,12 +306,25 @@ class ARROW_EXPORT BufferBuilder {
   int64_t length() const { return size_; }
   const uint8_t* data() const { return data_; }
 
+  /// \brief Set the factor by which the capacity grows when appending
+  ///
+  /// \param[in] factor the factor, greater than 1. See GrowCapacity
+  Status SetGrowthFactor(double factor) {
+    if (!(factor > 1.0)) {
+      return Status::Invalid("Growth factor must be greater than 1");
+    }
+    growth_factor_ = factor;
+    return Status::OK();
+  }
+  double growth_factor() const { return growth_factor_; }
+
  protected:
   std::shared_ptr<PoolBuffer> buffer_;
   MemoryPool* pool_;
   uint8_t* data_;
   int64_t capacity_;
   int64_t size_;
+  double growth_factor_;
 };
 
 template <typename T>
@@ -337,6 +384,43 @@ ARROW_EXPORT
 Status AllocateResizableBuffer(MemoryPool* pool, const int64_t size,
                                std::shared_ptr<ResizableBuffer>* out);
 
+/// \class RecyclingBufferPool
+/// \brief Hands out resizable buffers and keeps their memory for reuse once
+/// the last reference to a buffer, including slices of it, is released
+///
+/// Meant for decoding a sequence of similarly sized messages, where each
+/// buffer only lives as long as the data read into it: after the first few
+/// messages, no memory is allocated anymore. The pool is thread-safe, and
+/// buffers may outlive it, in which case their memory is simply freed.
+class ARROW_EXPORT RecyclingBufferPool {
+ public:
+  /// \param[in] pool the memory pool to allocate from
+  /// \param[in] max_cached_buffers the number of released buffers to keep;
+  /// those released beyond it are freed
+  explicit RecyclingBufferPool(MemoryPool* pool = NULLPTR, int max_cached_buffers = 4);
+  ~RecyclingBufferPool();
+
+  /// \brief Get a buffer of the given size
+  ///
+  /// Reuses the smallest released buffer with enough capacity, or else the
+  /// largest one, which is grown. The contents of the buffer are undefined.
+  ///
+  /// \param[in] size the size of the buffer
+  /// \param[out] out the buffer, which may be resized further by the caller
+  /// \return Status
+  Status Get(int64_t size, std::shared_ptr<ResizableBuffer>* out);
+
+  /// \brief The number of released buffers waiting for reuse
+  int num_cached_buffers() const;
+
+  /// \brief The total capacity of the released buffers waiting for reuse
+  int64_t bytes_cached() const;
+
+ private:
+  class ARROW_NO_EXPORT Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
 #ifndef ARROW_NO_DEPRECATED_API
 
 /// \brief Create Buffer referencing std::string memory
@@ -44,11 +44,9 @@ using internal::WrappedBinary;
 
 Status ArrayBuilder::AppendToBitmap(bool is_valid) {
   if (length_ == capacity_) {
-    // If the capacity was not already a multiple of 2, do so here
-    // TODO(emkornfield) doubling isn't great default allocation practice
-    // see https://github.com/facebook/folly/blob/master/folly/docs/FBVector.md
-    // fo discussion
-    RETURN_NOT_OK(Resize(BitUtil::NextPower2(capacity_ + 1)));
+    // See https://github.com/facebook/folly/blob/master/folly/docs/FBVector.md
+    // for a discussion of growth factors
+    RETURN_NOT_OK(Resize(GrowCapacity(capacity_, capacity_ + 1, growth_factor_)));
   }
   UnsafeAppendToBitmap(is_valid);
   return Status::OK();
@@ -108,13 +106,23 @@ Status ArrayBuilder::Finish(std::shared_ptr<Array>* out) {
 
 Status ArrayBuilder::Reserve(int64_t elements) {
   if (length_ + elements > capacity_) {
-    // TODO(emkornfield) power of 2 growth is potentially suboptimal
-    int64_t new_capacity = BitUtil::NextPower2(length_ + elements);
+    int64_t new_capacity = GrowCapacity(capacity_, length_ + elements, growth_factor_);
     return Resize(new_capacity);
   }
   return Status::OK();
 }
 
+Status ArrayBuilder::SetGrowthFactor(double factor) {
+  if (!(factor > 1.0)) {
+    return Status::Invalid("Growth factor must be greater than 1");
+  }
+  growth_factor_ = factor;
+  for (auto& child : children_) {
+    RETURN_NOT_OK(child->SetGrowthFactor(factor));
+  }
+  return Status::OK();
+}
+
 void ArrayBuilder::Reset() {
   capacity_ = length_ = null_count_ = 0;
   null_bitmap_ = nullptr;
@@ -857,7 +865,9 @@ DictionaryBuilder<FixedSizeBinaryType>::DictionaryBuilder(
 
 template <typename T>
 Status DictionaryBuilder<T>::Init(int64_t elements) {
-  RETURN_NOT_OK(ArrayBuilder::Init(elements));
+  // The validity bitmap is kept by values_builder_, so unlike
+  // ArrayBuilder::Init no null bitmap is allocated here
+  capacity_ = elements;
 
   // Fill the initial hash table
   RETURN_NOT_OK(hash_table_->Resize(sizeof(hash_slot_t) * kInitialHashTableSize));
@@ -870,7 +880,7 @@ Status DictionaryBuilder<T>::Init(int64_t elements) {
 }
 
 Status DictionaryBuilder<NullType>::Init(int64_t elements) {
-  RETURN_NOT_OK(ArrayBuilder::Init(elements));
+  capacity_ = elements;
   return values_builder_.Init(elements);
 }
 
@@ -882,9 +892,10 @@ Status DictionaryBuilder<T>::Resize(int64_t capacity) {
 
   if (capacity_ == 0) {
     return Init(capacity);
-  } else {
-    return ArrayBuilder::Resize(capacity);
   }
+  RETURN_NOT_OK(values_builder_.Resize(capacity));
+  capacity_ = capacity;
+  return Status::OK();
 }
 
 Status DictionaryBuilder<NullType>::Resize(int64_t capacity) {
@@ -894,9 +905,10 @@ Status DictionaryBuilder<NullType>::Resize(int64_t capacity) {
 
   if (capacity_ == 0) {
     return Init(capacity);
-  } else {
-    return ArrayBuilder::Resize(capacity);
   }
+  RETURN_NOT_OK(values_builder_.Resize(capacity));
+  capacity_ = capacity;
+  return Status::OK();
 }
 
 template <typename T>
@@ -906,6 +918,9 @@ Status DictionaryBuilder<T>::FinishInternal(std::shared_ptr<ArrayData>* out) {
 
   RETURN_NOT_OK(values_builder_.FinishInternal(out));
   (*out)->type = std::make_shared<DictionaryType>((*out)->type, dictionary);
+
+  // Start over with an empty hash table on the next append
+  Reset();
   return Status::OK();
 }
 
@@ -914,6 +929,9 @@ Status DictionaryBuilder<NullType>::FinishInternal(std::shared_ptr<ArrayData>* o
 
   RETURN_NOT_OK(values_builder_.FinishInternal(out));
   (*out)->type = std::make_shared<DictionaryType>((*out)->type, dictionary);
+
+  // Start over with an empty hash table on the next append
+  Reset();
   return Status::OK();
 }
 
@@ -947,6 +965,7 @@ Status DictionaryBuilder<T>::Append(const Scalar& value) {
   }
 
   RETURN_NOT_OK(values_builder_.Append(index));
+  ++length_;
 
   return Status::OK();
 }
@@ -990,10 +1009,20 @@ Status DictionaryBuilder<FixedSizeBinaryType>::AppendArray(const Array& array) {
 
 template <typename T>
 Status DictionaryBuilder<T>::AppendNull() {
-  return values_builder_.AppendNull();
+  RETURN_NOT_OK(Reserve(1));
+  RETURN_NOT_OK(values_builder_.AppendNull());
+  ++length_;
+  ++null_count_;
+  return Status::OK();
 }
 
-Status DictionaryBuilder<NullType>::AppendNull() { return values_builder_.AppendNull(); }
+Status DictionaryBuilder<NullType>::AppendNull() {
+  RETURN_NOT_OK(Reserve(1));
+  RETURN_NOT_OK(values_builder_.AppendNull());
+  ++length_;
+  ++null_count_;
+  return Status::OK();
+}
 
 template <typename T>
 Status DictionaryBuilder<T>::DoubleTableSize() {
@@ -1185,6 +1214,28 @@ Status ListBuilder::Append(const int32_t* offsets, int64_t length,
   return Status::OK();
 }
 
+Status ListBuilder::AppendValues(const int32_t* offsets, int64_t length,
+                                 const uint8_t* valid_bytes) {
+  const int64_t base = value_builder_->length() - offsets[0];
+  const int64_t num_values = base + offsets[length];
+  if (ARROW_PREDICT_FALSE(num_values >= std::numeric_limits<int32_t>::max())) {
+    std::stringstream ss;
+    ss << "ListArray cannot contain more then INT32_MAX - 1 child elements,"
+       << " have " << num_values;
+    return Status::Invalid(ss.str());
+  }
+  RETURN_NOT_OK(Reserve(length));
+  UnsafeAppendToBitmap(valid_bytes, length);
+  if (base == 0) {
+    offsets_builder_.UnsafeAppend(offsets, length);
+  } else {
+    for (int64_t i = 0; i < length; ++i) {
+      offsets_builder_.UnsafeAppend(static_cast<int32_t>(base + offsets[i]));
+    }
+  }
+  return Status::OK();
+}
+
 Status ListBuilder::AppendNextOffset() {
   int64_t num_values = value_builder_->length();
   if (ARROW_PREDICT_FALSE(num_values >= std::numeric_limits<int32_t>::max())) {
@@ -1241,6 +1292,20 @@ void ListBuilder::Reset() {
   values_ = nullptr;
 }
 
+Status ListBuilder::ReserveValues(int64_t elements) {
+  DCHECK(!values_) << "Cannot reserve values when values_ is set";
+  return value_builder_->Reserve(elements);
+}
+
+Status ListBuilder::SetGrowthFactor(double factor) {
+  RETURN_NOT_OK(ArrayBuilder::SetGrowthFactor(factor));
+  RETURN_NOT_OK(offsets_builder_.SetGrowthFactor(factor));
+  if (value_builder_) {
+    RETURN_NOT_OK(value_builder_->SetGrowthFactor(factor));
+  }
+  return Status::OK();
+}
+
 ArrayBuilder* ListBuilder::value_builder() const {
   DCHECK(!values_) << "Using value builder is pointless when values_ is set";
   return value_builder_.get();
@@ -1268,15 +1333,36 @@ Status BinaryBuilder::Resize(int64_t capacity) {
   return ArrayBuilder::Resize(capacity);
 }
 
-Status BinaryBuilder::AppendNextOffset() {
-  const int64_t num_bytes = value_data_builder_.length();
+Status BinaryBuilder::ReserveData(int64_t elements) {
+  RETURN_NOT_OK(CheckValueDataCapacity(elements));
+  const int64_t required = value_data_builder_.length() + elements;
+  if (required > value_data_builder_.capacity()) {
+    // A hint is exact, so do not round it up.
+    return value_data_builder_.Resize(required);
+  }
+  return Status::OK();
+}
+
+Status BinaryBuilder::CheckValueDataCapacity(int64_t additional_bytes) const {
+  const int64_t num_bytes = value_data_builder_.length() + additional_bytes;
   if (ARROW_PREDICT_FALSE(num_bytes > kMaximumCapacity)) {
     std::stringstream ss;
     ss << "BinaryArray cannot contain more than " << kMaximumCapacity << " bytes, have "
        << num_bytes;
     return Status::Invalid(ss.str());
   }
-  return offsets_builder_.Append(static_cast<int32_t>(num_bytes));
+  return Status::OK();
+}
+
+Status BinaryBuilder::SetGrowthFactor(double factor) {
+  RETURN_NOT_OK(ArrayBuilder::SetGrowthFactor(factor));
+  RETURN_NOT_OK(offsets_builder_.SetGrowthFactor(factor));
+  return value_data_builder_.SetGrowthFactor(factor);
+}
+
+Status BinaryBuilder::AppendNextOffset() {
+  RETURN_NOT_OK(CheckValueDataCapacity(0));
+  return offsets_builder_.Append(static_cast<int32_t>(value_data_builder_.length()));
 }
 
 Status BinaryBuilder::Append(const uint8_t* value, int32_t length) {
@@ -1287,6 +1373,23 @@ Status BinaryBuilder::Append(const uint8_t* value, int32_t length) {
   return Status::OK();
 }
 
+Status BinaryBuilder::AppendValues(const int32_t* offsets, const uint8_t* data,
+                                   int64_t length, const uint8_t* valid_bytes) {
+  const int64_t data_length = offsets[length] - offsets[0];
+  RETURN_NOT_OK(CheckValueDataCapacity(data_length));
+  RETURN_NOT_OK(Reserve(length));
+  RETURN_NOT_OK(value_data_builder_.Reserve(data_length));
+
+  // Reserve made room for the offsets, including the final one
+  const int64_t base = value_data_builder_.length() - offsets[0];
+  for (int64_t i = 0; i < length; ++i) {
+    offsets_builder_.UnsafeAppend(static_cast<int32_t>(base + offsets[i]));
+  }
+  value_data_builder_.UnsafeAppend(data + offsets[0], data_length);
+  UnsafeAppendToBitmap(valid_bytes, length);
+  return Status::OK();
+}
+
 Status BinaryBuilder::AppendNull() {
   RETURN_NOT_OK(AppendNextOffset());
   RETURN_NOT_OK(Reserve(1));
@@ -1327,6 +1430,30 @@ const uint8_t* BinaryBuilder::GetValue(int64_t i, int32_t* out_length) const {
 
 StringBuilder::StringBuilder(MemoryPool* pool) : BinaryBuilder(utf8(), pool) {}
 
+Status StringBuilder::Append(const std::vector<std::string>& values,
+                             const uint8_t* valid_bytes) {
+  const int64_t length = static_cast<int64_t>(values.size());
+  int64_t data_length = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (valid_bytes == nullptr || valid_bytes[i]) {
+      data_length += static_cast<int64_t>(values[i].size());
+    }
+  }
+  RETURN_NOT_OK(CheckValueDataCapacity(data_length));
+  RETURN_NOT_OK(Reserve(length));
+  RETURN_NOT_OK(value_data_builder_.Reserve(data_length));
+
+  for (int64_t i = 0; i < length; ++i) {
+    offsets_builder_.UnsafeAppend(static_cast<int32_t>(value_data_builder_.length()));
+    if (valid_bytes == nullptr || valid_bytes[i]) {
+      value_data_builder_.UnsafeAppend(reinterpret_cast<const uint8_t*>(values[i].data()),
+                                       static_cast<int64_t>(values[i].size()));
+    }
+  }
+  UnsafeAppendToBitmap(valid_bytes, length);
+  return Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // Fixed width binary
 
@@ -1597,4 +1724,229 @@ Status EncodeColumnToDictionary(const Column& input, MemoryPool* pool,
   }
 }
 
+// ----------------------------------------------------------------------
+// DictionaryUnifier
+
+DictionaryUnifier::DictionaryUnifier(MemoryPool* pool,
+                                     const std::shared_ptr<DataType>& value_type,
+                                     const std::shared_ptr<ArrayBuilder>& builder)
+    : pool_(pool), value_type_(value_type), builder_(builder) {}
+
+Status DictionaryUnifier::Make(MemoryPool* pool,
+                               const std::shared_ptr<DataType>& value_type,
+                               std::unique_ptr<DictionaryUnifier>* out) {
+  std::shared_ptr<ArrayBuilder> builder;
+  RETURN_NOT_OK(MakeDictionaryBuilder(pool, value_type, &builder));
+  out->reset(new DictionaryUnifier(pool, value_type, builder));
+  return Status::OK();
+}
+
+#define DICTIONARY_UNIFY_CASE(ENUM, BuilderType)                              \
+  case Type::ENUM:                                                            \
+    RETURN_NOT_OK(static_cast<BuilderType&>(*builder_).AppendArray(dictionary)); \
+    break;
+
+Status DictionaryUnifier::Unify(const Array& dictionary) {
+  if (!dictionary.type()->Equals(*value_type_)) {
+    std::stringstream ss;
+    ss << "Cannot unify dictionary of type " << dictionary.type()->ToString()
+       << " with dictionaries of type " << value_type_->ToString();
+    return Status::Invalid(ss.str());
+  }
+  if (dictionary.null_count() != 0) {
+    return Status::Invalid("Dictionaries must not contain nulls");
+  }
+  switch (value_type_->id()) {
+    DICTIONARY_UNIFY_CASE(NA, DictionaryBuilder<NullType>);
+    DICTIONARY_UNIFY_CASE(UINT8, DictionaryBuilder<UInt8Type>);
+    DICTIONARY_UNIFY_CASE(INT8, DictionaryBuilder<Int8Type>);
+    DICTIONARY_UNIFY_CASE(UINT16, DictionaryBuilder<UInt16Type>);
+    DICTIONARY_UNIFY_CASE(INT16, DictionaryBuilder<Int16Type>);
+    DICTIONARY_UNIFY_CASE(UINT32, DictionaryBuilder<UInt32Type>);
+    DICTIONARY_UNIFY_CASE(INT32, DictionaryBuilder<Int32Type>);
+    DICTIONARY_UNIFY_CASE(UINT64, DictionaryBuilder<UInt64Type>);
+    DICTIONARY_UNIFY_CASE(INT64, DictionaryBuilder<Int64Type>);
+    DICTIONARY_UNIFY_CASE(DATE32, DictionaryBuilder<Date32Type>);
+    DICTIONARY_UNIFY_CASE(DATE64, DictionaryBuilder<Date64Type>);
+    DICTIONARY_UNIFY_CASE(TIME32, DictionaryBuilder<Time32Type>);
+    DICTIONARY_UNIFY_CASE(TIME64, DictionaryBuilder<Time64Type>);
+    DICTIONARY_UNIFY_CASE(TIMESTAMP, DictionaryBuilder<TimestampType>);
+    DICTIONARY_UNIFY_CASE(FLOAT, DictionaryBuilder<FloatType>);
+    DICTIONARY_UNIFY_CASE(DOUBLE, DictionaryBuilder<DoubleType>);
+    DICTIONARY_UNIFY_CASE(STRING, StringDictionaryBuilder);
+    DICTIONARY_UNIFY_CASE(BINARY, BinaryDictionaryBuilder);
+    DICTIONARY_UNIFY_CASE(FIXED_SIZE_BINARY, DictionaryBuilder<FixedSizeBinaryType>);
+    DICTIONARY_UNIFY_CASE(DECIMAL, DictionaryBuilder<FixedSizeBinaryType>);
+    default:
+      return Status::NotImplemented(value_type_->ToString());
+  }
+  dictionary_lengths_.push_back(dictionary.length());
+  return Status::OK();
+}
+
+#undef DICTIONARY_UNIFY_CASE
+
+Status DictionaryUnifier::GetResult(
+    std::shared_ptr<DataType>* out_type,
+    std::vector<std::vector<int32_t>>* out_transpose_maps) {
+  // Encoding the values of all dictionaries yields the unified dictionary, and
+  // the indices of the values of each dictionary are its transposition map
+  std::shared_ptr<Array> encoded;
+  RETURN_NOT_OK(builder_->Finish(&encoded));
+  const auto& unified = static_cast<const DictionaryArray&>(*encoded);
+  *out_type = encoded->type();
+
+  // Widen the indices to int32 through the identity map
+  std::vector<int32_t> identity(unified.dictionary()->length());
+  for (size_t i = 0; i < identity.size(); ++i) {
+    identity[i] = static_cast<int32_t>(i);
+  }
+  std::shared_ptr<Array> widened;
+  RETURN_NOT_OK(unified.Transpose(
+      pool_, std::make_shared<DictionaryType>(int32(), unified.dictionary()), identity,
+      &widened));
+  const int32_t* indices =
+      static_cast<const Int32Array&>(*static_cast<const DictionaryArray&>(*widened)
+                                          .indices())
+          .raw_values();
+
+  out_transpose_maps->clear();
+  for (int64_t length : dictionary_lengths_) {
+    out_transpose_maps->emplace_back(indices, indices + length);
+    indices += length;
+  }
+  dictionary_lengths_.clear();
+  return Status::OK();
+}
+
+namespace {
+
+// Transposing in place reuses the index buffers of arrays whose index type
+// does not change; only do so if nothing else refers to them
+Status UnifyDictionaries(const ArrayVector& arrays, MemoryPool* pool, bool in_place,
+                         ArrayVector* out) {
+  if (arrays.empty()) {
+    out->clear();
+    return Status::OK();
+  }
+  for (const auto& array : arrays) {
+    if (array->type_id() != Type::DICTIONARY) {
+      return Status::Invalid("Cannot unify dictionaries of non-dictionary arrays");
+    }
+  }
+  const auto& first = static_cast<const DictionaryArray&>(*arrays[0]);
+  std::unique_ptr<DictionaryUnifier> unifier;
+  RETURN_NOT_OK(DictionaryUnifier::Make(pool, first.dictionary()->type(), &unifier));
+  for (const auto& array : arrays) {
+    const auto& dict_array = static_cast<const DictionaryArray&>(*array);
+    RETURN_NOT_OK(unifier->Unify(*dict_array.dictionary()));
+  }
+  std::shared_ptr<DataType> type;
+  std::vector<std::vector<int32_t>> transpose_maps;
+  RETURN_NOT_OK(unifier->GetResult(&type, &transpose_maps));
+  const auto& index_type = *static_cast<const DictionaryType&>(*type).index_type();
+
+  ArrayVector result(arrays.size());
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    const auto& array = static_cast<const DictionaryArray&>(*arrays[i]);
+    std::shared_ptr<Array> indices = array.indices();
+    if (in_place && indices->type()->Equals(index_type)) {
+      RETURN_NOT_OK(TransposeIndicesInPlace(transpose_maps[i], *indices));
+      result[i] = std::make_shared<DictionaryArray>(type, indices);
+    } else {
+      RETURN_NOT_OK(array.Transpose(pool, type, transpose_maps[i], &result[i]));
+    }
+  }
+  *out = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace
+
+Status UnifyDictionaries(const ArrayVector& arrays, MemoryPool* pool, ArrayVector* out) {
+  return UnifyDictionaries(arrays, pool, false, out);
+}
+
+// ----------------------------------------------------------------------
+// ConcurrentArrayBuilder
+
+ConcurrentArrayBuilder::ConcurrentArrayBuilder(
+    MemoryPool* pool, std::vector<std::shared_ptr<ArrayBuilder>> partitions)
+    : pool_(pool), partitions_(std::move(partitions)) {}
+
+Status ConcurrentArrayBuilder::Make(MemoryPool* pool,
+                                    const std::shared_ptr<DataType>& type,
+                                    int num_partitions,
+                                    std::unique_ptr<ConcurrentArrayBuilder>* out) {
+  if (num_partitions < 1) {
+    return Status::Invalid("A concurrent builder needs at least one partition");
+  }
+  std::vector<std::shared_ptr<ArrayBuilder>> partitions;
+  for (int i = 0; i < num_partitions; ++i) {
+    std::unique_ptr<ArrayBuilder> builder;
+    RETURN_NOT_OK(MakeBuilder(pool, type, &builder));
+    partitions.emplace_back(std::move(builder));
+  }
+  out->reset(new ConcurrentArrayBuilder(pool, std::move(partitions)));
+  return Status::OK();
+}
+
+Status ConcurrentArrayBuilder::MakeDictionary(
+    MemoryPool* pool, const std::shared_ptr<DataType>& value_type, int num_partitions,
+    std::unique_ptr<ConcurrentArrayBuilder>* out) {
+  if (num_partitions < 1) {
+    return Status::Invalid("A concurrent builder needs at least one partition");
+  }
+  std::vector<std::shared_ptr<ArrayBuilder>> partitions(num_partitions);
+  for (auto& builder : partitions) {
+    RETURN_NOT_OK(MakeDictionaryBuilder(pool, value_type, &builder));
+  }
+  out->reset(new ConcurrentArrayBuilder(pool, std::move(partitions)));
+  return Status::OK();
+}
+
+int64_t ConcurrentArrayBuilder::length() const {
+  int64_t length = 0;
+  for (const auto& builder : partitions_) {
+    length += builder->length();
+  }
+  return length;
+}
+
+Status ConcurrentArrayBuilder::FinishPartitions(ArrayVector* out) {
+  ArrayVector arrays(partitions_.size());
+  for (size_t i = 0; i < partitions_.size(); ++i) {
+    RETURN_NOT_OK(partitions_[i]->Finish(&arrays[i]));
+  }
+  // Partitions with different dictionaries (or index widths) have different
+  // types and need to be unified first
+  bool same_type = true;
+  for (const auto& array : arrays) {
+    same_type = same_type && array->type()->Equals(*arrays[0]->type());
+  }
+  if (!same_type && arrays[0]->type_id() == Type::DICTIONARY) {
+    // The partitions' indices are not shared with anyone yet
+    RETURN_NOT_OK(UnifyDictionaries(arrays, pool_, true, &arrays));
+  }
+  *out = std::move(arrays);
+  return Status::OK();
+}
+
+Status ConcurrentArrayBuilder::Finish(std::shared_ptr<Array>* out) {
+  ArrayVector arrays;
+  RETURN_NOT_OK(FinishPartitions(&arrays));
+  if (arrays.size() == 1) {
+    *out = arrays[0];
+    return Status::OK();
+  }
+  return Concatenate(arrays, pool_, out);
+}
+
+Status ConcurrentArrayBuilder::Finish(std::shared_ptr<ChunkedArray>* out) {
+  ArrayVector arrays;
+  RETURN_NOT_OK(FinishPartitions(&arrays));
+  *out = std::make_shared<ChunkedArray>(arrays);
+  return Status::OK();
+}
+
 }  // namespace arrow
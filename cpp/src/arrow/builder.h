@@ -63,7 +63,8 @@ class ARROW_EXPORT ArrayBuilder {
         null_count_(0),
         null_bitmap_data_(NULLPTR),
         length_(0),
-        capacity_(0) {}
+        capacity_(0),
+        growth_factor_(kDefaultGrowthFactor) {}
 
   virtual ~ArrayBuilder() = default;
 
@@ -101,6 +102,16 @@ class ARROW_EXPORT ArrayBuilder {
   /// capacity and calling Resize if necessary.
   Status Reserve(int64_t elements);
 
+  /// \brief Set the factor by which the capacity grows when appending
+  ///
+  /// The default factor grows the capacity to powers of two. Builders of
+  /// nested and variable-length types also apply the factor to their children
+  /// and value data.
+  ///
+  /// \param[in] factor the factor, greater than 1. See GrowCapacity
+  virtual Status SetGrowthFactor(double factor);
+  double growth_factor() const { return growth_factor_; }
+
   /// For cases where raw data was memcpy'd into the internal buffers, allows us
   /// to advance the length of the builder. It is your responsibility to use
   /// this function responsibly.
@@ -124,7 +135,7 @@ class ARROW_EXPORT ArrayBuilder {
   std::shared_ptr<DataType> type() const { return type_; }
 
  protected:
-  ArrayBuilder() {}
+  ArrayBuilder() : growth_factor_(kDefaultGrowthFactor) {}
 
   std::shared_ptr<DataType> type_;
   MemoryPool* pool_;
@@ -137,6 +148,7 @@ class ARROW_EXPORT ArrayBuilder {
   // Array length, so far. Also, the index of the next element to be added
   int64_t length_;
   int64_t capacity_;
+  double growth_factor_;
 
   // Child value array builders. These are owned by this class
   std::vector<std::unique_ptr<ArrayBuilder>> children_;
@@ -637,6 +649,22 @@ class ARROW_EXPORT ListBuilder : public ArrayBuilder {
   Status Append(const int32_t* offsets, int64_t length,
                 const uint8_t* valid_bytes = NULLPTR);
 
+  /// \brief Append a sequence of list slots with a single capacity check
+  ///
+  /// Unlike Append, the offsets need not be relative to the value builder:
+  /// they are rebased so that slot i starts at the current length of the
+  /// value builder plus offsets[i] - offsets[0]. Append the
+  /// offsets[length] - offsets[0] child values to the value builder after
+  /// calling this function.
+  ///
+  /// \param[in] offsets length + 1 offsets into the child values
+  /// \param[in] length the number of list slots
+  /// \param[in] valid_bytes an optional sequence of bytes where non-zero
+  /// indicates a valid (non-null) slot
+  /// \return Status
+  Status AppendValues(const int32_t* offsets, int64_t length,
+                      const uint8_t* valid_bytes = NULLPTR);
+
   /// \brief Start a new variable-length list slot
   ///
   /// This function should be called before beginning to append elements to the
@@ -645,6 +673,12 @@ class ARROW_EXPORT ListBuilder : public ArrayBuilder {
 
   Status AppendNull() { return Append(false); }
 
+  /// \brief Ensure that the given number of child values can be appended
+  /// without growing the value builder
+  Status ReserveValues(int64_t elements);
+
+  Status SetGrowthFactor(double factor) override;
+
   ArrayBuilder* value_builder() const;
 
  protected:
@@ -680,12 +714,42 @@ class ARROW_EXPORT BinaryBuilder : public ArrayBuilder {
 
   Status AppendNull();
 
+  /// \brief Append a sequence of values with a single capacity check
+  ///
+  /// Value i is data[offsets[i], offsets[i + 1]). The offsets need not start
+  /// at zero; they are rebased onto the value data already in the builder, and
+  /// the bytes from offsets[0] to offsets[length] are copied at once.
+  ///
+  /// \param[in] offsets length + 1 offsets into data
+  /// \param[in] data the value data
+  /// \param[in] length the number of values
+  /// \param[in] valid_bytes an optional sequence of bytes where non-zero
+  /// indicates a valid (non-null) value
+  /// \return Status
+  Status AppendValues(const int32_t* offsets, const uint8_t* data, int64_t length,
+                      const uint8_t* valid_bytes = NULLPTR);
+
   Status Init(int64_t elements) override;
   Status Resize(int64_t capacity) override;
   Status FinishInternal(std::shared_ptr<ArrayData>* out) override;
 
+  /// \brief Ensure that the given number of bytes of value data can be
+  /// appended without growing the values buffer
+  ///
+  /// Together with Reserve, this allows a column whose size is known in
+  /// advance to be built without copying any of its buffers.
+  ///
+  /// \param[in] elements the number of bytes
+  /// \return Status, Invalid if the value data would exceed the maximum size
+  /// of a BinaryArray
+  Status ReserveData(int64_t elements);
+
+  Status SetGrowthFactor(double factor) override;
+
   /// \return size of values buffer so far
   int64_t value_data_length() const { return value_data_builder_.length(); }
+  /// \return capacity of values buffer
+  int64_t value_data_capacity() const { return value_data_builder_.capacity(); }
 
   /// Temporary access to a value.
   ///
@@ -699,6 +763,7 @@ class ARROW_EXPORT BinaryBuilder : public ArrayBuilder {
   static constexpr int64_t kMaximumCapacity = std::numeric_limits<int32_t>::max() - 1;
 
   Status AppendNextOffset();
+  Status CheckValueDataCapacity(int64_t additional_bytes) const;
   void Reset();
 };
 
@@ -711,7 +776,14 @@ class ARROW_EXPORT StringBuilder : public BinaryBuilder {
 
   using BinaryBuilder::Append;
 
-  Status Append(const std::vector<std::string>& values, uint8_t* null_bytes);
+  /// \brief Append a sequence of strings with a single capacity check
+  ///
+  /// \param[in] values the strings
+  /// \param[in] valid_bytes an optional sequence of bytes where non-zero
+  /// indicates a valid (non-null) value
+  /// \return Status
+  Status Append(const std::vector<std::string>& values,
+                const uint8_t* valid_bytes = NULLPTR);
 };
 
 // ----------------------------------------------------------------------
@@ -993,6 +1065,131 @@ Status ARROW_EXPORT EncodeArrayToDictionary(const Array& input, MemoryPool* pool
 /// \param[out] out Column with data converted to DictionaryArray
 Status ARROW_EXPORT EncodeColumnToDictionary(const Column& input, MemoryPool* pool,
                                              std::shared_ptr<Column>* out);
+
+// ----------------------------------------------------------------------
+// Dictionary unification
+
+/// \brief Merges dictionaries of the same value type into one
+///
+/// The values of every dictionary passed to Unify go through the hash table of
+/// a DictionaryBuilder, so the unified dictionary holds each distinct value
+/// once, in order of first appearance. For every dictionary, GetResult returns
+/// a transposition map from its indices to indices into the unified
+/// dictionary, to be applied with DictionaryArray::Transpose or
+/// TransposeIndicesInPlace.
+class ARROW_EXPORT DictionaryUnifier {
+ public:
+  /// \brief Create a unifier for dictionaries of value_type
+  ///
+  /// \param[in] pool memory pool for the hash table and the unified dictionary
+  /// \param[in] value_type the type of the dictionary values
+  /// \param[out] out the new unifier
+  /// \return Status, NotImplemented if there is no DictionaryBuilder for
+  /// value_type
+  static Status Make(MemoryPool* pool, const std::shared_ptr<DataType>& value_type,
+                     std::unique_ptr<DictionaryUnifier>* out);
+
+  /// \brief Add the values of a dictionary to the unified dictionary
+  ///
+  /// \param[in] dictionary dictionary values without nulls
+  /// \return Status, Invalid if the dictionary has another type or nulls
+  Status Unify(const Array& dictionary);
+
+  /// \brief Return the unified dictionary and start over
+  ///
+  /// \param[out] out_type DictionaryType of the unified dictionary, with the
+  /// smallest signed index type that can address it
+  /// \param[out] out_transpose_maps one transposition map per call to Unify,
+  /// in call order
+  /// \return Status
+  Status GetResult(std::shared_ptr<DataType>* out_type,
+                   std::vector<std::vector<int32_t>>* out_transpose_maps);
+
+ private:
+  DictionaryUnifier(MemoryPool* pool, const std::shared_ptr<DataType>& value_type,
+                    const std::shared_ptr<ArrayBuilder>& builder);
+
+  MemoryPool* pool_;
+  std::shared_ptr<DataType> value_type_;
+  std::shared_ptr<ArrayBuilder> builder_;
+  std::vector<int64_t> dictionary_lengths_;
+};
+
+/// \brief Re-encode DictionaryArrays with the same value type against one
+/// unified dictionary
+///
+/// \param[in] arrays DictionaryArrays, possibly with different dictionaries
+/// \param[in] pool memory pool to allocate the new dictionary and indices from
+/// \param[out] out the arrays in the same order, all of one DictionaryType
+/// \return Status
+ARROW_EXPORT
+Status UnifyDictionaries(const ArrayVector& arrays, MemoryPool* pool, ArrayVector* out);
+
+// ----------------------------------------------------------------------
+// Building from several threads
+
+/// \brief Builds one array from several threads, each appending to its own
+/// partition
+///
+/// Builders are not thread-safe, so every worker gets a builder of its own
+/// (a partition) and appends to it without synchronization. Finishing joins
+/// the partitions in partition order: into one array by shifting the null
+/// bitmaps and rebasing the offsets, or into a chunked array with one chunk
+/// per partition without copying. The dictionaries of dictionary-encoded
+/// partitions are unified and their indices transposed onto the unified
+/// dictionary.
+///
+/// Finish must not run concurrently with appends to any partition.
+class ARROW_EXPORT ConcurrentArrayBuilder {
+ public:
+  /// \brief Create a builder whose partitions are made with MakeBuilder
+  ///
+  /// \param[in] pool memory pool for the partitions and the joined result
+  /// \param[in] type the type of the array to build
+  /// \param[in] num_partitions the number of partitions, usually one per thread
+  /// \param[out] out the new builder
+  /// \return Status
+  static Status Make(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+                     int num_partitions, std::unique_ptr<ConcurrentArrayBuilder>* out);
+
+  /// \brief Create a builder whose partitions are made with
+  /// MakeDictionaryBuilder, producing a DictionaryArray of value_type
+  ///
+  /// \param[in] pool memory pool for the partitions and the joined result
+  /// \param[in] value_type the type of the dictionary values
+  /// \param[in] num_partitions the number of partitions, usually one per thread
+  /// \param[out] out the new builder
+  /// \return Status
+  static Status MakeDictionary(MemoryPool* pool,
+                               const std::shared_ptr<DataType>& value_type,
+                               int num_partitions,
+                               std::unique_ptr<ConcurrentArrayBuilder>* out);
+
+  int num_partitions() const { return static_cast<int>(partitions_.size()); }
+
+  /// \brief The builder of partition i; cast it to the concrete builder type
+  ArrayBuilder* partition(int i) const { return partitions_[i].get(); }
+
+  /// \brief The total number of slots appended to all partitions
+  int64_t length() const;
+
+  /// \brief Join the partitions into one contiguous array and reset them
+  Status Finish(std::shared_ptr<Array>* out);
+
+  /// \brief Join the partitions into a chunked array with one chunk per
+  /// partition and reset them
+  Status Finish(std::shared_ptr<ChunkedArray>* out);
+
+ private:
+  ConcurrentArrayBuilder(MemoryPool* pool,
+                         std::vector<std::shared_ptr<ArrayBuilder>> partitions);
+
+  Status FinishPartitions(ArrayVector* out);
+
+  MemoryPool* pool_;
+  std::vector<std::shared_ptr<ArrayBuilder>> partitions_;
+};
+
 }  // namespace arrow
 
 #endif  // ARROW_BUILDER_H_
@@ -503,7 +503,9 @@ int ReadableFile::file_descriptor() const { return impl_->fd(); }
 class FileOutputStream::FileOutputStreamImpl : public OSFile {
  public:
   Status Open(const std::string& path, bool append) {
-    return OpenWriteable(path, append, true);
+    RETURN_NOT_OK(OpenWriteable(path, append, true));
+    // Writes continue at the end of an existing file
+    return append ? Seek(size()) : Status::OK();
   }
 };
 
@@ -193,6 +193,29 @@ TEST_F(TestFileOutputStream, TruncatesNewFile) {
   ASSERT_EQ(0, size);
 }
 
+TEST_F(TestFileOutputStream, Append) {
+  OpenFile();
+  const char* data = "test";
+  ASSERT_OK(file_->Write(reinterpret_cast<const uint8_t*>(data), strlen(data)));
+  ASSERT_OK(file_->Close());
+
+  OpenFile(true);
+  int64_t position;
+  ASSERT_OK(file_->Tell(&position));
+  ASSERT_EQ(4, position);
+
+  data = "data";
+  ASSERT_OK(file_->Write(reinterpret_cast<const uint8_t*>(data), strlen(data)));
+  ASSERT_OK(file_->Close());
+
+  std::shared_ptr<ReadableFile> rd_file;
+  ASSERT_OK(ReadableFile::Open(path_, &rd_file));
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(rd_file->Read(100, &buffer));
+  ASSERT_EQ("testdata", std::string(reinterpret_cast<const char*>(buffer->data()),
+                                    static_cast<size_t>(buffer->size())));
+}
+
 // ----------------------------------------------------------------------
 // File input tests
 
@@ -23,6 +23,8 @@
 #include "arrow/ipc/json.h"
 #include "arrow/ipc/message.h"
 #include "arrow/ipc/reader.h"
+#include "arrow/ipc/statistics.h"
+#include "arrow/ipc/stream_index.h"
 #include "arrow/ipc/writer.h"
 
 #endif  // ARROW_IPC_API_H
@@ -80,5 +80,19 @@ Status DictionaryMemo::AddDictionary(int64_t id,
   return Status::OK();
 }
 
+Status DictionaryMemo::UpdateDictionary(int64_t id,
+                                        const std::shared_ptr<Array>& dictionary) {
+  auto it = id_to_dictionary_.find(id);
+  if (it == id_to_dictionary_.end()) {
+    std::stringstream ss;
+    ss << "Dictionary with id " << id << " not found";
+    return Status::KeyError(ss.str());
+  }
+  dictionary_to_id_.erase(reinterpret_cast<intptr_t>(it->second.get()));
+  it->second = dictionary;
+  dictionary_to_id_[reinterpret_cast<intptr_t>(dictionary.get())] = id;
+  return Status::OK();
+}
+
 }  // namespace ipc
 }  // namespace arrow
@@ -17,11 +17,15 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "arrow/api.h"
+#include "arrow/io/file.h"
 #include "arrow/io/memory.h"
 #include "arrow/ipc/api.h"
 #include "arrow/test-util.h"
@@ -116,6 +120,326 @@ static void BM_ReadRecordBatch(benchmark::State& state) {  // NOLINT non-const r
   state.SetBytesProcessed(int64_t(state.iterations()) * kTotalSize);
 }
 
+// ----------------------------------------------------------------------
+// Batches of other shapes, each about total_size bytes
+
+static std::shared_ptr<RecordBatch> RepeatColumn(const std::shared_ptr<Array>& array,
+                                                 int64_t num_fields) {
+  ArrayVector arrays;
+  std::vector<std::shared_ptr<Field>> fields;
+  for (int64_t i = 0; i < num_fields; ++i) {
+    std::stringstream ss;
+    ss << "f" << i;
+    fields.push_back(field(ss.str(), array->type()));
+    arrays.push_back(array);
+  }
+  return std::make_shared<RecordBatch>(std::make_shared<Schema>(fields), array->length(),
+                                       arrays);
+}
+
+// Strings of 1 to 32 characters, 10% null
+static std::shared_ptr<Array> MakeStrings(int64_t length) {
+  std::vector<bool> is_valid;
+  test::random_is_valid(length, 0.1, &is_valid);
+  std::vector<int32_t> lengths;
+  test::randint<int32_t>(length, 1, 32, &lengths);
+  std::vector<uint8_t> chars(32);
+
+  StringBuilder builder(default_memory_pool());
+  for (int64_t i = 0; i < length; ++i) {
+    if (is_valid[i]) {
+      test::random_ascii(lengths[i], static_cast<uint32_t>(i), chars.data());
+      ABORT_NOT_OK(builder.Append(chars.data(), lengths[i]));
+    } else {
+      ABORT_NOT_OK(builder.AppendNull());
+    }
+  }
+  std::shared_ptr<Array> array;
+  ABORT_NOT_OK(builder.Finish(&array));
+  return array;
+}
+
+std::shared_ptr<RecordBatch> MakeStringBatch(int64_t total_size, int64_t num_fields) {
+  // The average string takes 16.5 characters and a 4-byte offset
+  const int64_t length = std::max<int64_t>(1, total_size / num_fields / 20);
+  return RepeatColumn(MakeStrings(length), num_fields);
+}
+
+// int32 indices into a dictionary of 1000 strings
+std::shared_ptr<RecordBatch> MakeDictionaryBatch(int64_t total_size, int64_t num_fields) {
+  const int64_t length = std::max<int64_t>(1, total_size / num_fields / 4);
+  std::vector<int32_t> values;
+  test::randint<int32_t>(length, 0, 999, &values);
+  std::shared_ptr<Array> indices;
+  ArrayFromVector<Int32Type, int32_t>(values, &indices);
+
+  auto dictionary = MakeStrings(1000);
+  auto type = ::arrow::dictionary(int32(), dictionary);
+  return RepeatColumn(std::make_shared<DictionaryArray>(type, indices), num_fields);
+}
+
+// A single column of int64 values nested in depth levels of lists of two
+// values and structs, alternately
+std::shared_ptr<RecordBatch> MakeNestedBatch(int64_t total_size, int64_t depth) {
+  auto leaves = MakeRecordBatch<Int64Type>(total_size, 1);
+  std::shared_ptr<Array> array = leaves->column(0);
+  for (int64_t level = 0; level < depth; ++level) {
+    if (level % 2 == 0) {
+      const int64_t length = array->length() / 2;
+      std::vector<int32_t> offsets;
+      for (int64_t i = 0; i <= length; ++i) {
+        offsets.push_back(static_cast<int32_t>(i * 2));
+      }
+      std::shared_ptr<Array> offsets_array;
+      ArrayFromVector<Int32Type, int32_t>(offsets, &offsets_array);
+      auto value_offsets = static_cast<const Int32Array&>(*offsets_array).values();
+      array = std::make_shared<ListArray>(list(array->type()), length, value_offsets,
+                                          array);
+    } else {
+      auto type = struct_({field("item", array->type())});
+      array = std::make_shared<StructArray>(type, array->length(), ArrayVector{array});
+    }
+  }
+  return RepeatColumn(array, 1);
+}
+
+// A batch whose columns start at an odd offset into their buffers, so that
+// writing copies the bitmaps
+std::shared_ptr<RecordBatch> MakeSlicedBatch(int64_t total_size, int64_t num_fields) {
+  auto batch = MakeRecordBatch<Int64Type>(total_size, num_fields);
+  return batch->Slice(3, batch->num_rows() - 3);
+}
+
+using BatchFactory = std::shared_ptr<RecordBatch> (*)(int64_t, int64_t);
+
+// ----------------------------------------------------------------------
+// Single messages
+//
+// Throughput is of the whole message. The metadata size is in the label, and
+// BM_*RecordBatchMetadata time the metadata on its own
+
+static void WriteMessages(benchmark::State& state, const RecordBatch& batch) {
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  int32_t metadata_length = 0;
+  int64_t body_length = 0;
+  while (state.KeepRunning()) {
+    io::BufferOutputStream stream(buffer);
+    if (!ipc::WriteRecordBatch(batch, 0, &stream, &metadata_length, &body_length,
+                               default_memory_pool())
+             .ok()) {
+      state.SkipWithError("Failed to write!");
+    }
+  }
+  std::stringstream ss;
+  ss << "metadata " << metadata_length << " B, body " << body_length << " B";
+  state.SetLabel(ss.str());
+  state.SetBytesProcessed(int64_t(state.iterations()) * (metadata_length + body_length));
+}
+
+static void ReadMessages(benchmark::State& state, const RecordBatch& batch) {
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(ipc::SerializeRecordBatch(batch, default_memory_pool(), &buffer));
+  while (state.KeepRunning()) {
+    std::shared_ptr<RecordBatch> result;
+    io::BufferReader reader(buffer);
+    if (!ipc::ReadRecordBatch(batch.schema(), &reader, &result).ok()) {
+      state.SkipWithError("Failed to read!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer->size());
+}
+
+template <BatchFactory MakeBatch>
+static void BM_WriteBatch(benchmark::State& state) {  // NOLINT non-const reference
+  WriteMessages(state, *MakeBatch(1 << 20, state.range(0)));
+}
+
+template <BatchFactory MakeBatch>
+static void BM_ReadBatch(benchmark::State& state) {  // NOLINT non-const reference
+  ReadMessages(state, *MakeBatch(1 << 20, state.range(0)));
+}
+
+// A batch without rows, so only its metadata is written and parsed.
+// Throughput counts metadata bytes, items count columns
+std::shared_ptr<RecordBatch> MakeEmptyBatch(int64_t num_fields) {
+  return MakeRecordBatch<Int64Type>(8 * num_fields, num_fields)->Slice(0, 0);
+}
+
+static void BM_WriteRecordBatchMetadata(
+    benchmark::State& state) {  // NOLINT non-const reference
+  auto batch = MakeEmptyBatch(state.range(0));
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  int32_t metadata_length = 0;
+  int64_t body_length = 0;
+  while (state.KeepRunning()) {
+    io::BufferOutputStream stream(buffer);
+    if (!ipc::WriteRecordBatch(*batch, 0, &stream, &metadata_length, &body_length,
+                               default_memory_pool())
+             .ok()) {
+      state.SkipWithError("Failed to write!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * metadata_length);
+  state.SetItemsProcessed(int64_t(state.iterations()) * batch->num_columns());
+}
+
+static void BM_ReadRecordBatchMetadata(
+    benchmark::State& state) {  // NOLINT non-const reference
+  auto batch = MakeEmptyBatch(state.range(0));
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(ipc::SerializeRecordBatch(*batch, default_memory_pool(), &buffer));
+  while (state.KeepRunning()) {
+    std::shared_ptr<RecordBatch> result;
+    io::BufferReader reader(buffer);
+    if (!ipc::ReadRecordBatch(batch->schema(), &reader, &result).ok()) {
+      state.SkipWithError("Failed to read!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer->size());
+  state.SetItemsProcessed(int64_t(state.iterations()) * batch->num_columns());
+}
+
+static void BM_ReadSchema(benchmark::State& state) {  // NOLINT non-const reference
+  auto schema = MakeEmptyBatch(state.range(0))->schema();
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(ipc::SerializeSchema(*schema, default_memory_pool(), &buffer));
+  while (state.KeepRunning()) {
+    std::shared_ptr<Schema> result;
+    io::BufferReader reader(buffer);
+    if (!ipc::ReadSchema(&reader, &result).ok()) {
+      state.SkipWithError("Failed to read!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer->size());
+  state.SetItemsProcessed(int64_t(state.iterations()) * schema->num_fields());
+}
+
+// ----------------------------------------------------------------------
+// Stream and file formats
+//
+// 16 batches of 1MB each, with range(0) columns of int64
+
+constexpr int kNumBatches = 16;
+
+enum BenchmarkFormat { kStreamFormat, kFileFormat };
+
+enum BenchmarkSource { kInMemory, kMemoryMap, kReadableFile };
+
+static const char* kBenchmarkPath = "ipc-read-write-benchmark.arrow";
+
+static Status WriteBatches(const RecordBatch& batch, BenchmarkFormat format,
+                           io::OutputStream* sink) {
+  std::shared_ptr<ipc::RecordBatchWriter> writer;
+  if (format == kStreamFormat) {
+    RETURN_NOT_OK(ipc::RecordBatchStreamWriter::Open(sink, batch.schema(), &writer));
+  } else {
+    RETURN_NOT_OK(ipc::RecordBatchFileWriter::Open(sink, batch.schema(), &writer));
+  }
+  for (int i = 0; i < kNumBatches; ++i) {
+    RETURN_NOT_OK(writer->WriteRecordBatch(batch));
+  }
+  return writer->Close();
+}
+
+static Status ReadBatches(BenchmarkFormat format,
+                          const std::shared_ptr<io::RandomAccessFile>& source) {
+  std::shared_ptr<RecordBatch> batch;
+  if (format == kStreamFormat) {
+    std::shared_ptr<RecordBatchReader> reader;
+    RETURN_NOT_OK(ipc::RecordBatchStreamReader::Open(source, &reader));
+    do {
+      RETURN_NOT_OK(reader->ReadNext(&batch));
+    } while (batch != nullptr);
+  } else {
+    std::shared_ptr<ipc::RecordBatchFileReader> reader;
+    RETURN_NOT_OK(ipc::RecordBatchFileReader::Open(source.get(), &reader));
+    for (int i = 0; i < reader->num_record_batches(); ++i) {
+      RETURN_NOT_OK(reader->ReadRecordBatch(i, &batch));
+    }
+  }
+  return Status::OK();
+}
+
+// range(0): columns, range(1): BenchmarkFormat
+static void BM_WriteBatches(benchmark::State& state) {  // NOLINT non-const reference
+  auto batch = MakeRecordBatch<Int64Type>(1 << 20, state.range(0));
+  const auto format = static_cast<BenchmarkFormat>(state.range(1));
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  while (state.KeepRunning()) {
+    io::BufferOutputStream stream(buffer);
+    if (!WriteBatches(*batch, format, &stream).ok()) {
+      state.SkipWithError("Failed to write!");
+    }
+  }
+  state.SetLabel(format == kStreamFormat ? "stream" : "file");
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer->size());
+}
+
+// range(0): columns, range(1): BenchmarkFormat, range(2): BenchmarkSource. The
+// data is read from the page cache for the file sources
+static void BM_ReadBatches(benchmark::State& state) {  // NOLINT non-const reference
+  auto batch = MakeRecordBatch<Int64Type>(1 << 20, state.range(0));
+  const auto format = static_cast<BenchmarkFormat>(state.range(1));
+  const auto source_type = static_cast<BenchmarkSource>(state.range(2));
+
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  io::BufferOutputStream stream(buffer);
+  ABORT_NOT_OK(WriteBatches(*batch, format, &stream));
+  ABORT_NOT_OK(stream.Close());
+  if (source_type != kInMemory) {
+    std::shared_ptr<io::FileOutputStream> file;
+    ABORT_NOT_OK(io::FileOutputStream::Open(kBenchmarkPath, &file));
+    ABORT_NOT_OK(file->Write(buffer->data(), buffer->size()));
+    ABORT_NOT_OK(file->Close());
+  }
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<io::RandomAccessFile> source;
+    if (source_type == kInMemory) {
+      source = std::make_shared<io::BufferReader>(buffer);
+    } else if (source_type == kMemoryMap) {
+      std::shared_ptr<io::MemoryMappedFile> mmap;
+      ABORT_NOT_OK(io::MemoryMappedFile::Open(kBenchmarkPath, io::FileMode::READ, &mmap));
+      source = mmap;
+    } else {
+      std::shared_ptr<io::ReadableFile> file;
+      ABORT_NOT_OK(io::ReadableFile::Open(kBenchmarkPath, &file));
+      source = file;
+    }
+    if (!ReadBatches(format, source).ok()) {
+      state.SkipWithError("Failed to read!");
+    }
+  }
+
+  if (source_type != kInMemory) {
+    std::remove(kBenchmarkPath);
+  }
+  static const char* kSourceNames[] = {"in-memory", "mmap", "file"};
+  std::stringstream ss;
+  ss << (format == kStreamFormat ? "stream" : "file") << " from "
+     << kSourceNames[source_type];
+  state.SetLabel(ss.str());
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer->size());
+}
+
+static void FormatArguments(benchmark::internal::Benchmark* bench) {
+  for (int num_fields : {1, 64, 1024}) {
+    for (int format : {kStreamFormat, kFileFormat}) {
+      bench->Args({num_fields, format});
+    }
+  }
+}
+
+static void SourceArguments(benchmark::internal::Benchmark* bench) {
+  for (int num_fields : {1, 64, 1024}) {
+    for (int format : {kStreamFormat, kFileFormat}) {
+      for (int source : {kInMemory, kMemoryMap, kReadableFile}) {
+        bench->Args({num_fields, format, source});
+      }
+    }
+  }
+}
+
 BENCHMARK(BM_WriteRecordBatch)
     ->RangeMultiplier(4)
     ->Range(1, 1 << 13)
@@ -128,4 +452,56 @@ BENCHMARK(BM_ReadRecordBatch)
     ->MinTime(1.0)
     ->UseRealTime();
 
+// range(0) is the number of columns, up to wide schemas
+#define BENCHMARK_BATCH_SHAPE(MakeBatch)          \
+  BENCHMARK_TEMPLATE(BM_WriteBatch, MakeBatch)    \
+      ->RangeMultiplier(8)                        \
+      ->Range(1, 1 << 12)                         \
+      ->MinTime(1.0)                              \
+      ->UseRealTime();                            \
+  BENCHMARK_TEMPLATE(BM_ReadBatch, MakeBatch)     \
+      ->RangeMultiplier(8)                        \
+      ->Range(1, 1 << 12)                         \
+      ->MinTime(1.0)                              \
+      ->UseRealTime()
+
+BENCHMARK_BATCH_SHAPE(MakeStringBatch);
+BENCHMARK_BATCH_SHAPE(MakeDictionaryBatch);
+BENCHMARK_BATCH_SHAPE(MakeSlicedBatch);
+
+// range(0) is the nesting depth
+BENCHMARK_TEMPLATE(BM_WriteBatch, MakeNestedBatch)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_ReadBatch, MakeNestedBatch)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_WriteRecordBatchMetadata)
+    ->RangeMultiplier(8)
+    ->Range(1, 1 << 15)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_ReadRecordBatchMetadata)
+    ->RangeMultiplier(8)
+    ->Range(1, 1 << 15)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_ReadSchema)
+    ->RangeMultiplier(8)
+    ->Range(1, 1 << 15)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_WriteBatches)->Apply(FormatArguments)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadBatches)->Apply(SourceArguments)->MinTime(1.0)->UseRealTime();
+
 }  // namespace arrow
@@ -15,9 +15,12 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +31,7 @@
 #include "arrow/buffer.h"
 #include "arrow/io/memory.h"
 #include "arrow/io/test-common.h"
+#include "arrow/ipc/Message_generated.h"
 #include "arrow/ipc/api.h"
 #include "arrow/ipc/metadata-internal.h"
 #include "arrow/ipc/test-common.h"
@@ -388,6 +392,99 @@ TEST_F(TestWriteRecordBatch, IntegerGetRecordBatchSize) {
   TestGetRecordBatchSize(batch);
 }
 
+TEST_F(TestWriteRecordBatch, SerializeIntoRegion) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeListRecordBatch(&batch));
+  int64_t size = 0;
+  ASSERT_OK(GetRecordBatchSize(*batch, &size));
+
+  std::shared_ptr<Buffer> region;
+  ASSERT_OK(AllocateBuffer(pool_, size + 100, &region));
+  int64_t message_length = 0;
+  ASSERT_OK(SerializeRecordBatch(*batch, pool_, region, 4, &message_length));
+  ASSERT_EQ(size, message_length);
+
+  io::BufferReader reader(SliceBuffer(region, 0, message_length));
+  std::shared_ptr<RecordBatch> result;
+  ASSERT_OK(ReadRecordBatch(batch->schema(), &reader, &result));
+  ASSERT_TRUE(batch->Equals(*result));
+
+  std::shared_ptr<Buffer> small_region;
+  ASSERT_OK(AllocateBuffer(pool_, size - 8, &small_region));
+  ASSERT_RAISES(Invalid,
+                SerializeRecordBatch(*batch, pool_, small_region, 1, &message_length));
+}
+
+TEST_F(TestWriteRecordBatch, RegionWriter) {
+  std::shared_ptr<Buffer> region;
+  ASSERT_OK(AllocateBuffer(pool_, 1 << 16, &region));
+  std::unique_ptr<RecordBatchRegionWriter> writer;
+  ASSERT_OK(RecordBatchRegionWriter::Open(region, 512, &writer));
+
+  // Build some columns in the region
+  Int64Builder int_builder(writer->pool());
+  StringBuilder string_builder(writer->pool());
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_OK(int_builder.Append(i));
+    if (i % 3 == 0) {
+      ASSERT_OK(string_builder.AppendNull());
+    } else {
+      ASSERT_OK(string_builder.Append(std::to_string(i)));
+    }
+  }
+  std::shared_ptr<Array> ints, strings;
+  ASSERT_OK(int_builder.Finish(&ints));
+  ASSERT_OK(string_builder.Finish(&strings));
+  const uint8_t* int_values = ints->data()->buffers[1]->data();
+  ASSERT_GE(int_values, region->data() + 512);
+  ASSERT_LT(int_values, region->data() + region->size());
+
+  // One column from elsewhere, sliced, which is copied
+  std::shared_ptr<RecordBatch> other;
+  ASSERT_OK(MakeIntBatchSized(1010, &other));
+  auto copied = other->column(0)->Slice(3, 1000);
+
+  auto schema = ::arrow::schema({field("ints", int64()), field("strings", utf8()),
+                                 field("copied", copied->type())});
+  RecordBatch batch(schema, 1000, {ints, strings, copied});
+  int64_t message_length = 0;
+  ASSERT_OK(writer->WriteRecordBatch(batch, &message_length));
+  ASSERT_LE(message_length, region->size());
+  ASSERT_RAISES(Invalid, writer->WriteRecordBatch(batch, &message_length));
+  uint8_t* unused;
+  ASSERT_RAISES(Invalid, writer->pool()->Allocate(64, &unused));
+
+  // The message reads zero-copy from the buffers that were built in place
+  io::BufferReader reader(SliceBuffer(region, 0, message_length));
+  std::shared_ptr<RecordBatch> result;
+  ASSERT_OK(ReadRecordBatch(schema, &reader, &result));
+  ASSERT_TRUE(batch.Equals(*result));
+  ASSERT_EQ(int_values, result->column(0)->data()->buffers[1]->data());
+}
+
+TEST_F(TestWriteRecordBatch, RegionWriterLimits) {
+  std::shared_ptr<Buffer> region;
+  ASSERT_OK(AllocateBuffer(pool_, 1024, &region));
+  std::unique_ptr<RecordBatchRegionWriter> writer;
+  ASSERT_RAISES(Invalid, RecordBatchRegionWriter::Open(region, 12, &writer));
+  ASSERT_RAISES(Invalid, RecordBatchRegionWriter::Open(region, 1024, &writer));
+  ASSERT_RAISES(Invalid, RecordBatchRegionWriter::Open(
+                             std::make_shared<Buffer>(region->data(), region->size()),
+                             64, &writer));
+
+  // The body is full
+  ASSERT_OK(RecordBatchRegionWriter::Open(region, 64, &writer));
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_RAISES(OutOfMemory, AllocateBuffer(writer->pool(), 2048, &buffer));
+
+  // The metadata does not fit
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntRecordBatch(&batch));
+  ASSERT_OK(RecordBatchRegionWriter::Open(region, 8, &writer));
+  int64_t message_length = 0;
+  ASSERT_RAISES(Invalid, writer->WriteRecordBatch(*batch->Slice(0, 2), &message_length));
+}
+
 class RecursionLimits : public ::testing::Test, public io::MemoryMapFixture {
  public:
   void SetUp() { pool_ = default_memory_pool(); }
@@ -498,14 +595,13 @@ class TestFileFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
   }
   void TearDown() {}
 
-  Status RoundTripHelper(const BatchVector& in_batches, BatchVector* out_batches) {
+  Status WriteAndOpen(const BatchVector& in_batches, const IpcReadOptions& options,
+                      std::shared_ptr<RecordBatchFileReader>* reader) {
     // Write the file
     std::shared_ptr<RecordBatchWriter> writer;
     RETURN_NOT_OK(
         RecordBatchFileWriter::Open(sink_.get(), in_batches[0]->schema(), &writer));
 
-    const int num_batches = static_cast<int>(in_batches.size());
-
     for (const auto& batch : in_batches) {
       RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
     }
@@ -517,9 +613,16 @@ class TestFileFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
     RETURN_NOT_OK(sink_->Tell(&footer_offset));
 
     // Open the file
-    auto buf_reader = std::make_shared<io::BufferReader>(buffer_);
+    buf_reader_ = std::make_shared<io::BufferReader>(buffer_);
+    return RecordBatchFileReader::Open(buf_reader_.get(), footer_offset, options, reader);
+  }
+
+  Status RoundTripHelper(const BatchVector& in_batches, BatchVector* out_batches,
+                         const IpcReadOptions& options = IpcReadOptions::Defaults()) {
+    const int num_batches = static_cast<int>(in_batches.size());
+
     std::shared_ptr<RecordBatchFileReader> reader;
-    RETURN_NOT_OK(RecordBatchFileReader::Open(buf_reader.get(), footer_offset, &reader));
+    RETURN_NOT_OK(WriteAndOpen(in_batches, options, &reader));
 
     EXPECT_EQ(num_batches, reader->num_record_batches());
     for (int i = 0; i < num_batches; ++i) {
@@ -536,6 +639,7 @@ class TestFileFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
 
   std::unique_ptr<io::BufferOutputStream> sink_;
   std::shared_ptr<PoolBuffer> buffer_;
+  std::shared_ptr<io::BufferReader> buf_reader_;
 };
 
 TEST_P(TestFileFormat, RoundTrip) {
@@ -564,7 +668,8 @@ class TestStreamFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
   }
   void TearDown() {}
 
-  Status RoundTripHelper(const BatchVector& batches, BatchVector* out_batches) {
+  Status RoundTripHelper(const BatchVector& batches, BatchVector* out_batches,
+                         const IpcReadOptions& options = IpcReadOptions::Defaults()) {
     // Write the file
     std::shared_ptr<RecordBatchWriter> writer;
     RETURN_NOT_OK(
@@ -580,7 +685,10 @@ class TestStreamFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
     io::BufferReader buf_reader(buffer_);
 
     std::shared_ptr<RecordBatchReader> reader;
-    RETURN_NOT_OK(RecordBatchStreamReader::Open(&buf_reader, &reader));
+    std::unique_ptr<MessageReader> message_reader(
+        new InputStreamMessageReader(&buf_reader));
+    RETURN_NOT_OK(
+        RecordBatchStreamReader::Open(std::move(message_reader), options, &reader));
 
     std::shared_ptr<RecordBatch> chunk;
     while (true) {
@@ -614,6 +722,200 @@ TEST_P(TestStreamFormat, RoundTrip) {
   }
 }
 
+// Select every other field, starting from the last one, so that the first
+// field is skipped whenever there is more than one
+static IpcReadOptions ProjectionOptions(const Schema& schema) {
+  IpcReadOptions options;
+  for (int i = schema.num_fields() - 1; i >= 0; i -= 2) {
+    options.included_fields.push_back(i);
+  }
+  return options;
+}
+
+static std::shared_ptr<RecordBatch> ProjectBatch(const RecordBatch& batch,
+                                                 const IpcReadOptions& options) {
+  std::vector<std::shared_ptr<Field>> fields;
+  std::vector<std::shared_ptr<Array>> columns;
+  for (int i = 0; i < batch.num_columns(); ++i) {
+    const auto& included = options.included_fields;
+    if (std::find(included.begin(), included.end(), i) != included.end()) {
+      fields.push_back(batch.schema()->field(i));
+      columns.push_back(batch.column(i));
+    }
+  }
+  return std::make_shared<RecordBatch>(
+      std::make_shared<Schema>(fields, batch.schema()->metadata()), batch.num_rows(),
+      columns);
+}
+
+TEST_P(TestFileFormat, FieldProjection) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK((*GetParam())(&batch));  // NOLINT clang-tidy gtest issue
+
+  IpcReadOptions options = ProjectionOptions(*batch->schema());
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({batch, batch}, &out_batches, options));
+
+  auto expected = ProjectBatch(*batch, options);
+  for (const auto& out_batch : out_batches) {
+    CompareBatch(*expected, *out_batch);
+  }
+}
+
+TEST_P(TestStreamFormat, FieldProjection) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK((*GetParam())(&batch));  // NOLINT clang-tidy gtest issue
+
+  IpcReadOptions options = ProjectionOptions(*batch->schema());
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({batch, batch}, &out_batches, options));
+
+  auto expected = ProjectBatch(*batch, options);
+  for (const auto& out_batch : out_batches) {
+    CompareBatch(*expected, *out_batch);
+  }
+}
+
+TEST_P(TestFileFormat, ReadTable) {
+  std::shared_ptr<RecordBatch> batch1;
+  std::shared_ptr<RecordBatch> batch2;
+  ASSERT_OK((*GetParam())(&batch1));  // NOLINT clang-tidy gtest issue
+  ASSERT_OK((*GetParam())(&batch2));  // NOLINT clang-tidy gtest issue
+  BatchVector in_batches = {batch1, batch2, batch1, batch2, batch1};
+
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(WriteAndOpen(in_batches, IpcReadOptions::Defaults(), &reader));
+
+  for (int nthreads : {1, 2, 8}) {
+    std::shared_ptr<Table> table;
+    ASSERT_OK(reader->ReadTable(nthreads, &table));
+    ASSERT_EQ(reader->num_record_batches() * batch1->num_rows(), table->num_rows());
+    ASSERT_EQ(batch1->num_columns(), table->num_columns());
+    for (int i = 0; i < table->num_columns(); ++i) {
+      const auto& chunks = table->column(i)->data()->chunks();
+      ASSERT_EQ(in_batches.size(), chunks.size());
+      for (size_t j = 0; j < chunks.size(); ++j) {
+        ASSERT_TRUE(in_batches[j]->column(i)->Equals(chunks[j]));
+      }
+    }
+  }
+
+  std::shared_ptr<Table> table;
+  ASSERT_RAISES(Invalid, reader->ReadTable(0, &table));
+}
+
+// A file without zero-copy reads that counts the ReadAt calls and the bytes
+// they read
+class CopyingReader : public io::RandomAccessFile {
+ public:
+  explicit CopyingReader(const std::shared_ptr<Buffer>& buffer)
+      : reader_(buffer), num_reads_(0), num_bytes_read_(0) {}
+
+  Status Close() override { return reader_.Close(); }
+  Status Tell(int64_t* position) const override { return reader_.Tell(position); }
+  Status Seek(int64_t position) override { return reader_.Seek(position); }
+  Status GetSize(int64_t* size) override { return reader_.GetSize(size); }
+  bool supports_zero_copy() const override { return false; }
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override {
+    return reader_.Read(nbytes, bytes_read, out);
+  }
+
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override {
+    std::shared_ptr<Buffer> data;
+    RETURN_NOT_OK(reader_.Read(nbytes, &data));
+    return data->Copy(0, data->size(), out);
+  }
+
+  Status ReadAt(int64_t position, int64_t nbytes, int64_t* bytes_read,
+                uint8_t* out) override {
+    ++num_reads_;
+    RETURN_NOT_OK(reader_.ReadAt(position, nbytes, bytes_read, out));
+    num_bytes_read_ += *bytes_read;
+    return Status::OK();
+  }
+
+  Status ReadAt(int64_t position, int64_t nbytes,
+                std::shared_ptr<Buffer>* out) override {
+    ++num_reads_;
+    std::shared_ptr<Buffer> data;
+    RETURN_NOT_OK(reader_.ReadAt(position, nbytes, &data));
+    num_bytes_read_ += data->size();
+    return data->Copy(0, data->size(), out);
+  }
+
+  int num_reads() const { return num_reads_; }
+  int64_t num_bytes_read() const { return num_bytes_read_; }
+  void reset_num_reads() {
+    num_reads_ = 0;
+    num_bytes_read_ = 0;
+  }
+
+ private:
+  io::BufferReader reader_;
+  std::atomic<int> num_reads_;
+  std::atomic<int64_t> num_bytes_read_;
+};
+
+TEST_P(TestFileFormat, FieldProjectionCoalescedReads) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK((*GetParam())(&batch));  // NOLINT clang-tidy gtest issue
+
+  IpcReadOptions options = ProjectionOptions(*batch->schema());
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(WriteAndOpen({batch, batch}, options, &reader));
+
+  CappedMemoryPool pool(default_memory_pool(), "ipc read",
+                        std::numeric_limits<int64_t>::max());
+  options.memory_pool = &pool;
+  auto file = std::make_shared<CopyingReader>(buffer_);
+  ASSERT_OK(RecordBatchFileReader::Open(file, options, &reader));
+
+  auto expected = ProjectBatch(*batch, options);
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    file->reset_num_reads();
+    std::shared_ptr<RecordBatch> out_batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &out_batch));
+    CompareBatch(*expected, *out_batch);
+
+    // The metadata, then the buffers of all selected fields at once
+    ASSERT_LE(file->num_reads(), 2);
+  }
+  // The buffers were read into memory from the pool of the options
+  if (expected->num_rows() > 0 && expected->num_columns() > 0) {
+    ASSERT_GT(pool.stats().num_allocations, 0);
+  }
+
+  // ReadTable reads no more than the batches read one by one
+  file->reset_num_reads();
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<RecordBatch> out_batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &out_batch));
+  }
+  const int64_t num_bytes_read = file->num_bytes_read();
+  file->reset_num_reads();
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader->ReadTable(2, &table));
+  ASSERT_EQ(num_bytes_read, file->num_bytes_read());
+  ASSERT_EQ(expected->num_columns(), table->num_columns());
+  ASSERT_EQ(2 * expected->num_rows(), table->num_rows());
+  for (int i = 0; i < table->num_columns(); ++i) {
+    for (const auto& chunk : table->column(i)->data()->chunks()) {
+      ASSERT_TRUE(expected->column(i)->Equals(chunk));
+    }
+  }
+}
+
+TEST_F(TestFileFormat, FieldProjectionOutOfBounds) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntRecordBatch(&batch));
+
+  IpcReadOptions options;
+  options.included_fields = {batch->num_columns()};
+  BatchVector out_batches;
+  ASSERT_RAISES(Invalid, RoundTripHelper({batch}, &out_batches, options));
+}
+
 INSTANTIATE_TEST_CASE_P(GenericIpcRoundTripTests, TestIpcRoundTrip, BATCH_CASES());
 INSTANTIATE_TEST_CASE_P(FileRoundTripTests, TestFileFormat, BATCH_CASES());
 INSTANTIATE_TEST_CASE_P(StreamRoundTripTests, TestStreamFormat, BATCH_CASES());
@@ -686,6 +988,178 @@ TEST_F(TestStreamFormat, WriteTable) {
   ASSERT_TRUE(b3->Equals(*out_batches[2]));
 }
 
+TEST_F(TestStreamFormat, RecycledBuffers) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntRecordBatch(&batch));
+
+  std::shared_ptr<RecordBatchWriter> writer;
+  ASSERT_OK(RecordBatchStreamWriter::Open(sink_.get(), batch->schema(), &writer));
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(writer->WriteRecordBatch(*batch));
+  }
+  ASSERT_OK(writer->Close());
+  ASSERT_OK(sink_->Close());
+
+  IpcReadOptions options;
+  options.buffer_pool = std::make_shared<RecyclingBufferPool>(pool_);
+  std::shared_ptr<RecordBatchReader> reader;
+  ASSERT_OK(RecordBatchStreamReader::Open(std::make_shared<io::BufferReader>(buffer_),
+                                          options, &reader));
+
+  std::shared_ptr<RecordBatch> out;
+  ASSERT_OK(reader->ReadNext(&out));
+  ASSERT_TRUE(batch->Equals(*out));
+  const uint8_t* values = out->column(0)->data()->buffers[1]->data();
+  ASSERT_EQ(0, options.buffer_pool->num_cached_buffers());
+
+  // Releasing the batch gives its buffer back, which the next batch reuses
+  out.reset();
+  ASSERT_EQ(1, options.buffer_pool->num_cached_buffers());
+  ASSERT_OK(reader->ReadNext(&out));
+  ASSERT_TRUE(batch->Equals(*out));
+  ASSERT_EQ(values, out->column(0)->data()->buffers[1]->data());
+  ASSERT_EQ(0, options.buffer_pool->num_cached_buffers());
+
+  // While a batch is held, the next one gets a buffer of its own
+  std::shared_ptr<RecordBatch> next;
+  ASSERT_OK(reader->ReadNext(&next));
+  ASSERT_TRUE(batch->Equals(*next));
+  ASSERT_NE(values, next->column(0)->data()->buffers[1]->data());
+
+  ASSERT_OK(reader->ReadNext(&next));
+  ASSERT_EQ(nullptr, next);
+}
+
+TEST_F(TestStreamFormat, StreamIndex) {
+  std::shared_ptr<RecordBatch> b1, b2, b3;
+  ASSERT_OK(MakeIntBatchSized(10, &b1));
+  ASSERT_OK(MakeIntBatchSized(0, &b2));
+  ASSERT_OK(MakeIntBatchSized(7, &b3));
+  BatchVector in_batches = {b1, b2, b3, b1};
+
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper(in_batches, &out_batches));
+
+  // Index the stream while the last batch is still being written
+  auto partial = std::make_shared<io::BufferReader>(
+      SliceBuffer(buffer_, 0, buffer_->size() - sizeof(int32_t) - 8));
+  std::shared_ptr<StreamIndex> index;
+  ASSERT_OK(StreamIndex::Build(partial.get(), &index));
+  ASSERT_EQ(3, index->num_record_batches());
+  ASSERT_EQ(17, index->num_rows());
+  ASSERT_FALSE(index->complete());
+
+  auto stream = std::make_shared<io::BufferReader>(buffer_);
+  ASSERT_OK(index->Update(stream.get()));
+  ASSERT_EQ(4, index->num_record_batches());
+  ASSERT_EQ(27, index->num_rows());
+  ASSERT_TRUE(index->complete());
+  ASSERT_EQ(buffer_->size(), index->indexed_length());
+
+  int batch_index;
+  int64_t batch_row;
+  ASSERT_OK(index->FindRow(10, &batch_index, &batch_row));
+  ASSERT_EQ(2, batch_index);
+  ASSERT_EQ(0, batch_row);
+  ASSERT_OK(index->FindRow(26, &batch_index, &batch_row));
+  ASSERT_EQ(3, batch_index);
+  ASSERT_EQ(9, batch_row);
+  ASSERT_RAISES(Invalid, index->FindRow(27, &batch_index, &batch_row));
+
+  // Save the index and read it back
+  auto index_buffer = std::make_shared<PoolBuffer>(pool_);
+  io::BufferOutputStream index_sink(index_buffer);
+  ASSERT_OK(index->WriteTo(&index_sink));
+  ASSERT_OK(index_sink.Close());
+  std::shared_ptr<StreamIndex> read_index;
+  ASSERT_OK(StreamIndex::ReadFrom(std::make_shared<io::BufferReader>(index_buffer),
+                                  &read_index));
+  ASSERT_EQ(index->messages().size(), read_index->messages().size());
+  ASSERT_EQ(index->num_rows(), read_index->num_rows());
+  ASSERT_EQ(index->indexed_length(), read_index->indexed_length());
+  ASSERT_TRUE(read_index->complete());
+
+  std::shared_ptr<IndexedStreamReader> reader;
+  ASSERT_OK(IndexedStreamReader::Open(stream, read_index, &reader));
+  ASSERT_TRUE(reader->schema()->Equals(*b1->schema()));
+  for (int i = reader->num_record_batches() - 1; i >= 0; --i) {
+    std::shared_ptr<RecordBatch> batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &batch));
+    CompareBatch(*in_batches[i], *batch);
+  }
+
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(reader->ReadRecordBatchForRow(12, &batch, &batch_row));
+  CompareBatch(*b3, *batch);
+  ASSERT_EQ(2, batch_row);
+}
+
+// A batch with a single dictionary-encoded string column
+std::shared_ptr<RecordBatch> MakeStringDictionaryBatch(
+    const std::vector<std::string>& dictionary_values,
+    const std::vector<int32_t>& indices) {
+  std::shared_ptr<Array> dictionary, index_array;
+  ArrayFromVector<StringType, std::string>(dictionary_values, &dictionary);
+  ArrayFromVector<Int32Type, int32_t>(indices, &index_array);
+
+  auto type = ::arrow::dictionary(int32(), dictionary);
+  std::vector<std::shared_ptr<Array>> columns = {
+      std::make_shared<DictionaryArray>(type, index_array)};
+  return std::make_shared<RecordBatch>(::arrow::schema({field("f0", type)}),
+                                       static_cast<int64_t>(indices.size()), columns);
+}
+
+TEST_F(TestStreamFormat, DictionaryDeltaAndReplacement) {
+  auto b1 = MakeStringDictionaryBatch({"a", "b"}, {0, 1, 0});
+  // Extends the dictionary of b1
+  auto b2 = MakeStringDictionaryBatch({"a", "b", "c", "d"}, {2, 3, 1});
+  // Equal to the dictionary of b2
+  auto b3 = MakeStringDictionaryBatch({"a", "b", "c", "d"}, {0});
+  // Replaces the dictionary
+  auto b4 = MakeStringDictionaryBatch({"x", "y"}, {1, 0});
+  BatchVector in_batches = {b1, b2, b3, b4, b1};
+
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper(in_batches, &out_batches));
+  ASSERT_EQ(in_batches.size(), out_batches.size());
+  for (size_t i = 0; i < in_batches.size(); ++i) {
+    CompareBatch(*in_batches[i], *out_batches[i]);
+  }
+
+  // Only the new entries are sent for b2, nothing for b3
+  auto stream = std::make_shared<io::BufferReader>(buffer_);
+  std::shared_ptr<StreamIndex> index;
+  ASSERT_OK(StreamIndex::Build(stream.get(), &index));
+  std::vector<Message::Type> types;
+  for (const StreamIndexEntry& entry : index->messages()) {
+    types.push_back(entry.type);
+  }
+  const Message::Type kDictionary = Message::DICTIONARY_BATCH;
+  const Message::Type kBatch = Message::RECORD_BATCH;
+  std::vector<Message::Type> expected_types = {Message::SCHEMA, kDictionary, kBatch,
+                                               kDictionary,     kBatch,      kBatch,
+                                               kDictionary,     kBatch,      kDictionary,
+                                               kBatch};
+  ASSERT_EQ(expected_types, types);
+
+  std::unique_ptr<Message> delta;
+  ASSERT_OK(ReadMessage(index->messages()[3].offset, index->messages()[3].metadata_length,
+                        stream.get(), &delta));
+  auto delta_batch = static_cast<const flatbuf::DictionaryBatch*>(delta->header());
+  ASSERT_TRUE(delta_batch->isDelta());
+  ASSERT_EQ(2, delta_batch->data()->length());
+
+  // Batches after the changes are read with the dictionaries they were
+  // written with
+  std::shared_ptr<IndexedStreamReader> reader;
+  ASSERT_OK(IndexedStreamReader::Open(stream, index, &reader));
+  for (int i = reader->num_record_batches() - 1; i >= 0; --i) {
+    std::shared_ptr<RecordBatch> batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &batch));
+    CompareBatch(*in_batches[i], *batch);
+  }
+}
+
 TEST_F(TestFileFormat, DictionaryRoundTrip) {
   std::shared_ptr<RecordBatch> batch;
   ASSERT_OK(MakeDictionary(&batch));
@@ -696,6 +1170,252 @@ TEST_F(TestFileFormat, DictionaryRoundTrip) {
   CheckBatchDictionaries(*out_batches[0]);
 }
 
+TEST_F(TestFileFormat, Append) {
+  std::shared_ptr<RecordBatch> batch1, batch2;
+  ASSERT_OK(MakeDictionary(&batch1));
+  ASSERT_OK(MakeDictionary(&batch2));
+
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({batch1}, &out_batches));
+  const int64_t original_size = buffer_->size();
+
+  // Copy the file to a new sink and continue writing there
+  auto appended = std::make_shared<PoolBuffer>(pool_);
+  io::BufferOutputStream sink(appended);
+  ASSERT_OK(sink.Write(buffer_->data(), original_size));
+
+  io::BufferReader original(buffer_);
+  std::shared_ptr<RecordBatchWriter> writer;
+  ASSERT_OK(RecordBatchFileWriter::OpenForAppend(&original, &sink, &writer));
+  ASSERT_OK(writer->WriteRecordBatch(*batch2));
+  ASSERT_OK(writer->WriteRecordBatch(*batch1));
+
+  // Batches with another schema are rejected
+  std::shared_ptr<RecordBatch> int_batch;
+  ASSERT_OK(MakeIntRecordBatch(&int_batch));
+  ASSERT_RAISES(Invalid, writer->WriteRecordBatch(*int_batch));
+
+  // Before the new footer is written, the original file is still readable
+  io::BufferReader partial(appended);
+  int64_t footer_offset;
+  ASSERT_OK(RecordBatchFileReader::FindFooterOffset(&partial, &footer_offset));
+  ASSERT_EQ(original_size, footer_offset);
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(RecordBatchFileReader::Open(&partial, footer_offset, &reader));
+  ASSERT_EQ(1, reader->num_record_batches());
+
+  ASSERT_OK(writer->Close());
+  ASSERT_OK(sink.Close());
+
+  // So is it if the new footer is incomplete
+  io::BufferReader truncated(SliceBuffer(appended, 0, appended->size() - 1));
+  ASSERT_OK(RecordBatchFileReader::FindFooterOffset(&truncated, &footer_offset));
+  ASSERT_EQ(original_size, footer_offset);
+
+  io::BufferReader result(appended);
+  ASSERT_OK(RecordBatchFileReader::FindFooterOffset(&result, &footer_offset));
+  ASSERT_EQ(appended->size(), footer_offset);
+  ASSERT_OK(RecordBatchFileReader::Open(&result, footer_offset, &reader));
+  ASSERT_EQ(3, reader->num_record_batches());
+  BatchVector expected = {batch1, batch2, batch1};
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<RecordBatch> batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &batch));
+    CompareBatch(*expected[i], *batch);
+    CheckBatchDictionaries(*batch);
+  }
+
+  // Without the original footer there is nothing to recover
+  io::BufferReader body(SliceBuffer(appended, 0, original_size - 1));
+  ASSERT_RAISES(Invalid, RecordBatchFileReader::FindFooterOffset(&body, &footer_offset));
+}
+
+TEST_F(TestFileFormat, AppendDictionaryDelta) {
+  auto b1 = MakeStringDictionaryBatch({"a", "b"}, {0, 1, 0});
+  auto b2 = MakeStringDictionaryBatch({"a", "b", "c"}, {2, 1});
+  auto b3 = MakeStringDictionaryBatch({"a", "b", "c", "d"}, {3, 0});
+
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({b1}, &out_batches));
+  std::shared_ptr<Buffer> file = buffer_;
+
+  // Append twice, each time extending the dictionary of the file
+  for (const auto& batch : {b2, b3}) {
+    auto appended = std::make_shared<PoolBuffer>(pool_);
+    io::BufferOutputStream sink(appended);
+    ASSERT_OK(sink.Write(file->data(), file->size()));
+    io::BufferReader source(file);
+    std::shared_ptr<RecordBatchWriter> writer;
+    ASSERT_OK(RecordBatchFileWriter::OpenForAppend(&source, &sink, &writer));
+    ASSERT_OK(writer->WriteRecordBatch(*batch));
+    // A dictionary that does not extend the one of the file
+    auto replaced = MakeStringDictionaryBatch({"x", "y"}, {1, 0});
+    ASSERT_RAISES(Invalid, writer->WriteRecordBatch(*replaced));
+    ASSERT_OK(writer->Close());
+    ASSERT_OK(sink.Close());
+    file = appended;
+  }
+
+  io::BufferReader source(file);
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(RecordBatchFileReader::Open(&source, &reader));
+  ASSERT_EQ(3, reader->num_record_batches());
+  // The dictionaries of the file apply to all its batches
+  BatchVector expected = {MakeStringDictionaryBatch({"a", "b", "c", "d"}, {0, 1, 0}),
+                          MakeStringDictionaryBatch({"a", "b", "c", "d"}, {2, 1}), b3};
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<RecordBatch> batch;
+    ASSERT_OK(reader->ReadRecordBatch(i, &batch));
+    CompareBatch(*expected[i], *batch);
+  }
+}
+
+TEST_F(TestFileFormat, DictionaryDelta) {
+  auto b1 = MakeStringDictionaryBatch({"a", "b"}, {0, 1, 0});
+  auto b2 = MakeStringDictionaryBatch({"a", "b", "c", "d"}, {2, 3, 1});
+
+  // The dictionaries of the file apply to all its batches
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({b1, b2}, &out_batches));
+  CompareBatch(*MakeStringDictionaryBatch({"a", "b", "c", "d"}, {0, 1, 0}),
+               *out_batches[0]);
+  CompareBatch(*b2, *out_batches[1]);
+
+  // Dictionaries cannot be replaced
+  std::shared_ptr<RecordBatchWriter> writer;
+  io::BufferOutputStream sink(std::make_shared<PoolBuffer>(pool_));
+  ASSERT_OK(RecordBatchFileWriter::Open(&sink, b1->schema(), &writer));
+  ASSERT_OK(writer->WriteRecordBatch(*b1));
+  auto replaced = MakeStringDictionaryBatch({"x", "y"}, {1, 0});
+  ASSERT_RAISES(Invalid, writer->WriteRecordBatch(*replaced));
+}
+
+// A batch of 10 consecutive int64 values starting at start
+std::shared_ptr<RecordBatch> MakeSequenceBatch(int64_t start) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 10; ++i) {
+    values.push_back(start + i);
+  }
+  std::shared_ptr<Array> column;
+  ArrayFromVector<Int64Type, int64_t>(values, &column);
+  std::vector<std::shared_ptr<Array>> columns = {column};
+  return std::make_shared<RecordBatch>(::arrow::schema({field("time", int64())}), 10,
+                                       columns);
+}
+
+std::shared_ptr<Array> MakeInt64Value(int64_t value) {
+  std::shared_ptr<Array> out;
+  ArrayFromVector<Int64Type, int64_t>({value}, &out);
+  return out;
+}
+
+TEST_F(TestFileFormat, Statistics) {
+  BatchVector batches = {MakeSequenceBatch(0), MakeSequenceBatch(10),
+                         MakeSequenceBatch(20)};
+  IpcWriteOptions options;
+  options.write_statistics = true;
+  std::shared_ptr<RecordBatchWriter> writer;
+  ASSERT_OK(RecordBatchFileWriter::Open(sink_.get(), batches[0]->schema(), options,
+                                        &writer));
+  for (const auto& batch : batches) {
+    ASSERT_OK(writer->WriteRecordBatch(*batch));
+  }
+  ASSERT_OK(writer->Close());
+  ASSERT_OK(sink_->Close());
+
+  io::BufferReader source(buffer_);
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(RecordBatchFileReader::Open(&source, &reader));
+  ASSERT_TRUE(reader->has_statistics());
+  ASSERT_EQ(3, reader->num_record_batches());
+
+  std::vector<RecordBatchStatistics> statistics;
+  ASSERT_OK(reader->ReadStatistics(&statistics));
+  ASSERT_EQ(3, statistics.size());
+  ASSERT_TRUE(statistics[1][0].min->Equals(MakeInt64Value(10)));
+  ASSERT_TRUE(statistics[1][0].max->Equals(MakeInt64Value(19)));
+  ASSERT_EQ(10, statistics[1][0].distinct_count);
+
+  std::vector<int> selected;
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(15), MakeInt64Value(22)}},
+                                        &selected));
+  ASSERT_EQ(std::vector<int>({1, 2}), selected);
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(30), nullptr}}, &selected));
+  ASSERT_EQ(std::vector<int>(), selected);
+
+  // Appending keeps the statistics
+  auto appended = std::make_shared<PoolBuffer>(pool_);
+  io::BufferOutputStream sink(appended);
+  ASSERT_OK(sink.Write(buffer_->data(), buffer_->size()));
+  ASSERT_OK(RecordBatchFileWriter::OpenForAppend(&source, &sink, &writer));
+  ASSERT_OK(writer->WriteRecordBatch(*MakeSequenceBatch(30)));
+  ASSERT_OK(writer->Close());
+  ASSERT_OK(sink.Close());
+
+  io::BufferReader appended_source(appended);
+  ASSERT_OK(RecordBatchFileReader::Open(&appended_source, &reader));
+  ASSERT_TRUE(reader->has_statistics());
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(5), MakeInt64Value(35)}},
+                                        &selected));
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), selected);
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(35), nullptr}}, &selected));
+  ASSERT_EQ(std::vector<int>({3}), selected);
+}
+
+TEST_F(TestFileFormat, StatisticsWithFieldProjection) {
+  // The second column counts down, so the columns select different batches
+  BatchVector batches;
+  for (int64_t start : {0, 10, 20}) {
+    auto time = MakeSequenceBatch(start)->column(0);
+    auto countdown = MakeSequenceBatch(-start - 9)->column(0);
+    batches.push_back(std::make_shared<RecordBatch>(
+        ::arrow::schema({field("time", int64()), field("countdown", int64())}), 10,
+        std::vector<std::shared_ptr<Array>>{time, countdown}));
+  }
+  IpcWriteOptions write_options;
+  write_options.write_statistics = true;
+  std::shared_ptr<RecordBatchWriter> writer;
+  ASSERT_OK(RecordBatchFileWriter::Open(sink_.get(), batches[0]->schema(),
+                                        write_options, &writer));
+  for (const auto& batch : batches) {
+    ASSERT_OK(writer->WriteRecordBatch(*batch));
+  }
+  ASSERT_OK(writer->Close());
+  ASSERT_OK(sink_->Close());
+
+  IpcReadOptions options;
+  options.included_fields = {1};
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(RecordBatchFileReader::Open(std::make_shared<io::BufferReader>(buffer_),
+                                        options, &reader));
+  ASSERT_EQ(1, reader->schema()->num_fields());
+
+  // The ranges are on the columns of the projected schema
+  std::vector<int> selected;
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(-15), MakeInt64Value(-12)}},
+                                        &selected));
+  ASSERT_EQ(std::vector<int>({1}), selected);
+  ASSERT_RAISES(Invalid, reader->SelectRecordBatches(
+                             {{1, MakeInt64Value(0), nullptr}}, &selected));
+}
+
+TEST_F(TestFileFormat, NoStatistics) {
+  BatchVector out_batches;
+  ASSERT_OK(RoundTripHelper({MakeSequenceBatch(0), MakeSequenceBatch(10)}, &out_batches));
+
+  io::BufferReader source(buffer_);
+  std::shared_ptr<RecordBatchFileReader> reader;
+  ASSERT_OK(RecordBatchFileReader::Open(&source, &reader));
+  ASSERT_FALSE(reader->has_statistics());
+  std::vector<RecordBatchStatistics> statistics;
+  ASSERT_RAISES(Invalid, reader->ReadStatistics(&statistics));
+
+  // All batches must be read
+  std::vector<int> selected;
+  ASSERT_OK(reader->SelectRecordBatches({{0, MakeInt64Value(30), nullptr}}, &selected));
+  ASSERT_EQ(std::vector<int>({0, 1}), selected);
+}
+
 class TestTensorRoundTrip : public ::testing::Test, public IpcTestFixture {
  public:
   void SetUp() { pool_ = default_memory_pool(); }
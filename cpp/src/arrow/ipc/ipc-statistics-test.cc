@@ -0,0 +1,221 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/ipc/statistics.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace ipc {
+
+template <typename TYPE, typename C_TYPE>
+std::shared_ptr<Array> ArrayOf(const std::vector<bool>& is_valid,
+                               const std::vector<C_TYPE>& values) {
+  std::shared_ptr<Array> out;
+  ArrayFromVector<TYPE, C_TYPE>(is_valid, values, &out);
+  return out;
+}
+
+template <typename TYPE, typename C_TYPE>
+std::shared_ptr<Array> MakeValue(C_TYPE value) {
+  return ArrayOf<TYPE, C_TYPE>({true}, {value});
+}
+
+template <typename TYPE, typename C_TYPE>
+void AssertValue(C_TYPE expected, const std::shared_ptr<Array>& value) {
+  ASSERT_NE(nullptr, value);
+  ASSERT_TRUE(value->Equals(MakeValue<TYPE, C_TYPE>(expected))) << value->ToString();
+}
+
+class TestStatistics : public ::testing::Test {
+ public:
+  void SetUp() {
+    auto ints =
+        ArrayOf<Int64Type, int64_t>({true, false, true, true, true}, {5, 0, -3, 12, 5});
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    auto doubles = ArrayOf<DoubleType, double>({true, true, true, false, true},
+                                               {nan, 1.5, -0.5, 0, 2.5});
+    auto strings = ArrayOf<StringType, std::string>({true, true, true, true, false},
+                                                    {"b", "ab", "abc", "b", ""});
+    auto all_null = ArrayOf<Int32Type, int32_t>({false, false, false, false, false},
+                                                {0, 0, 0, 0, 0});
+    auto bools = ArrayOf<BooleanType, bool>({true, true, true, true, true},
+                                            {true, false, true, true, false});
+    auto schema = ::arrow::schema(
+        {field("ints", int64()), field("doubles", float64()), field("strings", utf8()),
+         field("all_null", int32()), field("bools", boolean())});
+    batch_ = std::make_shared<RecordBatch>(
+        schema, 5, std::vector<std::shared_ptr<Array>>{ints, doubles, strings, all_null,
+                                                       bools});
+  }
+
+ protected:
+  std::shared_ptr<RecordBatch> batch_;
+};
+
+TEST_F(TestStatistics, Compute) {
+  RecordBatchStatistics statistics;
+  ASSERT_OK(ComputeStatistics(*batch_, default_memory_pool(), &statistics));
+  ASSERT_EQ(5, statistics.size());
+
+  ASSERT_EQ(1, statistics[0].null_count);
+  ASSERT_EQ(3, statistics[0].distinct_count);
+  AssertValue<Int64Type, int64_t>(-3, statistics[0].min);
+  AssertValue<Int64Type, int64_t>(12, statistics[0].max);
+
+  // The bounds are copies that do not keep the column alive
+  ASSERT_EQ(0, statistics[0].min->offset());
+  ASSERT_NE(batch_->column(0)->data()->buffers[1], statistics[0].min->data()->buffers[1]);
+  ASSERT_NE(batch_->column(2)->data()->buffers[2], statistics[2].max->data()->buffers[2]);
+
+  // NaN is counted as a distinct value but has no place in the ordering
+  ASSERT_EQ(1, statistics[1].null_count);
+  ASSERT_EQ(4, statistics[1].distinct_count);
+  AssertValue<DoubleType, double>(-0.5, statistics[1].min);
+  AssertValue<DoubleType, double>(2.5, statistics[1].max);
+
+  ASSERT_EQ(3, statistics[2].distinct_count);
+  AssertValue<StringType, std::string>("ab", statistics[2].min);
+  AssertValue<StringType, std::string>("b", statistics[2].max);
+
+  ASSERT_EQ(5, statistics[3].null_count);
+  ASSERT_EQ(0, statistics[3].distinct_count);
+  ASSERT_EQ(nullptr, statistics[3].min);
+  ASSERT_EQ(nullptr, statistics[3].max);
+
+  ASSERT_EQ(0, statistics[4].null_count);
+  ASSERT_EQ(-1, statistics[4].distinct_count);
+  ASSERT_EQ(nullptr, statistics[4].min);
+}
+
+TEST_F(TestStatistics, ComputeWithPool) {
+  CappedMemoryPool pool(default_memory_pool(), "statistics", 1 << 20);
+  {
+    RecordBatchStatistics statistics;
+    ASSERT_OK(ComputeStatistics(*batch_, &pool, &statistics));
+    // The minimum and maximum values are copied into the given pool
+    ASSERT_GT(pool.bytes_allocated(), 0);
+  }
+  ASSERT_EQ(0, pool.bytes_allocated());
+}
+
+TEST_F(TestStatistics, DistinctEstimate) {
+  const int64_t length = 100000;
+  std::vector<int64_t> values(length);
+  for (int64_t i = 0; i < length; ++i) {
+    // Each value twice
+    values[i] = i / 2;
+  }
+  auto column = ArrayOf<Int64Type, int64_t>(std::vector<bool>(length, true), values);
+  RecordBatch batch(::arrow::schema({field("f0", int64())}), length, {column});
+
+  RecordBatchStatistics statistics;
+  ASSERT_OK(ComputeStatistics(batch, default_memory_pool(), &statistics));
+  ASSERT_LT(std::abs(statistics[0].distinct_count - length / 2), length / 2 / 10);
+}
+
+TEST_F(TestStatistics, MayMatch) {
+  RecordBatchStatistics statistics;
+  ASSERT_OK(ComputeStatistics(*batch_, default_memory_pool(), &statistics));
+
+  auto check = [&statistics](const std::vector<ColumnRange>& ranges, bool expected) {
+    bool may_match;
+    ASSERT_OK(MayMatch(statistics, ranges, &may_match));
+    ASSERT_EQ(expected, may_match);
+  };
+  auto int_value = [](int64_t value) { return MakeValue<Int64Type, int64_t>(value); };
+
+  check({}, true);
+  check({{0, int_value(-3), int_value(12)}}, true);
+  check({{0, int_value(12), nullptr}}, true);
+  check({{0, int_value(13), nullptr}}, false);
+  check({{0, nullptr, int_value(-4)}}, false);
+  check({{0, int_value(0), int_value(1)}}, true);
+  check({{2, MakeValue<StringType, std::string>("abd"), nullptr}}, true);
+  check({{2, MakeValue<StringType, std::string>("ba"), nullptr}}, false);
+  check({{1, MakeValue<DoubleType, double>(2.5), nullptr}}, true);
+  check({{1, MakeValue<DoubleType, double>(2.6), nullptr}}, false);
+
+  // Only nulls
+  check({{3, MakeValue<Int32Type, int32_t>(0), nullptr}}, false);
+  check({{3, nullptr, nullptr}}, true);
+
+  // All ranges must be satisfiable
+  check({{0, int_value(0), nullptr}, {0, int_value(20), nullptr}}, false);
+
+  bool may_match;
+  ASSERT_RAISES(Invalid, MayMatch(statistics, {{5, int_value(0), nullptr}}, &may_match));
+  ASSERT_RAISES(Invalid, MayMatch(statistics, {{1, int_value(0), nullptr}}, &may_match));
+  ASSERT_RAISES(Invalid, MayMatch(statistics,
+                                  {{4, MakeValue<BooleanType, bool>(true), nullptr}},
+                                  &may_match));
+  auto two_values = ArrayOf<Int64Type, int64_t>({true, true}, {1, 2});
+  ASSERT_RAISES(Invalid, MayMatch(statistics, {{0, two_values, nullptr}}, &may_match));
+}
+
+TEST_F(TestStatistics, StatisticsBatch) {
+  std::vector<RecordBatchStatistics> statistics(2);
+  ASSERT_OK(ComputeStatistics(*batch_, default_memory_pool(), &statistics[0]));
+  ASSERT_OK(
+      ComputeStatistics(*batch_->Slice(2), default_memory_pool(), &statistics[1]));
+
+  std::shared_ptr<RecordBatch> statistics_batch;
+  ASSERT_OK(MakeStatisticsBatch(*batch_->schema(), statistics, default_memory_pool(),
+                                &statistics_batch));
+  ASSERT_EQ(2, statistics_batch->num_rows());
+  ASSERT_TRUE(statistics_batch->schema()->Equals(*StatisticsSchema(*batch_->schema())));
+
+  std::vector<RecordBatchStatistics> result;
+  ASSERT_OK(GetStatistics(*statistics_batch, *batch_->schema(), &result));
+  ASSERT_EQ(2, result.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    for (size_t j = 0; j < result[i].size(); ++j) {
+      const ColumnStatistics& expected = statistics[i][j];
+      const ColumnStatistics& actual = result[i][j];
+      ASSERT_EQ(expected.null_count, actual.null_count);
+      ASSERT_EQ(expected.distinct_count, actual.distinct_count);
+      ASSERT_EQ(expected.min == nullptr, actual.min == nullptr);
+      if (expected.min != nullptr) {
+        ASSERT_TRUE(expected.min->Equals(actual.min));
+        ASSERT_TRUE(expected.max->Equals(actual.max));
+      }
+    }
+  }
+  ASSERT_EQ(0, result[1][0].null_count);
+  AssertValue<StringType, std::string>("abc", result[1][2].min);
+
+  ASSERT_RAISES(Invalid, GetStatistics(*batch_, *batch_->schema(), &result));
+  ASSERT_RAISES(Invalid, MakeStatisticsBatch(*batch_->schema(), {},
+                                             default_memory_pool(), &statistics_batch));
+}
+
+}  // namespace ipc
+}  // namespace arrow
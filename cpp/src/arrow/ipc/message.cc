@@ -29,6 +29,7 @@
 #include "arrow/ipc/Schema_generated.h"
 #include "arrow/ipc/metadata-internal.h"
 #include "arrow/status.h"
+#include "arrow/util/bit-util.h"
 #include "arrow/util/logging.h"
 
 namespace arrow {
@@ -221,6 +222,11 @@ Status ReadMessage(int64_t offset, int32_t metadata_length, io::RandomAccessFile
 }
 
 Status ReadMessage(io::InputStream* file, std::unique_ptr<Message>* message) {
+  return ReadMessage(file, nullptr, message);
+}
+
+Status ReadMessage(io::InputStream* file, RecyclingBufferPool* buffer_pool,
+                   std::unique_ptr<Message>* message) {
   int32_t message_length = 0;
   int64_t bytes_read = 0;
   RETURN_NOT_OK(file->Read(sizeof(int32_t), &bytes_read,
@@ -237,20 +243,47 @@ Status ReadMessage(io::InputStream* file, std::unique_ptr<Message>* message) {
     return Status::OK();
   }
 
-  std::shared_ptr<Buffer> metadata;
-  RETURN_NOT_OK(file->Read(message_length, &metadata));
-  if (metadata->size() != message_length) {
+  if (buffer_pool == nullptr) {
+    std::shared_ptr<Buffer> metadata;
+    RETURN_NOT_OK(file->Read(message_length, &metadata));
+    if (metadata->size() != message_length) {
+      return Status::IOError("Unexpected end of stream trying to read message");
+    }
+
+    return Message::ReadFrom(metadata, file, message);
+  }
+
+  // Read the metadata into the start of the buffer, then grow it to hold the
+  // body as well. A recycled buffer usually has the capacity already
+  const int64_t body_offset = BitUtil::RoundUpToMultipleOf64(message_length);
+  std::shared_ptr<ResizableBuffer> buffer;
+  RETURN_NOT_OK(buffer_pool->Get(body_offset, &buffer));
+  RETURN_NOT_OK(file->Read(message_length, &bytes_read, buffer->mutable_data()));
+  if (bytes_read != message_length) {
     return Status::IOError("Unexpected end of stream trying to read message");
   }
 
-  return Message::ReadFrom(metadata, file, message);
+  const int64_t body_length = flatbuf::GetMessage(buffer->data())->bodyLength();
+  RETURN_NOT_OK(buffer->Resize(body_offset + body_length, false));
+  RETURN_NOT_OK(
+      file->Read(body_length, &bytes_read, buffer->mutable_data() + body_offset));
+  if (bytes_read < body_length) {
+    std::stringstream ss;
+    ss << "Expected to be able to read " << body_length << " bytes for message body, got "
+       << bytes_read;
+    return Status::IOError(ss.str());
+  }
+
+  std::shared_ptr<Buffer> base = buffer;
+  return Message::Open(SliceBuffer(base, 0, message_length),
+                       SliceBuffer(base, body_offset, body_length), message);
 }
 
 // ----------------------------------------------------------------------
 // Implement InputStream message reader
 
 Status InputStreamMessageReader::ReadNextMessage(std::unique_ptr<Message>* message) {
-  return ReadMessage(stream_, message);
+  return ReadMessage(stream_, buffer_pool_.get(), message);
 }
 
 InputStreamMessageReader::~InputStreamMessageReader() {}
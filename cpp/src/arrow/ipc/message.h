@@ -31,6 +31,7 @@
 namespace arrow {
 
 class Buffer;
+class RecyclingBufferPool;
 
 namespace io {
 
@@ -150,6 +151,17 @@ class ARROW_EXPORT InputStreamMessageReader : public MessageReader {
     owned_stream_ = owned_stream;
   }
 
+  /// \brief Read each message into a single buffer from a buffer pool
+  ///
+  /// \param[in] owned_stream the stream to read from
+  /// \param[in] buffer_pool the pool to take the buffers from; when null, the
+  /// stream allocates the buffers
+  InputStreamMessageReader(const std::shared_ptr<io::InputStream>& owned_stream,
+                           const std::shared_ptr<RecyclingBufferPool>& buffer_pool)
+      : InputStreamMessageReader(owned_stream) {
+    buffer_pool_ = buffer_pool;
+  }
+
   ~InputStreamMessageReader();
 
   Status ReadNextMessage(std::unique_ptr<Message>* message) override;
@@ -157,6 +169,7 @@ class ARROW_EXPORT InputStreamMessageReader : public MessageReader {
  private:
   io::InputStream* stream_;
   std::shared_ptr<io::InputStream> owned_stream_;
+  std::shared_ptr<RecyclingBufferPool> buffer_pool_;
 };
 
 /// \brief Read encapulated RPC message from position in file
@@ -185,6 +198,24 @@ Status ReadMessage(const int64_t offset, const int32_t metadata_length,
 ARROW_EXPORT
 Status ReadMessage(io::InputStream* stream, std::unique_ptr<Message>* message);
 
+/// \brief Read encapulated RPC message from InputStream into a buffer from a
+/// buffer pool
+///
+/// The metadata and the body share one buffer, with the body starting at a
+/// 64-byte aligned offset. The buffer goes back to the pool when the message
+/// and everything read from its body are released, so a stream of similarly
+/// sized messages reads without allocating. Returns null like the function
+/// above
+///
+/// \param[in] stream the stream to read from
+/// \param[in] buffer_pool the pool to take the buffer from; when null, the
+/// stream allocates the metadata and body buffers
+/// \param[out] message the message read
+/// \return Status
+ARROW_EXPORT
+Status ReadMessage(io::InputStream* stream, RecyclingBufferPool* buffer_pool,
+                   std::unique_ptr<Message>* message);
+
 }  // namespace ipc
 }  // namespace arrow
 
@@ -609,6 +609,20 @@ flatbuf::Endianness endianness() {
   return bint.c[0] == 1 ? flatbuf::Endianness_Big : flatbuf::Endianness_Little;
 }
 
+static flatbuffers::Offset<flatbuffers::Vector<KeyValueOffset>>
+KeyValueMetadataToFlatbuffer(FBB& fbb, const KeyValueMetadata& metadata) {
+  std::vector<KeyValueOffset> key_value_offsets;
+  size_t metadata_size = metadata.size();
+  key_value_offsets.reserve(metadata_size);
+  for (size_t i = 0; i < metadata_size; ++i) {
+    const auto& key = metadata.key(i);
+    const auto& value = metadata.value(i);
+    key_value_offsets.push_back(
+        flatbuf::CreateKeyValue(fbb, fbb.CreateString(key), fbb.CreateString(value)));
+  }
+  return fbb.CreateVector(key_value_offsets);
+}
+
 static Status SchemaToFlatbuffer(FBB& fbb, const Schema& schema,
                                  DictionaryMemo* dictionary_memo,
                                  flatbuffers::Offset<flatbuf::Schema>* out) {
@@ -626,17 +640,8 @@ static Status SchemaToFlatbuffer(FBB& fbb, const Schema& schema,
   const KeyValueMetadata* metadata = schema.metadata().get();
 
   if (metadata != nullptr) {
-    std::vector<KeyValueOffset> key_value_offsets;
-    size_t metadata_size = metadata->size();
-    key_value_offsets.reserve(metadata_size);
-    for (size_t i = 0; i < metadata_size; ++i) {
-      const auto& key = metadata->key(i);
-      const auto& value = metadata->value(i);
-      key_value_offsets.push_back(
-          flatbuf::CreateKeyValue(fbb, fbb.CreateString(key), fbb.CreateString(value)));
-    }
     *out = flatbuf::CreateSchema(fbb, endianness(), fb_offsets,
-                                 fbb.CreateVector(key_value_offsets));
+                                 KeyValueMetadataToFlatbuffer(fbb, *metadata));
   } else {
     *out = flatbuf::CreateSchema(fbb, endianness(), fb_offsets);
   }
@@ -760,14 +765,16 @@ Status WriteTensorMessage(const Tensor& tensor, int64_t buffer_start_offset,
                         body_length, out);
 }
 
-Status WriteDictionaryMessage(int64_t id, int64_t length, int64_t body_length,
+Status WriteDictionaryMessage(int64_t id, bool is_delta, int64_t length,
+                              int64_t body_length,
                               const std::vector<FieldMetadata>& nodes,
                               const std::vector<BufferMetadata>& buffers,
                               std::shared_ptr<Buffer>* out) {
   FBB fbb;
   RecordBatchOffset record_batch;
   RETURN_NOT_OK(MakeRecordBatch(fbb, length, body_length, nodes, buffers, &record_batch));
-  auto dictionary_batch = flatbuf::CreateDictionaryBatch(fbb, id, record_batch).Union();
+  auto dictionary_batch =
+      flatbuf::CreateDictionaryBatch(fbb, id, record_batch, is_delta).Union();
   return WriteFBMessage(fbb, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch,
                         body_length, out);
 }
@@ -785,7 +792,8 @@ FileBlocksToFlatbuffer(FBB& fbb, const std::vector<FileBlock>& blocks) {
 
 Status WriteFileFooter(const Schema& schema, const std::vector<FileBlock>& dictionaries,
                        const std::vector<FileBlock>& record_batches,
-                       DictionaryMemo* dictionary_memo, io::OutputStream* out) {
+                       DictionaryMemo* dictionary_memo, const KeyValueMetadata* metadata,
+                       io::OutputStream* out) {
   FBB fbb;
 
   flatbuffers::Offset<flatbuf::Schema> fb_schema;
@@ -808,8 +816,13 @@ Status WriteFileFooter(const Schema& schema, const std::vector<FileBlock>& dicti
   auto fb_dictionaries = FileBlocksToFlatbuffer(fbb, dictionaries);
   auto fb_record_batches = FileBlocksToFlatbuffer(fbb, record_batches);
 
+  flatbuffers::Offset<flatbuffers::Vector<KeyValueOffset>> fb_metadata;
+  if (metadata != nullptr) {
+    fb_metadata = KeyValueMetadataToFlatbuffer(fbb, *metadata);
+  }
+
   auto footer = flatbuf::CreateFooter(fbb, kCurrentMetadataVersion, fb_schema,
-                                      fb_dictionaries, fb_record_batches);
+                                      fb_dictionaries, fb_record_batches, fb_metadata);
 
   fbb.Finish(footer);
 
@@ -818,6 +831,58 @@ Status WriteFileFooter(const Schema& schema, const std::vector<FileBlock>& dicti
   return out->Write(fbb.GetBufferPointer(), size);
 }
 
+Status ReadFileFooter(io::RandomAccessFile* file, int64_t footer_offset,
+                      std::shared_ptr<Buffer>* out) {
+  int magic_size = static_cast<int>(strlen(kArrowMagicBytes));
+
+  if (footer_offset <= magic_size * 2 + 4) {
+    std::stringstream ss;
+    ss << "File is too small: " << footer_offset;
+    return Status::Invalid(ss.str());
+  }
+
+  std::shared_ptr<Buffer> buffer;
+  int file_end_size = static_cast<int>(magic_size + sizeof(int32_t));
+  RETURN_NOT_OK(file->ReadAt(footer_offset - file_end_size, file_end_size, &buffer));
+
+  const int64_t expected_footer_size = magic_size + sizeof(int32_t);
+  if (buffer->size() < expected_footer_size) {
+    std::stringstream ss;
+    ss << "Unable to read " << expected_footer_size << "from end of file";
+    return Status::Invalid(ss.str());
+  }
+
+  if (memcmp(buffer->data() + sizeof(int32_t), kArrowMagicBytes, magic_size)) {
+    return Status::Invalid("Not an Arrow file");
+  }
+
+  int32_t footer_length = *reinterpret_cast<const int32_t*>(buffer->data());
+
+  if (footer_length <= 0 || footer_length + magic_size * 2 + 4 > footer_offset) {
+    return Status::Invalid("File is smaller than indicated metadata size");
+  }
+
+  // Now read the footer
+  return file->ReadAt(footer_offset - footer_length - file_end_size, footer_length, out);
+}
+
+static void FileBlocksFromFlatbuffer(
+    const flatbuffers::Vector<const flatbuf::Block*>* fb_blocks,
+    std::vector<FileBlock>* out) {
+  out->clear();
+  out->reserve(fb_blocks->size());
+  for (const flatbuf::Block* block : *fb_blocks) {
+    out->push_back({block->offset(), block->metaDataLength(), block->bodyLength()});
+  }
+}
+
+void GetFileBlocks(const Buffer& footer, std::vector<FileBlock>* dictionaries,
+                   std::vector<FileBlock>* record_batches) {
+  auto fb_footer = flatbuf::GetFooter(footer.data());
+  FileBlocksFromFlatbuffer(fb_footer->dictionaries(), dictionaries);
+  FileBlocksFromFlatbuffer(fb_footer->recordBatches(), record_batches);
+}
+
 // ----------------------------------------------------------------------
 
 static Status VisitField(const flatbuf::Field* field, DictionaryTypeMap* id_to_field) {
@@ -32,6 +32,8 @@ namespace arrow {
 
 class Buffer;
 class DataType;
+class KeyValueMetadata;
+class MemoryPool;
 class Schema;
 class Status;
 class Tensor;
@@ -41,10 +43,14 @@ namespace flatbuf = org::apache::arrow::flatbuf;
 namespace io {
 
 class OutputStream;
+class RandomAccessFile;
 
 }  // namespace io
 
 namespace ipc {
+
+class Message;
+
 namespace internal {
 
 static constexpr flatbuf::MetadataVersion kCurrentMetadataVersion =
@@ -55,6 +61,13 @@ static constexpr flatbuf::MetadataVersion kMinMetadataVersion =
 
 static constexpr const char* kArrowMagicBytes = "ARROW1";
 
+// Keys of the footer metadata locating the record batch that holds the
+// statistics of the record batches of a file
+static constexpr const char* kStatisticsOffsetKey = "ARROW:statistics:offset";
+static constexpr const char* kStatisticsMetadataLengthKey =
+    "ARROW:statistics:metadata_length";
+static constexpr const char* kStatisticsBodyLengthKey = "ARROW:statistics:body_length";
+
 struct FieldMetadata {
   int64_t length;
   int64_t null_count;
@@ -121,12 +134,32 @@ Status WriteRecordBatchMessage(const int64_t length, const int64_t body_length,
 Status WriteTensorMessage(const Tensor& tensor, const int64_t buffer_start_offset,
                           std::shared_ptr<Buffer>* out);
 
+// metadata, which may be null, is stored as the custom metadata of the footer
 Status WriteFileFooter(const Schema& schema, const std::vector<FileBlock>& dictionaries,
                        const std::vector<FileBlock>& record_batches,
-                       DictionaryMemo* dictionary_memo, io::OutputStream* out);
-
-Status WriteDictionaryMessage(const int64_t id, const int64_t length,
-                              const int64_t body_length,
+                       DictionaryMemo* dictionary_memo, const KeyValueMetadata* metadata,
+                       io::OutputStream* out);
+
+// Read the footer flatbuffer of an Arrow file whose footer length and closing
+// magic bytes end at footer_offset
+Status ReadFileFooter(io::RandomAccessFile* file, int64_t footer_offset,
+                      std::shared_ptr<Buffer>* out);
+
+// Get the blocks of the dictionaries and record batches listed in a footer
+// read with ReadFileFooter
+void GetFileBlocks(const Buffer& footer, std::vector<FileBlock>* dictionaries,
+                   std::vector<FileBlock>* record_batches);
+
+// Read dictionary batch messages into memo, in order. A delta is appended to
+// the dictionary read before for its id, while another dictionary batch for a
+// known id replaces that dictionary if allow_replacement is true. All deltas
+// to a dictionary are concatenated with it at once. Defined in reader.cc
+Status ReadDictionaries(const std::vector<const Message*>& messages,
+                        const DictionaryTypeMap& dictionary_types,
+                        bool allow_replacement, MemoryPool* pool, DictionaryMemo* memo);
+
+Status WriteDictionaryMessage(const int64_t id, const bool is_delta,
+                              const int64_t length, const int64_t body_length,
                               const std::vector<FieldMetadata>& nodes,
                               const std::vector<BufferMetadata>& buffers,
                               std::shared_ptr<Buffer>* out);
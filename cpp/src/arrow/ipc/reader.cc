@@ -17,11 +17,15 @@
 
 #include "arrow/ipc/reader.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <map>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <flatbuffers/flatbuffers.h>  // IWYU pragma: export
@@ -36,13 +40,16 @@
 #include "arrow/ipc/dictionary.h"
 #include "arrow/ipc/message.h"
 #include "arrow/ipc/metadata-internal.h"
+#include "arrow/ipc/statistics.h"
 #include "arrow/ipc/util.h"
+#include "arrow/memory_pool.h"
 #include "arrow/status.h"
 #include "arrow/table.h"
 #include "arrow/tensor.h"
 #include "arrow/type.h"
 #include "arrow/util/bit-util.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 #include "arrow/visitor_inline.h"
 
 namespace arrow {
@@ -52,16 +59,23 @@ namespace flatbuf = org::apache::arrow::flatbuf;
 namespace ipc {
 
 using internal::FileBlock;
-using internal::kArrowMagicBytes;
+using internal::kStatisticsBodyLengthKey;
+using internal::kStatisticsMetadataLengthKey;
+using internal::kStatisticsOffsetKey;
 
 // ----------------------------------------------------------------------
 // Record batch read path
 
+// Ranges of the body that are at most this far apart are read from files
+// without zero-copy support with a single ReadAt
+constexpr int64_t kMaxPrefetchGap = 1 << 20;
+
 /// Accessor class for flatbuffers metadata
 class IpcComponentSource {
  public:
-  IpcComponentSource(const flatbuf::RecordBatch* metadata, io::RandomAccessFile* file)
-      : metadata_(metadata), file_(file) {}
+  IpcComponentSource(const flatbuf::RecordBatch* metadata, io::RandomAccessFile* file,
+                     int64_t body_offset = 0, MemoryPool* pool = default_memory_pool())
+      : metadata_(metadata), file_(file), body_offset_(body_offset), pool_(pool) {}
 
   Status GetBuffer(int buffer_index, std::shared_ptr<Buffer>* out) {
     const flatbuf::Buffer* buffer = metadata_->buffers()->Get(buffer_index);
@@ -73,8 +87,72 @@ class IpcComponentSource {
       DCHECK(BitUtil::IsMultipleOf8(buffer->offset()))
           << "Buffer " << buffer_index
           << " did not start on 8-byte aligned offset: " << buffer->offset();
-      return file_->ReadAt(buffer->offset(), buffer->length(), out);
+      for (const PrefetchedRange& range : prefetched_ranges_) {
+        if (range.start <= buffer->offset() &&
+            buffer->offset() + buffer->length() <= range.end) {
+          *out = SliceBuffer(prefetched_data_,
+                             range.position + buffer->offset() - range.start,
+                             buffer->length());
+          return Status::OK();
+        }
+      }
+      return file_->ReadAt(body_offset_ + buffer->offset(), buffer->length(), out);
+    }
+  }
+
+  bool supports_zero_copy() const { return file_->supports_zero_copy(); }
+
+  /// Read the given runs [begin, end) of buffer indices with as few reads as
+  /// possible into one allocation, which GetBuffer then slices
+  Status Prefetch(const std::vector<std::pair<int, int>>& buffer_runs) {
+    auto buffers = metadata_->buffers();
+
+    // Byte ranges of the runs, merged where they are close together
+    std::vector<PrefetchedRange> ranges;
+    for (const auto& run : buffer_runs) {
+      if (run.first == run.second) {
+        continue;
+      }
+      if (run.second > static_cast<int>(buffers->size())) {
+        return Status::Invalid("Ran out of buffer metadata, likely malformed");
+      }
+      const flatbuf::Buffer* first = buffers->Get(run.first);
+      const flatbuf::Buffer* last = buffers->Get(run.second - 1);
+      PrefetchedRange range = {first->offset(), last->offset() + last->length(), 0};
+      if (!ranges.empty() && range.start >= ranges.back().end &&
+          range.start - ranges.back().end <= kMaxPrefetchGap) {
+        ranges.back().end = range.end;
+      } else {
+        ranges.push_back(range);
+      }
+    }
+
+    int64_t total_size = 0;
+    for (PrefetchedRange& range : ranges) {
+      range.position = total_size;
+      total_size += range.end - range.start;
+    }
+    if (total_size == 0) {
+      return Status::OK();
     }
+
+    std::shared_ptr<Buffer> data;
+    RETURN_NOT_OK(AllocateBuffer(pool_, total_size, &data));
+    for (const PrefetchedRange& range : ranges) {
+      const int64_t nbytes = range.end - range.start;
+      int64_t bytes_read = 0;
+      RETURN_NOT_OK(file_->ReadAt(body_offset_ + range.start, nbytes, &bytes_read,
+                                  data->mutable_data() + range.position));
+      if (bytes_read != nbytes) {
+        std::stringstream ss;
+        ss << "Expected to read " << nbytes << " bytes of record batch body but got "
+           << bytes_read;
+        return Status::IOError(ss.str());
+      }
+    }
+    prefetched_data_ = data;
+    prefetched_ranges_ = std::move(ranges);
+    return Status::OK();
   }
 
   Status GetFieldMetadata(int field_index, ArrayData* out) {
@@ -94,6 +172,24 @@ class IpcComponentSource {
  private:
   const flatbuf::RecordBatch* metadata_;
   io::RandomAccessFile* file_;
+
+  // The position of the message body in file_, which buffer offsets are
+  // relative to
+  int64_t body_offset_;
+
+  // The pool that Prefetch allocates from
+  MemoryPool* pool_;
+
+  // A range [start, end) of the body, relative to body_offset_, held in
+  // prefetched_data_ at position
+  struct PrefetchedRange {
+    int64_t start;
+    int64_t end;
+    int64_t position;
+  };
+
+  std::shared_ptr<Buffer> prefetched_data_;
+  std::vector<PrefetchedRange> prefetched_ranges_;
 };
 
 /// Bookkeeping struct for loading array objects from their constituent pieces of raw data
@@ -274,6 +370,78 @@ static Status LoadArray(const std::shared_ptr<DataType>& type,
   return loader.Load();
 }
 
+// Advance the context past a field and all its children without reading any
+// of their buffers. Must agree with the ArrayLoader on the number of field
+// nodes and buffers each type takes up
+static void SkipField(const DataType& type, ArrayLoaderContext* context) {
+  if (type.id() == Type::DICTIONARY) {
+    // Only the indices are stored in the record batch
+    SkipField(*static_cast<const DictionaryType&>(type).index_type(), context);
+    return;
+  }
+  ++context->field_index;
+  switch (type.id()) {
+    case Type::BINARY:
+    case Type::STRING:
+      context->buffer_index += 3;
+      break;
+    case Type::STRUCT:
+      context->buffer_index += 1;
+      break;
+    case Type::UNION:
+      context->buffer_index +=
+          static_cast<const UnionType&>(type).mode() == UnionMode::DENSE ? 3 : 2;
+      break;
+    default:
+      // The null bitmap, and the values or the list offsets
+      context->buffer_index += 2;
+      break;
+  }
+  for (const auto& child : type.children()) {
+    SkipField(*child->type(), context);
+  }
+}
+
+// ----------------------------------------------------------------------
+// Field projection
+
+/// The top-level fields selected with IpcReadOptions::included_fields
+struct FieldProjection {
+  /// Whether each field of the full schema is read; empty if all are
+  std::vector<bool> included;
+
+  /// The schema of the record batches read
+  std::shared_ptr<Schema> schema;
+};
+
+static Status MakeFieldProjection(const std::shared_ptr<Schema>& schema,
+                                  const IpcReadOptions& options, FieldProjection* out) {
+  out->included.clear();
+  out->schema = schema;
+  if (options.included_fields.empty()) {
+    return Status::OK();
+  }
+
+  out->included.assign(schema->num_fields(), false);
+  for (int i : options.included_fields) {
+    if (i < 0 || i >= schema->num_fields()) {
+      std::stringstream ss;
+      ss << "Selected field " << i << " out of bounds for schema with "
+         << schema->num_fields() << " fields";
+      return Status::Invalid(ss.str());
+    }
+    out->included[i] = true;
+  }
+  std::vector<std::shared_ptr<Field>> fields;
+  for (int i = 0; i < schema->num_fields(); ++i) {
+    if (out->included[i]) {
+      fields.push_back(schema->field(i));
+    }
+  }
+  out->schema = std::make_shared<Schema>(fields, schema->metadata());
+  return Status::OK();
+}
+
 Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
                        io::RandomAccessFile* file, std::shared_ptr<RecordBatch>* out) {
   return ReadRecordBatch(metadata, schema, kMaxNestingDepth, file, out);
@@ -290,6 +458,7 @@ Status ReadRecordBatch(const Message& message, const std::shared_ptr<Schema>& sc
 // Array loading
 
 static Status LoadRecordBatchFromSource(const std::shared_ptr<Schema>& schema,
+                                        const FieldProjection& projection,
                                         int64_t num_rows, int max_recursion_depth,
                                         IpcComponentSource* source,
                                         std::shared_ptr<RecordBatch>* out) {
@@ -299,25 +468,77 @@ static Status LoadRecordBatchFromSource(const std::shared_ptr<Schema>& schema,
   context.buffer_index = 0;
   context.max_recursion_depth = max_recursion_depth;
 
-  std::vector<std::shared_ptr<ArrayData>> arrays(schema->num_fields());
+  if (!source->supports_zero_copy()) {
+    // Collect the buffers of the selected fields, so they can be read in a few
+    // large reads rather than one by one
+    ArrayLoaderContext skip_context = context;
+    std::vector<std::pair<int, int>> buffer_runs;
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      const int begin = skip_context.buffer_index;
+      SkipField(*schema->field(i)->type(), &skip_context);
+      if (!projection.included.empty() && !projection.included[i]) {
+        continue;
+      }
+      if (!buffer_runs.empty() && buffer_runs.back().second == begin) {
+        buffer_runs.back().second = skip_context.buffer_index;
+      } else {
+        buffer_runs.emplace_back(begin, skip_context.buffer_index);
+      }
+    }
+    RETURN_NOT_OK(source->Prefetch(buffer_runs));
+  }
+
+  std::vector<std::shared_ptr<ArrayData>> arrays;
+  arrays.reserve(projection.schema->num_fields());
   for (int i = 0; i < schema->num_fields(); ++i) {
+    if (!projection.included.empty() && !projection.included[i]) {
+      SkipField(*schema->field(i)->type(), &context);
+      continue;
+    }
     auto arr = std::make_shared<ArrayData>();
     RETURN_NOT_OK(LoadArray(schema->field(i)->type(), &context, arr.get()));
     DCHECK_EQ(num_rows, arr->length) << "Array length did not match record batch length";
-    arrays[i] = std::move(arr);
+    arrays.emplace_back(std::move(arr));
   }
 
-  *out = std::make_shared<RecordBatch>(schema, num_rows, std::move(arrays));
+  *out = std::make_shared<RecordBatch>(projection.schema, num_rows, std::move(arrays));
   return Status::OK();
 }
 
 static inline Status ReadRecordBatch(const flatbuf::RecordBatch* metadata,
                                      const std::shared_ptr<Schema>& schema,
+                                     const FieldProjection& projection,
                                      int max_recursion_depth, io::RandomAccessFile* file,
+                                     int64_t body_offset, MemoryPool* pool,
                                      std::shared_ptr<RecordBatch>* out) {
-  IpcComponentSource source(metadata, file);
-  return LoadRecordBatchFromSource(schema, metadata->length(), max_recursion_depth,
-                                   &source, out);
+  IpcComponentSource source(metadata, file, body_offset, pool);
+  return LoadRecordBatchFromSource(schema, projection, metadata->length(),
+                                   max_recursion_depth, &source, out);
+}
+
+static inline Status ReadRecordBatch(const flatbuf::RecordBatch* metadata,
+                                     const std::shared_ptr<Schema>& schema,
+                                     int max_recursion_depth, io::RandomAccessFile* file,
+                                     std::shared_ptr<RecordBatch>* out) {
+  FieldProjection projection;
+  projection.schema = schema;
+  return ReadRecordBatch(metadata, schema, projection, max_recursion_depth, file, 0,
+                         default_memory_pool(), out);
+}
+
+static const flatbuf::RecordBatch* GetRecordBatchMetadata(const Buffer& metadata) {
+  auto message = flatbuf::GetMessage(metadata.data());
+  DCHECK_EQ(message->header_type(), flatbuf::MessageHeader_RecordBatch);
+  return reinterpret_cast<const flatbuf::RecordBatch*>(message->header());
+}
+
+Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
+                       const IpcReadOptions& options, io::RandomAccessFile* file,
+                       std::shared_ptr<RecordBatch>* out) {
+  FieldProjection projection;
+  RETURN_NOT_OK(MakeFieldProjection(schema, options, &projection));
+  return ReadRecordBatch(GetRecordBatchMetadata(metadata), schema, projection,
+                         kMaxNestingDepth, file, 0, options.memory_pool, out);
 }
 
 Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
@@ -389,6 +610,61 @@ static Status ReadMessageAndValidate(MessageReader* reader, Message::Type expect
   return Status::OK();
 }
 
+namespace internal {
+
+Status ReadDictionaries(const std::vector<const Message*>& messages,
+                        const DictionaryTypeMap& dictionary_types,
+                        bool allow_replacement, MemoryPool* pool, DictionaryMemo* memo) {
+  // The pieces of each dictionary read, concatenated at the end so that a run
+  // of deltas copies the dictionary only once
+  std::map<int64_t, ArrayVector> pieces;
+  for (const Message* message : messages) {
+    io::BufferReader reader(message->body());
+
+    std::shared_ptr<Array> dictionary;
+    int64_t id;
+    RETURN_NOT_OK(ReadDictionary(*message->metadata(), dictionary_types, &reader, &id,
+                                 &dictionary));
+    auto it = pieces.find(id);
+    if (it == pieces.end()) {
+      if (!memo->HasDictionaryId(id)) {
+        pieces[id] = {dictionary};
+        continue;
+      }
+      std::shared_ptr<Array> current;
+      RETURN_NOT_OK(memo->GetDictionary(id, &current));
+      it = pieces.insert(std::make_pair(id, ArrayVector{current})).first;
+    }
+
+    auto dictionary_batch =
+        static_cast<const flatbuf::DictionaryBatch*>(message->header());
+    if (dictionary_batch->isDelta()) {
+      it->second.push_back(dictionary);
+    } else if (!allow_replacement) {
+      std::stringstream ss;
+      ss << "Dictionary with id " << id << " cannot be replaced";
+      return Status::Invalid(ss.str());
+    } else {
+      it->second = {dictionary};
+    }
+  }
+
+  for (const auto& entry : pieces) {
+    std::shared_ptr<Array> dictionary = entry.second[0];
+    if (entry.second.size() > 1) {
+      RETURN_NOT_OK(Concatenate(entry.second, pool, &dictionary));
+    }
+    if (memo->HasDictionaryId(entry.first)) {
+      RETURN_NOT_OK(memo->UpdateDictionary(entry.first, dictionary));
+    } else {
+      RETURN_NOT_OK(memo->AddDictionary(entry.first, dictionary));
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace internal
+
 // ----------------------------------------------------------------------
 // RecordBatchStreamReader implementation
 
@@ -401,31 +677,28 @@ class RecordBatchStreamReader::RecordBatchStreamReaderImpl {
   RecordBatchStreamReaderImpl() {}
   ~RecordBatchStreamReaderImpl() {}
 
-  Status Open(std::unique_ptr<MessageReader> message_reader) {
+  Status Open(std::unique_ptr<MessageReader> message_reader,
+              const IpcReadOptions& options) {
     message_reader_ = std::move(message_reader);
-    return ReadSchema();
+    options_ = options;
+    RETURN_NOT_OK(ReadSchema());
+    return SetOptions(options);
   }
 
   Status ReadNextDictionary() {
     std::unique_ptr<Message> message;
     RETURN_NOT_OK(ReadMessageAndValidate(message_reader_.get(), Message::DICTIONARY_BATCH,
                                          false, &message));
-
-    io::BufferReader reader(message->body());
-
-    std::shared_ptr<Array> dictionary;
-    int64_t id;
-    RETURN_NOT_OK(ReadDictionary(*message->metadata(), dictionary_types_, &reader, &id,
-                                 &dictionary));
-    return dictionary_memo_.AddDictionary(id, dictionary);
+    return internal::ReadDictionaries({message.get()}, dictionary_types_, false,
+                                      options_.memory_pool, &dictionary_memo_);
   }
 
   Status ReadSchema() {
-    std::unique_ptr<Message> message;
-    RETURN_NOT_OK(
-        ReadMessageAndValidate(message_reader_.get(), Message::SCHEMA, false, &message));
+    RETURN_NOT_OK(ReadMessageAndValidate(message_reader_.get(), Message::SCHEMA, false,
+                                         &schema_message_));
 
-    RETURN_NOT_OK(internal::GetDictionaryTypes(message->header(), &dictionary_types_));
+    RETURN_NOT_OK(
+        internal::GetDictionaryTypes(schema_message_->header(), &dictionary_types_));
 
     // TODO(wesm): In future, we may want to reconcile the ids in the stream with
     // those found in the schema
@@ -434,28 +707,62 @@ class RecordBatchStreamReader::RecordBatchStreamReaderImpl {
       RETURN_NOT_OK(ReadNextDictionary());
     }
 
-    return internal::GetSchema(message->header(), dictionary_memo_, &schema_);
+    return internal::GetSchema(schema_message_->header(), dictionary_memo_, &schema_);
+  }
+
+  // Apply a dictionary delta or replacement sent between record batches to
+  // the following batches. The schema is rebuilt from its message, with the
+  // unchanged dictionaries keeping their arrays
+  Status UpdateDictionary(const Message& message) {
+    RETURN_NOT_OK(internal::ReadDictionaries({&message}, dictionary_types_, true,
+                                             options_.memory_pool, &dictionary_memo_));
+    RETURN_NOT_OK(
+        internal::GetSchema(schema_message_->header(), dictionary_memo_, &schema_));
+    return MakeFieldProjection(schema_, options_, &projection_);
   }
 
   Status ReadNext(std::shared_ptr<RecordBatch>* batch) {
     std::unique_ptr<Message> message;
-    RETURN_NOT_OK(ReadMessageAndValidate(message_reader_.get(), Message::RECORD_BATCH,
-                                         true, &message));
+    while (true) {
+      RETURN_NOT_OK(message_reader_->ReadNextMessage(&message));
+      if (message == nullptr) {
+        // End of stream
+        *batch = nullptr;
+        return Status::OK();
+      }
+      if (message->type() != Message::DICTIONARY_BATCH) {
+        break;
+      }
+      RETURN_NOT_OK(UpdateDictionary(*message));
+    }
 
-    if (message == nullptr) {
-      // End of stream
-      *batch = nullptr;
-      return Status::OK();
+    if (message->type() != Message::RECORD_BATCH) {
+      std::stringstream ss;
+      ss << "Message not expected type: " << FormatMessageType(Message::RECORD_BATCH)
+         << ", was: " << message->type();
+      return Status::IOError(ss.str());
     }
 
     io::BufferReader reader(message->body());
-    return ReadRecordBatch(*message->metadata(), schema_, &reader, batch);
+    return ReadRecordBatch(GetRecordBatchMetadata(*message->metadata()), schema_,
+                           projection_, kMaxNestingDepth, &reader, 0,
+                           options_.memory_pool, batch);
+  }
+
+  Status SetOptions(const IpcReadOptions& options) {
+    options_ = options;
+    return MakeFieldProjection(schema_, options, &projection_);
   }
 
-  std::shared_ptr<Schema> schema() const { return schema_; }
+  std::shared_ptr<Schema> schema() const { return projection_.schema; }
 
  private:
   std::unique_ptr<MessageReader> message_reader_;
+  IpcReadOptions options_;
+  FieldProjection projection_;
+
+  // Kept to rebuild the schema when dictionaries change
+  std::unique_ptr<Message> schema_message_;
 
   // dictionary_id -> type
   DictionaryTypeMap dictionary_types_;
@@ -471,9 +778,15 @@ RecordBatchStreamReader::~RecordBatchStreamReader() {}
 
 Status RecordBatchStreamReader::Open(std::unique_ptr<MessageReader> message_reader,
                                      std::shared_ptr<RecordBatchReader>* reader) {
+  return Open(std::move(message_reader), IpcReadOptions::Defaults(), reader);
+}
+
+Status RecordBatchStreamReader::Open(std::unique_ptr<MessageReader> message_reader,
+                                     const IpcReadOptions& options,
+                                     std::shared_ptr<RecordBatchReader>* reader) {
   // Private ctor
   auto result = std::shared_ptr<RecordBatchStreamReader>(new RecordBatchStreamReader());
-  RETURN_NOT_OK(result->impl_->Open(std::move(message_reader)));
+  RETURN_NOT_OK(result->impl_->Open(std::move(message_reader), options));
   *reader = result;
   return Status::OK();
 }
@@ -490,6 +803,14 @@ Status RecordBatchStreamReader::Open(const std::shared_ptr<io::InputStream>& str
   return Open(std::move(message_reader), out);
 }
 
+Status RecordBatchStreamReader::Open(const std::shared_ptr<io::InputStream>& stream,
+                                     const IpcReadOptions& options,
+                                     std::shared_ptr<RecordBatchReader>* out) {
+  std::unique_ptr<MessageReader> message_reader(
+      new InputStreamMessageReader(stream, options.buffer_pool));
+  return Open(std::move(message_reader), options, out);
+}
+
 std::shared_ptr<Schema> RecordBatchStreamReader::schema() const {
   return impl_->schema();
 }
@@ -501,47 +822,113 @@ Status RecordBatchStreamReader::ReadNext(std::shared_ptr<RecordBatch>* batch) {
 // ----------------------------------------------------------------------
 // Reader implementation
 
+// The largest run of adjacent record batches that ReadTable reads from the
+// file at once
+constexpr int64_t kMaxReadRunSize = 64 << 20;
+
 class RecordBatchFileReader::RecordBatchFileReaderImpl {
  public:
-  RecordBatchFileReaderImpl() { dictionary_memo_ = std::make_shared<DictionaryMemo>(); }
+  RecordBatchFileReaderImpl()
+      : pool_(default_memory_pool()), has_statistics_(false), statistics_read_(false) {
+    dictionary_memo_ = std::make_shared<DictionaryMemo>();
+  }
 
   Status ReadFooter() {
-    int magic_size = static_cast<int>(strlen(kArrowMagicBytes));
+    RETURN_NOT_OK(internal::ReadFileFooter(file_, footer_offset_, &footer_buffer_));
 
-    if (footer_offset_ <= magic_size * 2 + 4) {
-      std::stringstream ss;
-      ss << "File is too small: " << footer_offset_;
-      return Status::Invalid(ss.str());
+    // TODO(wesm): Verify the footer
+    footer_ = flatbuf::GetFooter(footer_buffer_->data());
+
+    has_statistics_ = false;
+    auto fb_metadata = footer_->custom_metadata();
+    if (fb_metadata != nullptr) {
+      int found_keys = 0;
+      for (const auto& pair : *fb_metadata) {
+        const std::string key = pair->key()->str();
+        const int64_t value = std::strtoll(pair->value()->c_str(), nullptr, 10);
+        if (key == kStatisticsOffsetKey) {
+          statistics_block_.offset = value;
+        } else if (key == kStatisticsMetadataLengthKey) {
+          statistics_block_.metadata_length = static_cast<int32_t>(value);
+        } else if (key == kStatisticsBodyLengthKey) {
+          statistics_block_.body_length = value;
+        } else {
+          continue;
+        }
+        ++found_keys;
+      }
+      has_statistics_ = found_keys == 3;
     }
+    return Status::OK();
+  }
 
-    std::shared_ptr<Buffer> buffer;
-    int file_end_size = static_cast<int>(magic_size + sizeof(int32_t));
-    RETURN_NOT_OK(file_->ReadAt(footer_offset_ - file_end_size, file_end_size, &buffer));
+  bool has_statistics() const { return has_statistics_; }
 
-    const int64_t expected_footer_size = magic_size + sizeof(int32_t);
-    if (buffer->size() < expected_footer_size) {
-      std::stringstream ss;
-      ss << "Unable to read " << expected_footer_size << "from end of file";
-      return Status::Invalid(ss.str());
+  Status ReadStatistics(const std::vector<RecordBatchStatistics>** out) {
+    if (!has_statistics_) {
+      return Status::Invalid("File has no statistics of its record batches");
     }
+    if (!statistics_read_) {
+      std::unique_ptr<Message> message;
+      RETURN_NOT_OK(ReadMessage(statistics_block_.offset,
+                                statistics_block_.metadata_length, file_, &message));
+      if (message == nullptr || message->type() != Message::RECORD_BATCH) {
+        return Status::Invalid("File block does not hold the statistics record batch");
+      }
 
-    if (memcmp(buffer->data() + sizeof(int32_t), kArrowMagicBytes, magic_size)) {
-      return Status::Invalid("Not an Arrow file");
+      io::BufferReader reader(message->body());
+      std::shared_ptr<RecordBatch> batch;
+      RETURN_NOT_OK(::arrow::ipc::ReadRecordBatch(
+          *message->metadata(), StatisticsSchema(*schema_), &reader, &batch));
+      RETURN_NOT_OK(GetStatistics(*batch, *schema_, &statistics_));
+      if (static_cast<int>(statistics_.size()) != num_record_batches()) {
+        return Status::Invalid("Statistics do not match the record batches of the file");
+      }
+      statistics_read_ = true;
     }
+    *out = &statistics_;
+    return Status::OK();
+  }
 
-    int32_t footer_length = *reinterpret_cast<const int32_t*>(buffer->data());
-
-    if (footer_length <= 0 || footer_length + magic_size * 2 + 4 > footer_offset_) {
-      return Status::Invalid("File is smaller than indicated metadata size");
+  Status SelectRecordBatches(const std::vector<ColumnRange>& ranges,
+                             std::vector<int>* out) {
+    out->clear();
+    if (!has_statistics_) {
+      for (int i = 0; i < num_record_batches(); ++i) {
+        out->push_back(i);
+      }
+      return Status::OK();
     }
 
-    // Now read the footer
-    RETURN_NOT_OK(file_->ReadAt(footer_offset_ - footer_length - file_end_size,
-                                footer_length, &footer_buffer_));
-
-    // TODO(wesm): Verify the footer
-    footer_ = flatbuf::GetFooter(footer_buffer_->data());
+    // The ranges are on the fields read, the statistics on all fields
+    std::vector<ColumnRange> file_ranges = ranges;
+    if (!projection_.included.empty()) {
+      std::vector<int> file_columns;
+      for (int i = 0; i < static_cast<int>(projection_.included.size()); ++i) {
+        if (projection_.included[i]) {
+          file_columns.push_back(i);
+        }
+      }
+      for (ColumnRange& range : file_ranges) {
+        if (range.column < 0 || range.column >= static_cast<int>(file_columns.size())) {
+          std::stringstream ss;
+          ss << "Range on column " << range.column << " out of bounds for "
+             << file_columns.size() << " read fields";
+          return Status::Invalid(ss.str());
+        }
+        range.column = file_columns[range.column];
+      }
+    }
 
+    const std::vector<RecordBatchStatistics>* statistics;
+    RETURN_NOT_OK(ReadStatistics(&statistics));
+    for (int i = 0; i < num_record_batches(); ++i) {
+      bool may_match;
+      RETURN_NOT_OK(MayMatch((*statistics)[i], file_ranges, &may_match));
+      if (may_match) {
+        out->push_back(i);
+      }
+    }
     return Status::OK();
   }
 
@@ -583,6 +970,10 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
     DCHECK(BitUtil::IsMultipleOf8(block.metadata_length));
     DCHECK(BitUtil::IsMultipleOf8(block.body_length));
 
+    if (!projection_.included.empty()) {
+      return ReadRecordBatchAt(block, file_, batch);
+    }
+
     std::unique_ptr<Message> message;
     RETURN_NOT_OK(ReadMessage(block.offset, block.metadata_length, file_, &message));
 
@@ -590,10 +981,127 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
     return ::arrow::ipc::ReadRecordBatch(*message->metadata(), schema_, &reader, batch);
   }
 
+  // Read the metadata of the batch in block, then only the buffers of the
+  // selected fields from their place in file
+  Status ReadRecordBatchAt(const FileBlock& block, io::RandomAccessFile* file,
+                           std::shared_ptr<RecordBatch>* batch) {
+    std::shared_ptr<Buffer> buffer;
+    RETURN_NOT_OK(file->ReadAt(block.offset, block.metadata_length, &buffer));
+    if (buffer->size() < block.metadata_length) {
+      std::stringstream ss;
+      ss << "Expected to read " << block.metadata_length << " metadata bytes but got "
+         << buffer->size();
+      return Status::Invalid(ss.str());
+    }
+    int32_t flatbuffer_size = *reinterpret_cast<const int32_t*>(buffer->data());
+    if (flatbuffer_size + static_cast<int>(sizeof(int32_t)) > block.metadata_length) {
+      return Status::Invalid("Invalid flatbuffer size in record batch metadata");
+    }
+
+    std::unique_ptr<Message> message;
+    RETURN_NOT_OK(
+        Message::Open(SliceBuffer(buffer, 4, buffer->size() - 4), nullptr, &message));
+    if (message->type() != Message::RECORD_BATCH) {
+      return Status::Invalid("File block does not hold a record batch");
+    }
+    auto metadata = static_cast<const flatbuf::RecordBatch*>(message->header());
+    return ::arrow::ipc::ReadRecordBatch(metadata, schema_, projection_, kMaxNestingDepth,
+                                         file, block.offset + block.metadata_length,
+                                         pool_, batch);
+  }
+
+  Status ReadTable(int nthreads, std::shared_ptr<Table>* out) {
+    if (nthreads < 1) {
+      return Status::Invalid("Number of threads must be at least 1");
+    }
+    const int num_batches = num_record_batches();
+    if (num_batches == 0) {
+      std::shared_ptr<Schema> schema = projection_.schema;
+      std::vector<std::shared_ptr<Column>> columns;
+      for (int i = 0; i < schema->num_fields(); ++i) {
+        columns.push_back(std::make_shared<Column>(schema->field(i), ArrayVector{}));
+      }
+      *out = std::make_shared<Table>(schema, columns, 0);
+      return Status::OK();
+    }
+
+    std::vector<std::shared_ptr<RecordBatch>> batches(num_batches);
+    if (!projection_.included.empty()) {
+      // Reading whole runs would read the buffers of the skipped fields too
+      RETURN_NOT_OK(ParallelFor(std::min(nthreads, num_batches), num_batches,
+                                [this, &batches](int i) {
+                                  return ReadRecordBatchAt(record_batch(i), file_,
+                                                           &batches[i]);
+                                }));
+      return Table::FromRecordBatches(batches, out);
+    }
+
+    // Split the batches into runs of adjacent blocks. The runs are kept small
+    // enough that every thread gets at least one of them
+    int64_t total_size = 0;
+    for (int i = 0; i < num_batches; ++i) {
+      FileBlock block = record_batch(i);
+      total_size += block.metadata_length + block.body_length;
+    }
+    const int64_t max_run_size =
+        std::max<int64_t>(1, std::min(kMaxReadRunSize, total_size / nthreads));
+
+    std::vector<int> run_starts = {0};
+    FileBlock run_block = record_batch(0);
+    int64_t run_end =
+        run_block.offset + run_block.metadata_length + run_block.body_length;
+    for (int i = 1; i < num_batches; ++i) {
+      FileBlock block = record_batch(i);
+      int64_t block_end = block.offset + block.metadata_length + block.body_length;
+      if (block.offset != run_end || block_end - run_block.offset > max_run_size) {
+        run_starts.push_back(i);
+        run_block = block;
+      }
+      run_end = block_end;
+    }
+    run_starts.push_back(num_batches);
+
+    const int num_runs = static_cast<int>(run_starts.size()) - 1;
+    RETURN_NOT_OK(ParallelFor(std::min(nthreads, num_runs), num_runs,
+                              [this, &run_starts, &batches](int run) {
+                                return ReadRun(run_starts[run], run_starts[run + 1],
+                                               &batches);
+                              }));
+    return Table::FromRecordBatches(batches, out);
+  }
+
+  // Read the blocks of the batches in [begin, end) from the file at once, then
+  // decode the batches from that memory
+  Status ReadRun(int begin, int end, std::vector<std::shared_ptr<RecordBatch>>* out) {
+    const FileBlock first_block = record_batch(begin);
+    const FileBlock last_block = record_batch(end - 1);
+    const int64_t run_size = last_block.offset + last_block.metadata_length +
+                             last_block.body_length - first_block.offset;
+
+    std::shared_ptr<Buffer> run_data;
+    RETURN_NOT_OK(file_->ReadAt(first_block.offset, run_size, &run_data));
+    if (run_data->size() < run_size) {
+      std::stringstream ss;
+      ss << "Expected to read " << run_size << " bytes of record batches but got "
+         << run_data->size();
+      return Status::IOError(ss.str());
+    }
+
+    io::BufferReader run_reader(run_data);
+    for (int i = begin; i < end; ++i) {
+      FileBlock block = record_batch(i);
+      block.offset -= first_block.offset;
+      RETURN_NOT_OK(ReadRecordBatchAt(block, &run_reader, &(*out)[i]));
+    }
+    return Status::OK();
+  }
+
   Status ReadSchema() {
     RETURN_NOT_OK(internal::GetDictionaryTypes(footer_->schema(), &dictionary_fields_));
 
     // Read all the dictionaries
+    std::vector<std::unique_ptr<Message>> messages(num_dictionaries());
+    std::vector<const Message*> message_ptrs;
     for (int i = 0; i < num_dictionaries(); ++i) {
       FileBlock block = dictionary(i);
 
@@ -601,35 +1109,37 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
       DCHECK(BitUtil::IsMultipleOf8(block.metadata_length));
       DCHECK(BitUtil::IsMultipleOf8(block.body_length));
 
-      std::unique_ptr<Message> message;
-      RETURN_NOT_OK(ReadMessage(block.offset, block.metadata_length, file_, &message));
-
-      io::BufferReader reader(message->body());
-
-      std::shared_ptr<Array> dictionary;
-      int64_t dictionary_id;
-      RETURN_NOT_OK(ReadDictionary(*message->metadata(), dictionary_fields_, &reader,
-                                   &dictionary_id, &dictionary));
-      RETURN_NOT_OK(dictionary_memo_->AddDictionary(dictionary_id, dictionary));
+      RETURN_NOT_OK(
+          ReadMessage(block.offset, block.metadata_length, file_, &messages[i]));
+      message_ptrs.push_back(messages[i].get());
     }
 
+    // The dictionaries apply to all record batches of the file, so they may
+    // only grow through deltas
+    RETURN_NOT_OK(internal::ReadDictionaries(message_ptrs, dictionary_fields_, false,
+                                             pool_, dictionary_memo_.get()));
+
     // Get the schema
     return internal::GetSchema(footer_->schema(), *dictionary_memo_, &schema_);
   }
 
-  Status Open(const std::shared_ptr<io::RandomAccessFile>& file, int64_t footer_offset) {
+  Status Open(const std::shared_ptr<io::RandomAccessFile>& file, int64_t footer_offset,
+              const IpcReadOptions& options) {
     owned_file_ = file;
-    return Open(file.get(), footer_offset);
+    return Open(file.get(), footer_offset, options);
   }
 
-  Status Open(io::RandomAccessFile* file, int64_t footer_offset) {
+  Status Open(io::RandomAccessFile* file, int64_t footer_offset,
+              const IpcReadOptions& options) {
     file_ = file;
     footer_offset_ = footer_offset;
+    pool_ = options.memory_pool;
     RETURN_NOT_OK(ReadFooter());
-    return ReadSchema();
+    RETURN_NOT_OK(ReadSchema());
+    return MakeFieldProjection(schema_, options, &projection_);
   }
 
-  std::shared_ptr<Schema> schema() const { return schema_; }
+  std::shared_ptr<Schema> schema() const { return projection_.schema; }
 
  private:
   io::RandomAccessFile* file_;
@@ -649,6 +1159,19 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
 
   // Reconstructed schema, including any read dictionaries
   std::shared_ptr<Schema> schema_;
+
+  // The fields to read
+  FieldProjection projection_;
+
+  // The pool for prefetched record batch bodies and grown dictionaries
+  MemoryPool* pool_;
+
+  // The record batch holding the statistics, if the footer lists it
+  bool has_statistics_;
+  FileBlock statistics_block_;
+
+  bool statistics_read_;
+  std::vector<RecordBatchStatistics> statistics_;
 };
 
 RecordBatchFileReader::RecordBatchFileReader() {
@@ -666,8 +1189,14 @@ Status RecordBatchFileReader::Open(io::RandomAccessFile* file,
 
 Status RecordBatchFileReader::Open(io::RandomAccessFile* file, int64_t footer_offset,
                                    std::shared_ptr<RecordBatchFileReader>* reader) {
+  return Open(file, footer_offset, IpcReadOptions::Defaults(), reader);
+}
+
+Status RecordBatchFileReader::Open(io::RandomAccessFile* file, int64_t footer_offset,
+                                   const IpcReadOptions& options,
+                                   std::shared_ptr<RecordBatchFileReader>* reader) {
   *reader = std::shared_ptr<RecordBatchFileReader>(new RecordBatchFileReader());
-  return (*reader)->impl_->Open(file, footer_offset);
+  return (*reader)->impl_->Open(file, footer_offset, options);
 }
 
 Status RecordBatchFileReader::Open(const std::shared_ptr<io::RandomAccessFile>& file,
@@ -681,7 +1210,72 @@ Status RecordBatchFileReader::Open(const std::shared_ptr<io::RandomAccessFile>&
                                    int64_t footer_offset,
                                    std::shared_ptr<RecordBatchFileReader>* reader) {
   *reader = std::shared_ptr<RecordBatchFileReader>(new RecordBatchFileReader());
-  return (*reader)->impl_->Open(file, footer_offset);
+  return (*reader)->impl_->Open(file, footer_offset, IpcReadOptions::Defaults());
+}
+
+Status RecordBatchFileReader::Open(const std::shared_ptr<io::RandomAccessFile>& file,
+                                   const IpcReadOptions& options,
+                                   std::shared_ptr<RecordBatchFileReader>* reader) {
+  int64_t footer_offset;
+  RETURN_NOT_OK(file->GetSize(&footer_offset));
+  *reader = std::shared_ptr<RecordBatchFileReader>(new RecordBatchFileReader());
+  return (*reader)->impl_->Open(file, footer_offset, options);
+}
+
+// Whether the footer closed at footer_offset is complete: a well-formed
+// flatbuffer whose blocks all lie before it
+static bool IsCompleteFooter(io::RandomAccessFile* file, int64_t footer_offset) {
+  std::shared_ptr<Buffer> footer;
+  if (!internal::ReadFileFooter(file, footer_offset, &footer).ok()) {
+    return false;
+  }
+  flatbuffers::Verifier verifier(footer->data(), static_cast<size_t>(footer->size()));
+  if (!flatbuf::VerifyFooterBuffer(verifier)) {
+    return false;
+  }
+  const int64_t trailer_size =
+      static_cast<int64_t>(sizeof(int32_t) + strlen(internal::kArrowMagicBytes));
+  const int64_t footer_start = footer_offset - trailer_size - footer->size();
+  std::vector<FileBlock> blocks;
+  std::vector<FileBlock> record_batches;
+  internal::GetFileBlocks(*footer, &blocks, &record_batches);
+  blocks.insert(blocks.end(), record_batches.begin(), record_batches.end());
+  for (const FileBlock& block : blocks) {
+    if (block.offset < 0 || block.metadata_length < 0 || block.body_length < 0 ||
+        block.offset + block.metadata_length + block.body_length > footer_start) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status RecordBatchFileReader::FindFooterOffset(io::RandomAccessFile* file,
+                                               int64_t* footer_offset) {
+  constexpr int64_t kChunkSize = 1 << 16;
+  const int64_t magic_size = static_cast<int64_t>(strlen(internal::kArrowMagicBytes));
+
+  int64_t end;
+  RETURN_NOT_OK(file->GetSize(&end));
+  while (end >= magic_size) {
+    const int64_t start = std::max(static_cast<int64_t>(0), end - kChunkSize);
+    std::shared_ptr<Buffer> chunk;
+    RETURN_NOT_OK(file->ReadAt(start, end - start, &chunk));
+    for (int64_t candidate = start + chunk->size(); candidate - magic_size >= start;
+         --candidate) {
+      if (memcmp(chunk->data() + (candidate - magic_size - start),
+                 internal::kArrowMagicBytes, magic_size) == 0 &&
+          IsCompleteFooter(file, candidate)) {
+        *footer_offset = candidate;
+        return Status::OK();
+      }
+    }
+    if (start == 0) {
+      break;
+    }
+    // Overlap the chunks to find magic bytes that cross their boundary
+    end = start + magic_size - 1;
+  }
+  return Status::Invalid("File has no complete Arrow footer");
 }
 
 std::shared_ptr<Schema> RecordBatchFileReader::schema() const { return impl_->schema(); }
@@ -697,6 +1291,24 @@ Status RecordBatchFileReader::ReadRecordBatch(int i,
   return impl_->ReadRecordBatch(i, batch);
 }
 
+Status RecordBatchFileReader::ReadTable(int nthreads, std::shared_ptr<Table>* out) {
+  return impl_->ReadTable(nthreads, out);
+}
+
+bool RecordBatchFileReader::has_statistics() const { return impl_->has_statistics(); }
+
+Status RecordBatchFileReader::ReadStatistics(std::vector<RecordBatchStatistics>* out) {
+  const std::vector<RecordBatchStatistics>* statistics;
+  RETURN_NOT_OK(impl_->ReadStatistics(&statistics));
+  *out = *statistics;
+  return Status::OK();
+}
+
+Status RecordBatchFileReader::SelectRecordBatches(const std::vector<ColumnRange>& ranges,
+                                                  std::vector<int>* out) {
+  return impl_->SelectRecordBatches(ranges, out);
+}
+
 static Status ReadContiguousPayload(io::InputStream* file,
                                     std::unique_ptr<Message>* message) {
   RETURN_NOT_OK(ReadMessage(file, message));
@@ -22,8 +22,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "arrow/ipc/message.h"
+#include "arrow/ipc/statistics.h"
+#include "arrow/memory_pool.h"
 #include "arrow/table.h"
 #include "arrow/util/visibility.h"
 
@@ -46,12 +49,44 @@ namespace ipc {
 
 using RecordBatchReader = ::arrow::RecordBatchReader;
 
+/// \brief Options for reading record batches from files and streams
+struct ARROW_EXPORT IpcReadOptions {
+  IpcReadOptions() : memory_pool(default_memory_pool()) {}
+
+  /// \brief The indices of the top-level fields to read; all fields if empty
+  ///
+  /// Record batches only contain the selected fields, in schema order. The
+  /// buffers of the other fields, including all their children, are not read
+  /// at all, which saves the IO for files read with ReadAt.
+  std::vector<int> included_fields;
+
+  /// \brief The pool to read each stream message into, as a single buffer
+  ///
+  /// The record batches read from the stream are views on these buffers; a
+  /// buffer goes back to the pool when its batch and all arrays taken from
+  /// it are released. Avoids allocating for every message when the batches
+  /// have similar sizes. Only used by the stream reader opened on an
+  /// io::InputStream, and not worthwhile for zero-copy sources such as
+  /// io::BufferReader, whose messages it copies. When null, buffers are
+  /// allocated by the stream
+  std::shared_ptr<RecyclingBufferPool> buffer_pool;
+
+  /// \brief The pool for the memory that reading allocates itself
+  ///
+  /// Used for the coalesced reads of record batch bodies from sources without
+  /// zero-copy support, and for the dictionaries grown by deltas.
+  MemoryPool* memory_pool;
+
+  static IpcReadOptions Defaults() { return IpcReadOptions(); }
+};
+
 /// \class RecordBatchStreamReader
 /// \brief Synchronous batch stream reader that reads from io::InputStream
 ///
 /// This class reads the schema (plus any dictionaries) as the first messages
-/// in the stream, followed by record batches. For more granular zero-copy
-/// reads see the ReadRecordBatch functions
+/// in the stream, followed by record batches. Dictionary deltas and
+/// replacements between the record batches apply to the batches after them.
+/// For more granular zero-copy reads see the ReadRecordBatch functions
 class ARROW_EXPORT RecordBatchStreamReader : public RecordBatchReader {
  public:
   virtual ~RecordBatchStreamReader();
@@ -64,6 +99,16 @@ class ARROW_EXPORT RecordBatchStreamReader : public RecordBatchReader {
   static Status Open(std::unique_ptr<MessageReader> message_reader,
                      std::shared_ptr<RecordBatchReader>* out);
 
+  /// \brief Create batch reader from generic MessageReader with options
+  ///
+  /// \param[in] message_reader a MessageReader implementation
+  /// \param[in] options the fields to read
+  /// \param[out] out the created RecordBatchReader object
+  /// \return Status, Invalid if a selected field does not exist
+  static Status Open(std::unique_ptr<MessageReader> message_reader,
+                     const IpcReadOptions& options,
+                     std::shared_ptr<RecordBatchReader>* out);
+
   /// \brief Record batch stream reader from InputStream
   ///
   /// \param[in] stream an input stream instance. Must stay alive throughout
@@ -79,7 +124,17 @@ class ARROW_EXPORT RecordBatchStreamReader : public RecordBatchReader {
   static Status Open(const std::shared_ptr<io::InputStream>& stream,
                      std::shared_ptr<RecordBatchReader>* out);
 
-  /// \brief Returns the schema read from the stream
+  /// \brief Open stream with options and retain ownership of stream object
+  /// \param[in] stream the input stream
+  /// \param[in] options the fields to read
+  /// \param[out] out the batch reader
+  /// \return Status
+  static Status Open(const std::shared_ptr<io::InputStream>& stream,
+                     const IpcReadOptions& options,
+                     std::shared_ptr<RecordBatchReader>* out);
+
+  /// \brief Returns the schema of the batches read from the stream, only with
+  /// the selected fields
   std::shared_ptr<Schema> schema() const override;
 
   Status ReadNext(std::shared_ptr<RecordBatch>* batch) override;
@@ -137,7 +192,46 @@ class ARROW_EXPORT RecordBatchFileReader {
                      int64_t footer_offset,
                      std::shared_ptr<RecordBatchFileReader>* reader);
 
-  /// \brief The schema read from the file
+  /// \brief Open a RecordBatchFileReader with options
+  ///
+  /// With selected fields, ReadRecordBatch reads the metadata of a batch and
+  /// then only the buffers of the selected fields.
+  ///
+  /// \param[in] file the data source
+  /// \param[in] footer_offset the position of the end of the Arrow file
+  /// \param[in] options the fields to read
+  /// \param[out] reader the returned reader
+  /// \return Status, Invalid if a selected field does not exist
+  static Status Open(io::RandomAccessFile* file, int64_t footer_offset,
+                     const IpcReadOptions& options,
+                     std::shared_ptr<RecordBatchFileReader>* reader);
+
+  /// \brief Version of Open with options that retains ownership of file
+  ///
+  /// \param[in] file the data source
+  /// \param[in] options the fields to read
+  /// \param[out] reader the returned reader
+  /// \return Status
+  static Status Open(const std::shared_ptr<io::RandomAccessFile>& file,
+                     const IpcReadOptions& options,
+                     std::shared_ptr<RecordBatchFileReader>* reader);
+
+  /// \brief Find the end of the last complete footer in a file
+  ///
+  /// Recovers a file whose append with RecordBatchFileWriter::OpenForAppend
+  /// was interrupted: such a file ends with incomplete record batches or an
+  /// incomplete footer, after the intact footer of the file before the
+  /// append. The file is scanned backwards for the magic bytes that close a
+  /// footer, and the first footer that is well-formed and only lists blocks
+  /// before itself is taken.
+  ///
+  /// \param[in] file the data source
+  /// \param[out] footer_offset the end of the footer, to pass to Open
+  /// \return Status, Invalid if the file has no complete footer
+  static Status FindFooterOffset(io::RandomAccessFile* file, int64_t* footer_offset);
+
+  /// \brief The schema of the batches read from the file, only with the
+  /// selected fields
   std::shared_ptr<Schema> schema() const;
 
   /// \brief Returns the number of record batches in the file
@@ -154,6 +248,45 @@ class ARROW_EXPORT RecordBatchFileReader {
   /// \return Status
   Status ReadRecordBatch(int i, std::shared_ptr<RecordBatch>* batch);
 
+  /// \brief Read all record batches in the file into a table
+  ///
+  /// Runs of adjacent record batches are read from the file with one ReadAt
+  /// each, and the runs are read and decoded on nthreads threads. With
+  /// included_fields set, the batches are instead read one by one, each with
+  /// only the buffers of the selected fields. The chunks of the table are the
+  /// record batches in file order.
+  ///
+  /// \param[in] nthreads the number of threads to use, at least 1
+  /// \param[out] out the read table
+  /// \return Status
+  Status ReadTable(int nthreads, std::shared_ptr<Table>* out);
+
+  /// \brief Whether the file stores statistics of its record batches, see
+  /// IpcWriteOptions::write_statistics
+  bool has_statistics() const;
+
+  /// \brief Read the statistics of the record batches of the file
+  ///
+  /// The statistics cover all fields of the file, also when only some are
+  /// read. They are read from the file once and then kept.
+  ///
+  /// \param[out] out the statistics of each record batch
+  /// \return Status, Invalid if the file has no statistics
+  Status ReadStatistics(std::vector<RecordBatchStatistics>* out);
+
+  /// \brief Find the record batches that may have rows in all the ranges
+  ///
+  /// Batches are skipped when their statistics show that none of their rows
+  /// can satisfy the ranges; the rows of the returned batches still need to
+  /// be filtered. Without statistics all batches are returned.
+  ///
+  /// \param[in] ranges ranges on columns of schema(), that is on the read
+  /// fields only when IpcReadOptions::included_fields is set
+  /// \param[out] out the indices of the record batches to read, in order
+  /// \return Status
+  Status SelectRecordBatches(const std::vector<ColumnRange>& ranges,
+                             std::vector<int>* out);
+
  private:
   RecordBatchFileReader();
 
@@ -207,6 +340,22 @@ ARROW_EXPORT
 Status ReadRecordBatch(const Message& message, const std::shared_ptr<Schema>& schema,
                        std::shared_ptr<RecordBatch>* out);
 
+/// \brief Read the selected fields of a record batch from file given metadata
+/// and schema
+///
+/// Only the buffers of the selected fields are read from file.
+///
+/// \param[in] metadata a Message containing the record batch metadata
+/// \param[in] schema the schema of all fields of the record batch
+/// \param[in] options the fields to read
+/// \param[in] file a random access file holding the message body
+/// \param[out] out the read record batch
+/// \return Status
+ARROW_EXPORT
+Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
+                       const IpcReadOptions& options, io::RandomAccessFile* file,
+                       std::shared_ptr<RecordBatch>* out);
+
 /// Read record batch from file given metadata and schema
 ///
 /// \param[in] metadata a Message containing the record batch metadata
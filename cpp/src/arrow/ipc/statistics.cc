@@ -0,0 +1,478 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/ipc/statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+namespace ipc {
+
+namespace {
+
+// 2^11 one-byte registers give a standard error of about 2.3%
+constexpr int kHyperLogLogPrecision = 11;
+constexpr int kHyperLogLogRegisters = 1 << kHyperLogLogPrecision;
+
+// HyperLogLog sketch estimating the number of distinct 64-bit hashes added
+// to it
+class HyperLogLog {
+ public:
+  HyperLogLog() : registers_(kHyperLogLogRegisters, 0) {}
+
+  void Add(uint64_t hash) {
+    // The first bits select a register, which keeps the largest position of
+    // the first set bit among the remaining bits. The sentinel bit bounds the
+    // position when all remaining bits are zero
+    const uint64_t index = hash >> (64 - kHyperLogLogPrecision);
+    const uint64_t rest = (hash << kHyperLogLogPrecision) |
+                          (static_cast<uint64_t>(1) << (kHyperLogLogPrecision - 1));
+    uint8_t rank = 1;
+    for (uint64_t bit = static_cast<uint64_t>(1) << 63; (rest & bit) == 0; bit >>= 1) {
+      ++rank;
+    }
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  int64_t Estimate() const {
+    const double m = kHyperLogLogRegisters;
+    double sum = 0;
+    int zero_registers = 0;
+    for (uint8_t rank : registers_) {
+      sum += std::ldexp(1.0, -rank);
+      if (rank == 0) {
+        ++zero_registers;
+      }
+    }
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zero_registers > 0) {
+      // Linear counting is more accurate for small cardinalities
+      estimate = m * std::log(m / zero_registers);
+    }
+    return static_cast<int64_t>(std::llround(estimate));
+  }
+
+ private:
+  std::vector<uint8_t> registers_;
+};
+
+// Access to the values of arrays with an ordering, for the statistics
+// visitors
+template <typename ArrowType>
+class NumericValues {
+ public:
+  using c_type = typename ArrowType::c_type;
+  using value_type = c_type;
+
+  explicit NumericValues(const Array& array)
+      : array_(static_cast<const NumericArray<ArrowType>&>(array)) {}
+
+  c_type operator[](int64_t i) const { return array_.Value(i); }
+
+  static bool Less(c_type left, c_type right) { return left < right; }
+
+  // NaN is not ordered
+  static bool IsOrdered(c_type value) { return value == value; }
+
+  static uint64_t Hash(c_type value) {
+    return HashUtil::MurmurHash2_64(&value, static_cast<int>(sizeof(c_type)), 0);
+  }
+
+ private:
+  const NumericArray<ArrowType>& array_;
+};
+
+class BinaryValues {
+ public:
+  struct value_type {
+    const uint8_t* data;
+    int32_t length;
+  };
+
+  explicit BinaryValues(const Array& array)
+      : array_(static_cast<const BinaryArray&>(array)) {}
+
+  value_type operator[](int64_t i) const {
+    value_type value;
+    value.data = array_.GetValue(i, &value.length);
+    return value;
+  }
+
+  static bool Less(const value_type& left, const value_type& right) {
+    const int cmp = memcmp(left.data, right.data, std::min(left.length, right.length));
+    return cmp < 0 || (cmp == 0 && left.length < right.length);
+  }
+
+  static bool IsOrdered(const value_type&) { return true; }
+
+  static uint64_t Hash(const value_type& value) {
+    return HashUtil::MurmurHash2_64(value.data, value.length, 0);
+  }
+
+ private:
+  const BinaryArray& array_;
+};
+
+// Calls visitor->Visit(static_cast<Values*>(nullptr)) with the accessor of
+// the values of types with an ordering. Returns false for other types
+template <typename VISITOR>
+bool VisitOrderedType(const DataType& type, VISITOR* visitor) {
+  switch (type.id()) {
+#define ORDERED_TYPE_CASE(TYPE_ID, VALUES)         \
+  case Type::TYPE_ID:                              \
+    visitor->Visit(static_cast<VALUES*>(nullptr)); \
+    return true;
+
+    ORDERED_TYPE_CASE(UINT8, NumericValues<UInt8Type>)
+    ORDERED_TYPE_CASE(INT8, NumericValues<Int8Type>)
+    ORDERED_TYPE_CASE(UINT16, NumericValues<UInt16Type>)
+    ORDERED_TYPE_CASE(INT16, NumericValues<Int16Type>)
+    ORDERED_TYPE_CASE(UINT32, NumericValues<UInt32Type>)
+    ORDERED_TYPE_CASE(INT32, NumericValues<Int32Type>)
+    ORDERED_TYPE_CASE(UINT64, NumericValues<UInt64Type>)
+    ORDERED_TYPE_CASE(INT64, NumericValues<Int64Type>)
+    ORDERED_TYPE_CASE(FLOAT, NumericValues<FloatType>)
+    ORDERED_TYPE_CASE(DOUBLE, NumericValues<DoubleType>)
+    ORDERED_TYPE_CASE(DATE32, NumericValues<Date32Type>)
+    ORDERED_TYPE_CASE(DATE64, NumericValues<Date64Type>)
+    ORDERED_TYPE_CASE(TIME32, NumericValues<Time32Type>)
+    ORDERED_TYPE_CASE(TIME64, NumericValues<Time64Type>)
+    ORDERED_TYPE_CASE(TIMESTAMP, NumericValues<TimestampType>)
+    ORDERED_TYPE_CASE(BINARY, BinaryValues)
+    ORDERED_TYPE_CASE(STRING, BinaryValues)
+
+#undef ORDERED_TYPE_CASE
+    default:
+      return false;
+  }
+}
+
+struct NoOpVisitor {
+  template <typename Values>
+  void Visit(Values*) {}
+};
+
+bool HasOrdering(const DataType& type) {
+  NoOpVisitor visitor;
+  return VisitOrderedType(type, &visitor);
+}
+
+// Finds the smallest and largest values and estimates the number of distinct
+// values of a column
+class ColumnStatisticsVisitor {
+ public:
+  ColumnStatisticsVisitor(const std::shared_ptr<Array>& column, MemoryPool* pool,
+                          ColumnStatistics* out)
+      : column_(column), pool_(pool), out_(out) {}
+
+  template <typename Values>
+  void Visit(Values*) {
+    Values values(*column_);
+    HyperLogLog sketch;
+    int64_t min_index = -1;
+    int64_t max_index = -1;
+    const bool check_nulls = column_->null_count() > 0;
+    for (int64_t i = 0; i < column_->length(); ++i) {
+      if (check_nulls && column_->IsNull(i)) {
+        continue;
+      }
+      const typename Values::value_type value = values[i];
+      sketch.Add(Values::Hash(value));
+      if (!Values::IsOrdered(value)) {
+        continue;
+      }
+      if (min_index < 0 || Values::Less(value, values[min_index])) {
+        min_index = i;
+      }
+      if (max_index < 0 || Values::Less(values[max_index], value)) {
+        max_index = i;
+      }
+    }
+    out_->distinct_count = sketch.Estimate();
+    if (min_index >= 0) {
+      // Copy the values so that the statistics do not hold on to the column
+      status_ = Concatenate({column_->Slice(min_index, 1)}, pool_, &out_->min);
+      if (status_.ok()) {
+        status_ = Concatenate({column_->Slice(max_index, 1)}, pool_, &out_->max);
+      }
+    }
+  }
+
+  Status status() const { return status_; }
+
+ private:
+  const std::shared_ptr<Array>& column_;
+  MemoryPool* pool_;
+  ColumnStatistics* out_;
+  Status status_;
+};
+
+// Compares the first values of two arrays of the same type
+class CompareVisitor {
+ public:
+  CompareVisitor(const Array& left, const Array& right)
+      : left_(left), right_(right), result_(0) {}
+
+  template <typename Values>
+  void Visit(Values*) {
+    const typename Values::value_type left = Values(left_)[0];
+    const typename Values::value_type right = Values(right_)[0];
+    result_ = Values::Less(left, right) ? -1 : (Values::Less(right, left) ? 1 : 0);
+  }
+
+  int result() const { return result_; }
+
+ private:
+  const Array& left_;
+  const Array& right_;
+  int result_;
+};
+
+int CompareValues(const Array& left, const Array& right) {
+  CompareVisitor visitor(left, right);
+  VisitOrderedType(*left.type(), &visitor);
+  return visitor.result();
+}
+
+Status CheckBound(const ColumnRange& range, const Array& bound,
+                  const ColumnStatistics& statistics) {
+  if (bound.length() != 1 || bound.null_count() != 0) {
+    return Status::Invalid("Range bounds must be arrays holding one non-null value");
+  }
+  if (!HasOrdering(*bound.type())) {
+    std::stringstream ss;
+    ss << "Cannot compare values of type " << bound.type()->ToString();
+    return Status::Invalid(ss.str());
+  }
+  if (statistics.min != nullptr && !statistics.min->type()->Equals(*bound.type())) {
+    std::stringstream ss;
+    ss << "Range bound of type " << bound.type()->ToString() << " for column "
+       << range.column << " of type " << statistics.min->type()->ToString();
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+// An array of length 1 holding a null of a type with an ordering
+Status MakeNullValue(const std::shared_ptr<DataType>& type, MemoryPool* pool,
+                     std::shared_ptr<Array>* out) {
+  std::vector<std::shared_ptr<Buffer>> buffers(2);
+  RETURN_NOT_OK(AllocateBuffer(pool, 1, &buffers[0]));
+  buffers[0]->mutable_data()[0] = 0;
+
+  int64_t values_size;
+  if (type->id() == Type::BINARY || type->id() == Type::STRING) {
+    // Two zero offsets and no data
+    values_size = 2 * sizeof(int32_t);
+    buffers.resize(3);
+    RETURN_NOT_OK(AllocateBuffer(pool, 0, &buffers[2]));
+  } else {
+    values_size = static_cast<const FixedWidthType&>(*type).bit_width() / 8;
+  }
+  RETURN_NOT_OK(AllocateBuffer(pool, values_size, &buffers[1]));
+  memset(buffers[1]->mutable_data(), 0, static_cast<size_t>(values_size));
+
+  *out = MakeArray(std::make_shared<ArrayData>(type, 1, std::move(buffers), 1));
+  return Status::OK();
+}
+
+// Concatenates the minimum or maximum values of a column of all batches
+Status MakeValueColumn(const std::shared_ptr<DataType>& type,
+                       const std::vector<std::shared_ptr<Array>>& values,
+                       MemoryPool* pool, std::shared_ptr<Array>* out) {
+  std::shared_ptr<Array> null_value;
+  std::vector<std::shared_ptr<Array>> chunks;
+  chunks.reserve(values.size());
+  for (const std::shared_ptr<Array>& value : values) {
+    if (value != nullptr) {
+      chunks.push_back(value);
+      continue;
+    }
+    if (null_value == nullptr) {
+      RETURN_NOT_OK(MakeNullValue(type, pool, &null_value));
+    }
+    chunks.push_back(null_value);
+  }
+  return Concatenate(chunks, pool, out);
+}
+
+std::string StatisticsFieldName(const char* statistic, int column) {
+  std::stringstream ss;
+  ss << statistic << ":" << column;
+  return ss.str();
+}
+
+}  // namespace
+
+Status ComputeStatistics(const RecordBatch& batch, MemoryPool* pool,
+                         RecordBatchStatistics* out) {
+  out->clear();
+  out->resize(batch.num_columns());
+  for (int i = 0; i < batch.num_columns(); ++i) {
+    const std::shared_ptr<Array>& column = batch.column(i);
+    ColumnStatistics* statistics = &(*out)[i];
+    statistics->null_count = column->null_count();
+    ColumnStatisticsVisitor visitor(column, pool, statistics);
+    VisitOrderedType(*column->type(), &visitor);
+    RETURN_NOT_OK(visitor.status());
+  }
+  return Status::OK();
+}
+
+Status MayMatch(const RecordBatchStatistics& statistics,
+                const std::vector<ColumnRange>& ranges, bool* out) {
+  *out = true;
+  for (const ColumnRange& range : ranges) {
+    if (range.column < 0 || range.column >= static_cast<int>(statistics.size())) {
+      std::stringstream ss;
+      ss << "Range on column " << range.column << " out of bounds for statistics of "
+         << statistics.size() << " columns";
+      return Status::Invalid(ss.str());
+    }
+    const ColumnStatistics& column_statistics = statistics[range.column];
+    if (range.lower != nullptr) {
+      RETURN_NOT_OK(CheckBound(range, *range.lower, column_statistics));
+    }
+    if (range.upper != nullptr) {
+      RETURN_NOT_OK(CheckBound(range, *range.upper, column_statistics));
+    }
+    if (!*out || (range.lower == nullptr && range.upper == nullptr)) {
+      continue;
+    }
+
+    // Without a minimum value the column only has nulls or NaN values, which
+    // are never in a range
+    if (column_statistics.min == nullptr ||
+        (range.lower != nullptr &&
+         CompareValues(*column_statistics.max, *range.lower) < 0) ||
+        (range.upper != nullptr &&
+         CompareValues(*column_statistics.min, *range.upper) > 0)) {
+      *out = false;
+    }
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<Schema> StatisticsSchema(const Schema& schema) {
+  std::vector<std::shared_ptr<Field>> fields;
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    fields.push_back(field(StatisticsFieldName("null_count", i), int64(), false));
+    fields.push_back(field(StatisticsFieldName("distinct_count", i), int64(), false));
+    const std::shared_ptr<DataType>& type = schema.field(i)->type();
+    if (HasOrdering(*type)) {
+      fields.push_back(field(StatisticsFieldName("min", i), type));
+      fields.push_back(field(StatisticsFieldName("max", i), type));
+    }
+  }
+  return ::arrow::schema(fields);
+}
+
+Status MakeStatisticsBatch(const Schema& schema,
+                           const std::vector<RecordBatchStatistics>& statistics,
+                           MemoryPool* pool, std::shared_ptr<RecordBatch>* out) {
+  if (statistics.empty()) {
+    return Status::Invalid("Need the statistics of at least one record batch");
+  }
+  for (const RecordBatchStatistics& batch_statistics : statistics) {
+    if (static_cast<int>(batch_statistics.size()) != schema.num_fields()) {
+      return Status::Invalid("Statistics do not match the fields of the schema");
+    }
+  }
+
+  std::vector<std::shared_ptr<Array>> columns;
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    Int64Builder null_count_builder(pool);
+    Int64Builder distinct_count_builder(pool);
+    std::vector<std::shared_ptr<Array>> mins, maxs;
+    for (const RecordBatchStatistics& batch_statistics : statistics) {
+      const ColumnStatistics& column_statistics = batch_statistics[i];
+      RETURN_NOT_OK(null_count_builder.Append(column_statistics.null_count));
+      RETURN_NOT_OK(distinct_count_builder.Append(column_statistics.distinct_count));
+      mins.push_back(column_statistics.min);
+      maxs.push_back(column_statistics.max);
+    }
+
+    std::shared_ptr<Array> column;
+    RETURN_NOT_OK(null_count_builder.Finish(&column));
+    columns.push_back(column);
+    RETURN_NOT_OK(distinct_count_builder.Finish(&column));
+    columns.push_back(column);
+
+    const std::shared_ptr<DataType>& type = schema.field(i)->type();
+    if (HasOrdering(*type)) {
+      RETURN_NOT_OK(MakeValueColumn(type, mins, pool, &column));
+      columns.push_back(column);
+      RETURN_NOT_OK(MakeValueColumn(type, maxs, pool, &column));
+      columns.push_back(column);
+    }
+  }
+
+  *out = std::make_shared<RecordBatch>(StatisticsSchema(schema),
+                                       static_cast<int64_t>(statistics.size()), columns);
+  return Status::OK();
+}
+
+Status GetStatistics(const RecordBatch& batch, const Schema& schema,
+                     std::vector<RecordBatchStatistics>* out) {
+  if (!batch.schema()->Equals(*StatisticsSchema(schema))) {
+    return Status::Invalid("Record batch does not hold statistics for the schema");
+  }
+
+  out->assign(batch.num_rows(), RecordBatchStatistics(schema.num_fields()));
+  int column_index = 0;
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    const auto& null_counts =
+        static_cast<const Int64Array&>(*batch.column(column_index++));
+    const auto& distinct_counts =
+        static_cast<const Int64Array&>(*batch.column(column_index++));
+    std::shared_ptr<Array> mins, maxs;
+    if (HasOrdering(*schema.field(i)->type())) {
+      mins = batch.column(column_index++);
+      maxs = batch.column(column_index++);
+    }
+
+    for (int64_t row = 0; row < batch.num_rows(); ++row) {
+      ColumnStatistics* statistics = &(*out)[row][i];
+      statistics->null_count = null_counts.Value(row);
+      statistics->distinct_count = distinct_counts.Value(row);
+      if (mins != nullptr && !mins->IsNull(row)) {
+        statistics->min = mins->Slice(row, 1);
+        statistics->max = maxs->Slice(row, 1);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace ipc
+}  // namespace arrow
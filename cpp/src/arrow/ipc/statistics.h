@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Per-column statistics of record batches, stored in the IPC file format to
+// skip batches when reading
+
+#ifndef ARROW_IPC_STATISTICS_H
+#define ARROW_IPC_STATISTICS_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class MemoryPool;
+class RecordBatch;
+class Schema;
+class Status;
+
+namespace ipc {
+
+/// \brief Statistics of one column of a record batch
+struct ARROW_EXPORT ColumnStatistics {
+  ColumnStatistics() : null_count(0), distinct_count(-1) {}
+
+  int64_t null_count;
+
+  /// \brief Estimate of the number of distinct non-null values from a
+  /// HyperLogLog sketch, or -1 for types whose values are not hashed
+  int64_t distinct_count;
+
+  /// \brief The smallest and largest non-null values as arrays of length 1
+  /// of the column type
+  ///
+  /// Only integer, floating point, date, time, timestamp, binary and string
+  /// columns have them; floating point NaN values are left out. Null if the
+  /// column has no such values.
+  std::shared_ptr<Array> min;
+  std::shared_ptr<Array> max;
+};
+
+/// \brief The statistics of each column of a record batch
+using RecordBatchStatistics = std::vector<ColumnStatistics>;
+
+/// \brief Compute the statistics of all columns of a record batch
+///
+/// \param[in] batch the record batch
+/// \param[in] pool memory pool for the copies of the minimum and maximum values
+/// \param[out] out the statistics, one entry per column
+/// \return Status
+ARROW_EXPORT
+Status ComputeStatistics(const RecordBatch& batch, MemoryPool* pool,
+                         RecordBatchStatistics* out);
+
+/// \brief A predicate keeping the rows whose value in a column lies in the
+/// closed range [lower, upper]
+struct ARROW_EXPORT ColumnRange {
+  /// The index of the column in the schema of the batches
+  int column;
+
+  /// Arrays of length 1 of the column type holding a non-null bound, or
+  /// null to leave that end of the range open
+  std::shared_ptr<Array> lower;
+  std::shared_ptr<Array> upper;
+};
+
+/// \brief Whether a record batch may have rows satisfying all the ranges,
+/// judging by its statistics
+///
+/// \param[in] statistics the statistics of the batch
+/// \param[in] ranges the ranges, which must be on columns with a minimum and
+/// maximum value per the ColumnStatistics
+/// \param[out] out false if no row of the batch can satisfy the ranges
+/// \return Status, Invalid if a range does not match the statistics
+ARROW_EXPORT
+Status MayMatch(const RecordBatchStatistics& statistics,
+                const std::vector<ColumnRange>& ranges, bool* out);
+
+/// \brief Store the statistics of a sequence of record batches as a record
+/// batch with one row per batch, to be written alongside them
+///
+/// \param[in] schema the schema of the record batches
+/// \param[in] statistics the statistics of each record batch, at least one
+/// \param[in] pool the memory pool to allocate from
+/// \param[out] out the batch holding the statistics
+/// \return Status
+ARROW_EXPORT
+Status MakeStatisticsBatch(const Schema& schema,
+                           const std::vector<RecordBatchStatistics>& statistics,
+                           MemoryPool* pool, std::shared_ptr<RecordBatch>* out);
+
+/// \brief The schema of the batch made by MakeStatisticsBatch for record
+/// batches with the given schema
+ARROW_EXPORT
+std::shared_ptr<Schema> StatisticsSchema(const Schema& schema);
+
+/// \brief Get the statistics stored with MakeStatisticsBatch
+///
+/// \param[in] batch the batch holding the statistics
+/// \param[in] schema the schema of the record batches
+/// \param[out] out the statistics of each record batch
+/// \return Status
+ARROW_EXPORT
+Status GetStatistics(const RecordBatch& batch, const Schema& schema,
+                     std::vector<RecordBatchStatistics>* out);
+
+}  // namespace ipc
+}  // namespace arrow
+
+#endif  // ARROW_IPC_STATISTICS_H
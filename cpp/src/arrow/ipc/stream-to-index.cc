@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "arrow/io/file.h"
+#include "arrow/ipc/stream_index.h"
+#include "arrow/status.h"
+
+namespace arrow {
+namespace ipc {
+
+// Scans a stream file on the file system and writes the index of its messages
+// to a second file, which IndexedStreamReader can then use.
+// A typical usage would be:
+// $ stream-to-index events.stream events.stream.index
+Status WriteStreamIndex(const char* stream_path, const char* index_path) {
+  std::shared_ptr<io::ReadableFile> stream;
+  RETURN_NOT_OK(io::ReadableFile::Open(stream_path, &stream));
+
+  std::shared_ptr<StreamIndex> index;
+  RETURN_NOT_OK(StreamIndex::Build(stream.get(), &index));
+
+  std::shared_ptr<io::FileOutputStream> sink;
+  RETURN_NOT_OK(io::FileOutputStream::Open(index_path, &sink));
+  RETURN_NOT_OK(index->WriteTo(sink.get()));
+  RETURN_NOT_OK(sink->Close());
+
+  std::cout << index->num_record_batches() << " record batches, " << index->num_rows()
+            << " rows in " << index->indexed_length() << " bytes"
+            << (index->complete() ? "" : " (stream not terminated)") << std::endl;
+  return Status::OK();
+}
+
+}  // namespace ipc
+}  // namespace arrow
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: stream-to-index <input arrow stream> <output index file>"
+              << std::endl;
+    return 1;
+  }
+  arrow::Status status = arrow::ipc::WriteStreamIndex(argv[1], argv[2]);
+  if (!status.ok()) {
+    std::cerr << "Could not index stream: " << status.ToString() << std::endl;
+    return 1;
+  }
+  return 0;
+}
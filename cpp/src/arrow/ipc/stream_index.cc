@@ -0,0 +1,373 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/ipc/stream_index.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/ipc/Message_generated.h"
+#include "arrow/ipc/dictionary.h"
+#include "arrow/ipc/metadata-internal.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/util/key_value_metadata.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+namespace ipc {
+
+// Keys of the schema metadata of a saved index
+static constexpr const char* kIndexedLengthKey = "ARROW:stream_index:indexed_length";
+static constexpr const char* kCompleteKey = "ARROW:stream_index:complete";
+
+// ----------------------------------------------------------------------
+// StreamIndex
+
+StreamIndex::StreamIndex() : row_offsets_({0}), indexed_length_(0), complete_(false) {}
+
+void StreamIndex::AddMessage(const StreamIndexEntry& entry) {
+  if (entry.type == Message::RECORD_BATCH) {
+    record_batches_.push_back(static_cast<int>(messages_.size()));
+    row_offsets_.push_back(row_offsets_.back() + entry.num_rows);
+  }
+  messages_.push_back(entry);
+}
+
+Status StreamIndex::Build(io::RandomAccessFile* stream,
+                          std::shared_ptr<StreamIndex>* out) {
+  std::shared_ptr<StreamIndex> index(new StreamIndex());
+  RETURN_NOT_OK(index->Update(stream));
+  *out = index;
+  return Status::OK();
+}
+
+Status StreamIndex::Update(io::RandomAccessFile* stream) {
+  if (complete_) {
+    return Status::OK();
+  }
+
+  int64_t stream_size;
+  RETURN_NOT_OK(stream->GetSize(&stream_size));
+
+  int64_t position = indexed_length_;
+  while (position + static_cast<int64_t>(sizeof(int32_t)) <= stream_size) {
+    int32_t flatbuffer_size = 0;
+    int64_t bytes_read = 0;
+    RETURN_NOT_OK(stream->ReadAt(position, sizeof(int32_t), &bytes_read,
+                                 reinterpret_cast<uint8_t*>(&flatbuffer_size)));
+    if (bytes_read != sizeof(int32_t)) {
+      break;
+    }
+    if (flatbuffer_size == 0) {
+      // End-of-stream marker
+      indexed_length_ = position + sizeof(int32_t);
+      complete_ = true;
+      break;
+    }
+    if (flatbuffer_size < 0) {
+      std::stringstream ss;
+      ss << "Invalid message length " << flatbuffer_size << " at stream position "
+         << position;
+      return Status::Invalid(ss.str());
+    }
+
+    StreamIndexEntry entry;
+    entry.offset = position;
+    entry.metadata_length = flatbuffer_size + static_cast<int32_t>(sizeof(int32_t));
+    if (position + entry.metadata_length > stream_size) {
+      // The metadata is still being written
+      break;
+    }
+
+    std::shared_ptr<Buffer> metadata;
+    RETURN_NOT_OK(stream->ReadAt(position + sizeof(int32_t), flatbuffer_size, &metadata));
+    if (metadata->size() != flatbuffer_size) {
+      return Status::IOError("Unexpected end of stream trying to read message");
+    }
+    std::unique_ptr<Message> message;
+    RETURN_NOT_OK(Message::Open(metadata, nullptr, &message));
+
+    entry.type = message->type();
+    entry.body_length = flatbuf::GetMessage(metadata->data())->bodyLength();
+    entry.num_rows = 0;
+    if (entry.type == Message::RECORD_BATCH) {
+      auto batch = static_cast<const flatbuf::RecordBatch*>(message->header());
+      entry.num_rows = batch->length();
+    }
+
+    const int64_t message_end = position + entry.metadata_length + entry.body_length;
+    if (message_end > stream_size) {
+      // The body is still being written
+      break;
+    }
+    AddMessage(entry);
+    position = indexed_length_ = message_end;
+  }
+  return Status::OK();
+}
+
+static std::shared_ptr<Schema> IndexSchema(int64_t indexed_length, bool complete) {
+  auto metadata = std::make_shared<KeyValueMetadata>();
+  metadata->Append(kIndexedLengthKey, std::to_string(indexed_length));
+  metadata->Append(kCompleteKey, complete ? "true" : "false");
+  return ::arrow::schema({field("type", int8(), false), field("offset", int64(), false),
+                          field("metadata_length", int32(), false),
+                          field("body_length", int64(), false),
+                          field("num_rows", int64(), false)},
+                         metadata);
+}
+
+Status StreamIndex::WriteTo(io::OutputStream* sink) const {
+  MemoryPool* pool = default_memory_pool();
+  Int8Builder type_builder(pool);
+  Int64Builder offset_builder(pool);
+  Int32Builder metadata_length_builder(pool);
+  Int64Builder body_length_builder(pool);
+  Int64Builder num_rows_builder(pool);
+  for (const StreamIndexEntry& entry : messages_) {
+    RETURN_NOT_OK(type_builder.Append(static_cast<int8_t>(entry.type)));
+    RETURN_NOT_OK(offset_builder.Append(entry.offset));
+    RETURN_NOT_OK(metadata_length_builder.Append(entry.metadata_length));
+    RETURN_NOT_OK(body_length_builder.Append(entry.body_length));
+    RETURN_NOT_OK(num_rows_builder.Append(entry.num_rows));
+  }
+
+  std::vector<std::shared_ptr<Array>> columns(5);
+  RETURN_NOT_OK(type_builder.Finish(&columns[0]));
+  RETURN_NOT_OK(offset_builder.Finish(&columns[1]));
+  RETURN_NOT_OK(metadata_length_builder.Finish(&columns[2]));
+  RETURN_NOT_OK(body_length_builder.Finish(&columns[3]));
+  RETURN_NOT_OK(num_rows_builder.Finish(&columns[4]));
+
+  auto schema = IndexSchema(indexed_length_, complete_);
+  RecordBatch batch(schema, static_cast<int64_t>(messages_.size()), columns);
+
+  std::shared_ptr<RecordBatchWriter> writer;
+  RETURN_NOT_OK(RecordBatchFileWriter::Open(sink, schema, &writer));
+  RETURN_NOT_OK(writer->WriteRecordBatch(batch));
+  return writer->Close();
+}
+
+Status StreamIndex::ReadFrom(const std::shared_ptr<io::RandomAccessFile>& file,
+                             std::shared_ptr<StreamIndex>* out) {
+  std::shared_ptr<RecordBatchFileReader> reader;
+  RETURN_NOT_OK(RecordBatchFileReader::Open(file, &reader));
+
+  std::shared_ptr<Schema> schema = reader->schema();
+  std::shared_ptr<const KeyValueMetadata> metadata = schema->metadata();
+  if (metadata == nullptr || metadata->size() != 2 ||
+      metadata->key(0) != kIndexedLengthKey || metadata->key(1) != kCompleteKey ||
+      !schema->Equals(*IndexSchema(0, false))) {
+    return Status::Invalid("File does not hold a stream index");
+  }
+
+  std::shared_ptr<StreamIndex> index(new StreamIndex());
+  index->indexed_length_ = std::strtoll(metadata->value(0).c_str(), nullptr, 10);
+  index->complete_ = metadata->value(1) == "true";
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<RecordBatch> batch;
+    RETURN_NOT_OK(reader->ReadRecordBatch(i, &batch));
+    const auto& types = static_cast<const Int8Array&>(*batch->column(0));
+    const auto& offsets = static_cast<const Int64Array&>(*batch->column(1));
+    const auto& metadata_lengths = static_cast<const Int32Array&>(*batch->column(2));
+    const auto& body_lengths = static_cast<const Int64Array&>(*batch->column(3));
+    const auto& num_rows = static_cast<const Int64Array&>(*batch->column(4));
+    for (int64_t j = 0; j < batch->num_rows(); ++j) {
+      StreamIndexEntry entry;
+      entry.type = static_cast<Message::Type>(types.Value(j));
+      entry.offset = offsets.Value(j);
+      entry.metadata_length = metadata_lengths.Value(j);
+      entry.body_length = body_lengths.Value(j);
+      entry.num_rows = num_rows.Value(j);
+      index->AddMessage(entry);
+    }
+  }
+  *out = index;
+  return Status::OK();
+}
+
+Status StreamIndex::FindRow(int64_t row, int* batch_index, int64_t* batch_row) const {
+  if (row < 0 || row >= num_rows()) {
+    std::stringstream ss;
+    ss << "Row " << row << " out of bounds for stream index with " << num_rows()
+       << " rows";
+    return Status::Invalid(ss.str());
+  }
+  // The last batch whose first row is at most row; empty batches before it
+  // are skipped
+  auto it = std::upper_bound(row_offsets_.begin(), row_offsets_.end(), row);
+  *batch_index = static_cast<int>(it - row_offsets_.begin()) - 1;
+  *batch_row = row - row_offsets_[*batch_index];
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// IndexedStreamReader
+
+// Read the message at an index entry, which must have the expected type
+static Status ReadIndexedMessage(io::RandomAccessFile* stream,
+                                 const StreamIndexEntry& entry,
+                                 std::unique_ptr<Message>* message) {
+  RETURN_NOT_OK(ReadMessage(entry.offset, entry.metadata_length, stream, message));
+  if (*message == nullptr || (*message)->type() != entry.type) {
+    return Status::Invalid("Stream index does not match the stream");
+  }
+  return Status::OK();
+}
+
+IndexedStreamReader::IndexedStreamReader() : scanned_messages_(0), scanned_batches_(0) {}
+
+IndexedStreamReader::~IndexedStreamReader() {}
+
+Status IndexedStreamReader::Open(const std::shared_ptr<io::RandomAccessFile>& stream,
+                                 const std::shared_ptr<StreamIndex>& index,
+                                 std::shared_ptr<IndexedStreamReader>* out) {
+  const std::vector<StreamIndexEntry>& entries = index->messages();
+  if (entries.empty() || entries[0].type != Message::SCHEMA) {
+    return Status::Invalid("Stream index does not start with a schema");
+  }
+
+  // Private ctor
+  auto result = std::shared_ptr<IndexedStreamReader>(new IndexedStreamReader());
+  result->stream_ = stream;
+  result->index_ = index;
+
+  // The schema and the dictionaries are the first messages of the stream
+  RETURN_NOT_OK(ReadIndexedMessage(stream.get(), entries[0], &result->schema_message_));
+  RETURN_NOT_OK(internal::GetDictionaryTypes(result->schema_message_->header(),
+                                             &result->dictionary_types_));
+  std::vector<std::unique_ptr<Message>> messages;
+  std::vector<const Message*> message_ptrs;
+  for (size_t i = 1; i < entries.size() && entries[i].type == Message::DICTIONARY_BATCH;
+       ++i) {
+    std::unique_ptr<Message> message;
+    RETURN_NOT_OK(ReadIndexedMessage(stream.get(), entries[i], &message));
+    message_ptrs.push_back(message.get());
+    messages.push_back(std::move(message));
+  }
+  DictionaryMemo memo;
+  RETURN_NOT_OK(internal::ReadDictionaries(message_ptrs, result->dictionary_types_, true,
+                                           default_memory_pool(), &memo));
+  RETURN_NOT_OK(
+      internal::GetSchema(result->schema_message_->header(), memo, &result->schema_));
+
+  DictionaryCheckpoint& initial = result->checkpoints_[0];
+  initial.dictionaries = memo.id_to_dictionary();
+  initial.schema = result->schema_;
+  *out = result;
+  return Status::OK();
+}
+
+std::shared_ptr<Schema> IndexedStreamReader::schema() const { return schema_; }
+
+std::shared_ptr<StreamIndex> IndexedStreamReader::index() const { return index_; }
+
+int IndexedStreamReader::num_record_batches() const {
+  return index_->num_record_batches();
+}
+
+void IndexedStreamReader::ScanDictionaryChanges() {
+  const std::vector<StreamIndexEntry>& messages = index_->messages();
+  for (; scanned_messages_ < messages.size(); ++scanned_messages_) {
+    const StreamIndexEntry& entry = messages[scanned_messages_];
+    if (entry.type == Message::RECORD_BATCH) {
+      ++scanned_batches_;
+    } else if (entry.type == Message::DICTIONARY_BATCH && scanned_batches_ > 0) {
+      if (change_batches_.empty() || change_batches_.back() != scanned_batches_) {
+        change_batches_.push_back(scanned_batches_);
+        change_messages_.emplace_back();
+      }
+      change_messages_.back().push_back(scanned_messages_);
+    }
+  }
+}
+
+Status IndexedStreamReader::GetSchemaAfterChanges(int num_changes,
+                                                  std::shared_ptr<Schema>* out) {
+  // The closest checkpoint at or before num_changes; there is always one for
+  // the initial dictionaries
+  auto checkpoint = --checkpoints_.upper_bound(num_changes);
+  if (checkpoint->first == num_changes) {
+    *out = checkpoint->second.schema;
+    return Status::OK();
+  }
+
+  DictionaryMemo memo;
+  for (const auto& entry : checkpoint->second.dictionaries) {
+    RETURN_NOT_OK(memo.AddDictionary(entry.first, entry.second));
+  }
+  std::vector<std::unique_ptr<Message>> messages;
+  std::vector<const Message*> message_ptrs;
+  for (int change = checkpoint->first; change < num_changes; ++change) {
+    for (size_t position : change_messages_[change]) {
+      std::unique_ptr<Message> message;
+      RETURN_NOT_OK(
+          ReadIndexedMessage(stream_.get(), index_->messages()[position], &message));
+      message_ptrs.push_back(message.get());
+      messages.push_back(std::move(message));
+    }
+  }
+  RETURN_NOT_OK(internal::ReadDictionaries(message_ptrs, dictionary_types_, true,
+                                           default_memory_pool(), &memo));
+
+  DictionaryCheckpoint& result = checkpoints_[num_changes];
+  result.dictionaries = memo.id_to_dictionary();
+  RETURN_NOT_OK(internal::GetSchema(schema_message_->header(), memo, &result.schema));
+  *out = result.schema;
+  return Status::OK();
+}
+
+Status IndexedStreamReader::ReadRecordBatch(int i, std::shared_ptr<RecordBatch>* batch) {
+  DCHECK_GE(i, 0);
+  DCHECK_LT(i, num_record_batches());
+  ScanDictionaryChanges();
+  const int num_changes = static_cast<int>(
+      std::upper_bound(change_batches_.begin(), change_batches_.end(), i) -
+      change_batches_.begin());
+  std::shared_ptr<Schema> schema;
+  RETURN_NOT_OK(GetSchemaAfterChanges(num_changes, &schema));
+
+  std::unique_ptr<Message> message;
+  RETURN_NOT_OK(ReadIndexedMessage(stream_.get(), index_->record_batch(i), &message));
+  return ::arrow::ipc::ReadRecordBatch(*message, schema, batch);
+}
+
+Status IndexedStreamReader::ReadRecordBatchForRow(int64_t row,
+                                                  std::shared_ptr<RecordBatch>* batch,
+                                                  int64_t* batch_row) {
+  int batch_index;
+  RETURN_NOT_OK(index_->FindRow(row, &batch_index, batch_row));
+  return ReadRecordBatch(batch_index, batch);
+}
+
+}  // namespace ipc
+}  // namespace arrow
@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Random access to record batches in the IPC stream format
+
+#ifndef ARROW_IPC_STREAM_INDEX_H
+#define ARROW_IPC_STREAM_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "arrow/ipc/dictionary.h"
+#include "arrow/ipc/message.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class RecordBatch;
+class Schema;
+class Status;
+
+namespace io {
+
+class OutputStream;
+class RandomAccessFile;
+
+}  // namespace io
+
+namespace ipc {
+
+/// \brief The location of one message in an IPC stream
+struct ARROW_EXPORT StreamIndexEntry {
+  Message::Type type;
+
+  /// The position of the length prefix of the message
+  int64_t offset;
+
+  /// The size of the length prefix, the metadata and its padding
+  int32_t metadata_length;
+
+  int64_t body_length;
+
+  /// The number of rows of a record batch, 0 for other messages
+  int64_t num_rows;
+};
+
+/// \class StreamIndex
+/// \brief The positions of the messages in an IPC stream, found by scanning
+/// the message metadata once
+///
+/// An index can be saved next to the stream and loaded again, and extended
+/// with the messages appended to the stream since it was built.
+class ARROW_EXPORT StreamIndex {
+ public:
+  /// \brief Scan a stream and index all complete messages in it
+  ///
+  /// Only the metadata of the messages is read. A message cut short at the
+  /// end of the stream, such as one still being appended, is left out.
+  ///
+  /// \param[in] stream the stream, starting at position 0
+  /// \param[out] out the index
+  /// \return Status
+  static Status Build(io::RandomAccessFile* stream, std::shared_ptr<StreamIndex>* out);
+
+  /// \brief Index the messages added to the stream since the index was
+  /// built or last updated
+  ///
+  /// \param[in] stream the same stream the index was built from
+  /// \return Status
+  Status Update(io::RandomAccessFile* stream);
+
+  /// \brief Write the index as an Arrow file, to keep it beside the stream
+  ///
+  /// \param[in] sink the output stream
+  /// \return Status
+  Status WriteTo(io::OutputStream* sink) const;
+
+  /// \brief Read an index written with WriteTo
+  ///
+  /// \param[in] file the Arrow file holding the index
+  /// \param[out] out the index
+  /// \return Status
+  static Status ReadFrom(const std::shared_ptr<io::RandomAccessFile>& file,
+                         std::shared_ptr<StreamIndex>* out);
+
+  /// \brief All indexed messages, in stream order
+  const std::vector<StreamIndexEntry>& messages() const { return messages_; }
+
+  int num_record_batches() const { return static_cast<int>(record_batches_.size()); }
+
+  /// \brief The message of the i-th record batch
+  const StreamIndexEntry& record_batch(int i) const {
+    return messages_[record_batches_[i]];
+  }
+
+  /// \brief The total number of rows in the indexed record batches
+  int64_t num_rows() const { return row_offsets_.back(); }
+
+  /// \brief The position after the last indexed message
+  int64_t indexed_length() const { return indexed_length_; }
+
+  /// \brief Whether the end-of-stream marker was reached
+  bool complete() const { return complete_; }
+
+  /// \brief Find the record batch holding a row of the stream
+  ///
+  /// \param[in] row the row number, counting from the start of the stream
+  /// \param[out] batch_index the index of the record batch
+  /// \param[out] batch_row the row number within that batch
+  /// \return Status, Invalid if the row is not in the indexed batches
+  Status FindRow(int64_t row, int* batch_index, int64_t* batch_row) const;
+
+ private:
+  StreamIndex();
+
+  void AddMessage(const StreamIndexEntry& entry);
+
+  std::vector<StreamIndexEntry> messages_;
+
+  // Positions in messages_ of the record batches
+  std::vector<int> record_batches_;
+
+  // The first row of each record batch, followed by the total row count
+  std::vector<int64_t> row_offsets_;
+
+  int64_t indexed_length_;
+  bool complete_;
+};
+
+/// \class IndexedStreamReader
+/// \brief Reads the record batches of an IPC stream in any order using a
+/// StreamIndex
+class ARROW_EXPORT IndexedStreamReader {
+ public:
+  ~IndexedStreamReader();
+
+  /// \brief Open an indexed stream
+  ///
+  /// The schema and the dictionaries before the first record batch are read
+  /// from the start of the stream.
+  ///
+  /// \param[in] stream the stream the index was built from
+  /// \param[in] index the index of the stream
+  /// \param[out] out the reader
+  /// \return Status
+  static Status Open(const std::shared_ptr<io::RandomAccessFile>& stream,
+                     const std::shared_ptr<StreamIndex>& index,
+                     std::shared_ptr<IndexedStreamReader>* out);
+
+  /// \brief The schema read from the stream
+  std::shared_ptr<Schema> schema() const;
+
+  /// \brief The index used for reading
+  std::shared_ptr<StreamIndex> index() const;
+
+  /// \brief Returns the number of indexed record batches
+  int num_record_batches() const;
+
+  /// \brief Read a particular record batch from the stream. Does not copy
+  /// memory if the stream supports zero-copy.
+  ///
+  /// If dictionaries change between the record batches of the stream, the
+  /// dictionaries after each change are kept once they have been read. A
+  /// batch after a change is then read with only the dictionary batches
+  /// since the closest change already read; consecutive deltas to a
+  /// dictionary are concatenated with it at once.
+  ///
+  /// \param[in] i the index of the record batch to return
+  /// \param[out] batch the read batch
+  /// \return Status
+  Status ReadRecordBatch(int i, std::shared_ptr<RecordBatch>* batch);
+
+  /// \brief Read the record batch holding a row of the stream
+  ///
+  /// \param[in] row the row number, counting from the start of the stream
+  /// \param[out] batch the read batch
+  /// \param[out] batch_row the row number within that batch
+  /// \return Status, Invalid if the row is not in the indexed batches
+  Status ReadRecordBatchForRow(int64_t row, std::shared_ptr<RecordBatch>* batch,
+                               int64_t* batch_row);
+
+ private:
+  IndexedStreamReader();
+
+  // The dictionaries after a number of dictionary changes, and the schema
+  // holding them
+  struct DictionaryCheckpoint {
+    DictionaryMap dictionaries;
+    std::shared_ptr<Schema> schema;
+  };
+
+  // Record the dictionary batches after the first record batch in the
+  // messages indexed since the last call
+  void ScanDictionaryChanges();
+
+  // Get the schema for the record batches after num_changes dictionary
+  // changes, reading the dictionary batches since the closest checkpoint
+  Status GetSchemaAfterChanges(int num_changes, std::shared_ptr<Schema>* out);
+
+  std::shared_ptr<io::RandomAccessFile> stream_;
+  std::shared_ptr<StreamIndex> index_;
+  std::shared_ptr<Schema> schema_;
+
+  // Kept to rebuild the schema when dictionaries change
+  std::unique_ptr<Message> schema_message_;
+  DictionaryTypeMap dictionary_types_;
+
+  size_t scanned_messages_;
+  int scanned_batches_;
+
+  // For each dictionary change, a run of dictionary batches between record
+  // batches: the first record batch it applies to, and the positions of its
+  // dictionary batches in the index
+  std::vector<int> change_batches_;
+  std::vector<std::vector<size_t>> change_messages_;
+
+  // Keyed by the number of changes applied; 0 holds the initial dictionaries
+  std::map<int, DictionaryCheckpoint> checkpoints_;
+};
+
+}  // namespace ipc
+}  // namespace arrow
+
+#endif  // ARROW_IPC_STREAM_INDEX_H
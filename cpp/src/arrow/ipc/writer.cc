@@ -21,7 +21,10 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "arrow/array.h"
@@ -30,6 +33,8 @@
 #include "arrow/io/memory.h"
 #include "arrow/ipc/message.h"
 #include "arrow/ipc/metadata-internal.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/statistics.h"
 #include "arrow/ipc/util.h"
 #include "arrow/memory_pool.h"
 #include "arrow/status.h"
@@ -37,6 +42,7 @@
 #include "arrow/tensor.h"
 #include "arrow/type.h"
 #include "arrow/util/bit-util.h"
+#include "arrow/util/key_value_metadata.h"
 #include "arrow/util/logging.h"
 
 namespace arrow {
@@ -44,6 +50,9 @@ namespace ipc {
 
 using internal::FileBlock;
 using internal::kArrowMagicBytes;
+using internal::kStatisticsBodyLengthKey;
+using internal::kStatisticsMetadataLengthKey;
+using internal::kStatisticsOffsetKey;
 
 // ----------------------------------------------------------------------
 // Record batch write path
@@ -131,7 +140,8 @@ class RecordBatchSerializer : public ArrayVisitor {
     return arr.Accept(this);
   }
 
-  Status Assemble(const RecordBatch& batch, int64_t* body_length) {
+  // Collect the field nodes and buffers of the batch
+  Status VisitBatch(const RecordBatch& batch) {
     if (field_nodes_.size() > 0) {
       field_nodes_.clear();
       buffer_meta_.clear();
@@ -142,6 +152,11 @@ class RecordBatchSerializer : public ArrayVisitor {
     for (int i = 0; i < batch.num_columns(); ++i) {
       RETURN_NOT_OK(VisitArray(*batch.column(i)));
     }
+    return Status::OK();
+  }
+
+  Status Assemble(const RecordBatch& batch, int64_t* body_length) {
+    RETURN_NOT_OK(VisitBatch(batch));
 
     // The position for the start of a buffer relative to the passed frame of
     // reference. May be 0 or some other position in an address space
@@ -509,13 +524,15 @@ class DictionaryWriter : public RecordBatchSerializer {
 
   Status WriteMetadataMessage(int64_t num_rows, int64_t body_length,
                               std::shared_ptr<Buffer>* out) override {
-    return WriteDictionaryMessage(dictionary_id_, num_rows, body_length, field_nodes_,
-                                  buffer_meta_, out);
+    return WriteDictionaryMessage(dictionary_id_, is_delta_, num_rows, body_length,
+                                  field_nodes_, buffer_meta_, out);
   }
 
   Status Write(int64_t dictionary_id, const std::shared_ptr<Array>& dictionary,
-               io::OutputStream* dst, int32_t* metadata_length, int64_t* body_length) {
+               bool is_delta, io::OutputStream* dst, int32_t* metadata_length,
+               int64_t* body_length) {
     dictionary_id_ = dictionary_id;
+    is_delta_ = is_delta;
 
     // Make a dummy record batch. A bit tedious as we have to make a schema
     std::vector<std::shared_ptr<Field>> fields = {
@@ -529,6 +546,7 @@ class DictionaryWriter : public RecordBatchSerializer {
  private:
   // TODO(wesm): Setting this in Write is a bit unclean, but it works
   int64_t dictionary_id_;
+  bool is_delta_;
 };
 
 // Adds padding bytes if necessary to ensure all memory blocks are written on
@@ -632,10 +650,11 @@ Status WriteTensor(const Tensor& tensor, io::OutputStream* dst, int32_t* metadat
 }
 
 Status WriteDictionary(int64_t dictionary_id, const std::shared_ptr<Array>& dictionary,
-                       int64_t buffer_start_offset, io::OutputStream* dst,
+                       bool is_delta, int64_t buffer_start_offset, io::OutputStream* dst,
                        int32_t* metadata_length, int64_t* body_length, MemoryPool* pool) {
   DictionaryWriter writer(pool, buffer_start_offset, kMaxNestingDepth, false);
-  return writer.Write(dictionary_id, dictionary, dst, metadata_length, body_length);
+  return writer.Write(dictionary_id, dictionary, is_delta, dst, metadata_length,
+                      body_length);
 }
 
 Status GetRecordBatchSize(const RecordBatch& batch, int64_t* size) {
@@ -741,8 +760,9 @@ class SchemaWriter : public StreamBookKeeper {
 
       // Frame of reference in file format is 0, see ARROW-384
       const int64_t buffer_start_offset = 0;
-      RETURN_NOT_OK(WriteDictionary(entry.first, entry.second, buffer_start_offset, sink_,
-                                    &block->metadata_length, &block->body_length, pool_));
+      RETURN_NOT_OK(WriteDictionary(entry.first, entry.second, false, buffer_start_offset,
+                                    sink_, &block->metadata_length, &block->body_length,
+                                    pool_));
       RETURN_NOT_OK(UpdatePosition());
       DCHECK(position_ % 8 == 0) << "WriteDictionary did not perform aligned writes";
     }
@@ -798,8 +818,90 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl : public StreamBookKe
     return Status::OK();
   }
 
+  // Write a dictionary batch with the entries added to a dictionary or
+  // replacing it
+  virtual Status WriteDictionaryChange(int64_t id,
+                                       const std::shared_ptr<Array>& dictionary,
+                                       bool is_delta) {
+    RETURN_NOT_OK(UpdatePosition());
+    FileBlock block = {position_, 0, 0};
+
+    // Frame of reference in file format is 0, see ARROW-384
+    const int64_t buffer_start_offset = 0;
+    RETURN_NOT_OK(WriteDictionary(id, dictionary, is_delta, buffer_start_offset, sink_,
+                                  &block.metadata_length, &block.body_length, pool_));
+    RETURN_NOT_OK(UpdatePosition());
+    DCHECK(position_ % 8 == 0) << "WriteDictionary did not perform aligned writes";
+
+    dictionaries_.push_back(block);
+    return Status::OK();
+  }
+
+  // Compare the dictionaries of the top-level dictionary columns of a batch
+  // with the ones last written for their ids. When the old dictionary is a
+  // prefix of the new one only the new entries are written as a delta,
+  // otherwise the whole dictionary is written again
+  Status WriteDictionaryChanges(const RecordBatch& batch) {
+    std::unordered_map<int64_t, std::shared_ptr<Array>> batch_dictionaries;
+    for (int i = 0; i < schema_->num_fields(); ++i) {
+      const DataType& field_type = *schema_->field(i)->type();
+      if (field_type.id() != Type::DICTIONARY) {
+        continue;
+      }
+      const DataType& column_type = *batch.column(i)->type();
+      if (column_type.id() != Type::DICTIONARY) {
+        return Status::Invalid("Dictionary field must have a dictionary-encoded column");
+      }
+      const std::shared_ptr<Array>& dictionary =
+          static_cast<const DictionaryType&>(column_type).dictionary();
+      const int64_t id = dictionary_memo_.GetId(
+          static_cast<const DictionaryType&>(field_type).dictionary());
+
+      auto inserted = batch_dictionaries.insert({id, dictionary});
+      if (!inserted.second) {
+        if (inserted.first->second.get() != dictionary.get() &&
+            !inserted.first->second->Equals(dictionary)) {
+          return Status::Invalid(
+              "Columns sharing a dictionary must have the same dictionary in a batch");
+        }
+        continue;
+      }
+
+      auto it = written_dictionaries_.find(id);
+      if (it == written_dictionaries_.end()) {
+        std::shared_ptr<Array> initial;
+        RETURN_NOT_OK(dictionary_memo_.GetDictionary(id, &initial));
+        it = written_dictionaries_.insert({id, initial}).first;
+      }
+      const std::shared_ptr<Array>& written = it->second;
+      if (written.get() == dictionary.get()) {
+        continue;
+      }
+      if (!dictionary->type()->Equals(*written->type())) {
+        return Status::Invalid("Dictionary values must keep the type of the schema");
+      }
+
+      const int64_t written_length = written->length();
+      if (dictionary->length() == written_length && dictionary->Equals(written)) {
+        // Remember the new array to skip the comparison for the next batch
+        it->second = dictionary;
+        continue;
+      }
+      if (dictionary->length() > written_length &&
+          dictionary->RangeEquals(0, written_length, 0, written)) {
+        RETURN_NOT_OK(
+            WriteDictionaryChange(id, dictionary->Slice(written_length), true));
+      } else {
+        RETURN_NOT_OK(WriteDictionaryChange(id, dictionary, false));
+      }
+      it->second = dictionary;
+    }
+    return Status::OK();
+  }
+
   Status WriteRecordBatch(const RecordBatch& batch, bool allow_64bit, FileBlock* block) {
     RETURN_NOT_OK(CheckStarted());
+    RETURN_NOT_OK(WriteDictionaryChanges(batch));
     RETURN_NOT_OK(UpdatePosition());
 
     block->offset = position_;
@@ -817,10 +919,11 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl : public StreamBookKe
   }
 
   Status WriteRecordBatch(const RecordBatch& batch, bool allow_64bit) {
-    // Push an empty FileBlock. Can be written in the footer later
-    record_batches_.push_back({0, 0, 0});
-    return WriteRecordBatch(batch, allow_64bit,
-                            &record_batches_[record_batches_.size() - 1]);
+    // Only a batch that was written gets a block in the footer
+    FileBlock block = {0, 0, 0};
+    RETURN_NOT_OK(WriteRecordBatch(batch, allow_64bit, &block));
+    record_batches_.push_back(block);
+    return Status::OK();
   }
 
   void set_memory_pool(MemoryPool* pool) { pool_ = pool; }
@@ -834,6 +937,9 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl : public StreamBookKe
   // encounter, as they must be written out first in the stream
   DictionaryMemo dictionary_memo_;
 
+  // The dictionary each id stands for in the batches written so far
+  std::unordered_map<int64_t, std::shared_ptr<Array>> written_dictionaries_;
+
   std::vector<FileBlock> dictionaries_;
   std::vector<FileBlock> record_batches_;
 };
@@ -866,13 +972,114 @@ Status RecordBatchStreamWriter::Close() { return impl_->Close(); }
 // ----------------------------------------------------------------------
 // File writer implementation
 
+// Whether batches of the given schema can be appended to a file of file_schema.
+// The dictionaries of the fields may differ; WriteDictionaryChanges writes the
+// new entries of a dictionary as a delta and rejects other changes
+static bool IsAppendableSchema(const Schema& schema, const Schema& file_schema) {
+  if (schema.num_fields() != file_schema.num_fields()) {
+    return false;
+  }
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    const Field& field = *schema.field(i);
+    const std::shared_ptr<Field>& file_field = file_schema.field(i);
+    if (field.type()->id() != Type::DICTIONARY ||
+        file_field->type()->id() != Type::DICTIONARY) {
+      if (!field.Equals(file_field)) {
+        return false;
+      }
+      continue;
+    }
+    const auto& type = static_cast<const DictionaryType&>(*field.type());
+    const auto& file_type = static_cast<const DictionaryType&>(*file_field->type());
+    Field with_file_type(field.name(), file_field->type(), field.nullable(),
+                         field.metadata());
+    if (!with_file_type.Equals(file_field) ||
+        !type.index_type()->Equals(*file_type.index_type()) ||
+        type.ordered() != file_type.ordered()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class RecordBatchFileWriter::RecordBatchFileWriterImpl
     : public RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
  public:
   using BASE = RecordBatchStreamWriter::RecordBatchStreamWriterImpl;
 
-  RecordBatchFileWriterImpl(io::OutputStream* sink, const std::shared_ptr<Schema>& schema)
-      : BASE(sink, schema) {}
+  RecordBatchFileWriterImpl(io::OutputStream* sink, const std::shared_ptr<Schema>& schema,
+                            const IpcWriteOptions& options)
+      : BASE(sink, schema), options_(options), appending_(false) {}
+
+  // Continue an existing file of file_size bytes, whose schema and
+  // dictionaries are already written, instead of starting a new one
+  Status StartAppend(int64_t file_size, const Buffer& footer,
+                     const std::vector<RecordBatchStatistics>& statistics) {
+    RETURN_NOT_OK(UpdatePosition());
+    if (position_ != file_size) {
+      return Status::Invalid(
+          "Output stream must be positioned at the end of the file to append to");
+    }
+    RETURN_NOT_OK(Align());
+    internal::GetFileBlocks(footer, &dictionaries_, &record_batches_);
+
+    // Assign the dictionary ids of the file's schema
+    std::shared_ptr<Buffer> schema_fb;
+    RETURN_NOT_OK(internal::WriteSchemaMessage(*schema_, &dictionary_memo_, &schema_fb));
+    started_ = true;
+    appending_ = true;
+    statistics_ = statistics;
+    return Status::OK();
+  }
+
+  Status WriteRecordBatch(const RecordBatch& batch, bool allow_64bit) {
+    if (appending_ && !IsAppendableSchema(*batch.schema(), *schema_)) {
+      return Status::Invalid(
+          "Appended record batch does not have the schema of the file");
+    }
+    RETURN_NOT_OK(BASE::WriteRecordBatch(batch, allow_64bit));
+    if (options_.write_statistics) {
+      statistics_.emplace_back();
+      RETURN_NOT_OK(ComputeStatistics(batch, pool_, &statistics_.back()));
+    }
+    return Status::OK();
+  }
+
+  // Write the statistics of all record batches as one more record batch,
+  // which the footer metadata points to
+  Status WriteStatistics(KeyValueMetadata* footer_metadata) {
+    std::shared_ptr<RecordBatch> batch;
+    RETURN_NOT_OK(MakeStatisticsBatch(*schema_, statistics_, pool_, &batch));
+
+    RETURN_NOT_OK(UpdatePosition());
+    FileBlock block = {position_, 0, 0};
+
+    // Frame of reference in file format is 0, see ARROW-384
+    const int64_t buffer_start_offset = 0;
+    RETURN_NOT_OK(arrow::ipc::WriteRecordBatch(
+        *batch, buffer_start_offset, sink_, &block.metadata_length, &block.body_length,
+        pool_, kMaxNestingDepth, true));
+    RETURN_NOT_OK(UpdatePosition());
+
+    footer_metadata->Append(kStatisticsOffsetKey, std::to_string(block.offset));
+    footer_metadata->Append(kStatisticsMetadataLengthKey,
+                            std::to_string(block.metadata_length));
+    footer_metadata->Append(kStatisticsBodyLengthKey, std::to_string(block.body_length));
+    return Status::OK();
+  }
+
+  Status WriteDictionaryChange(int64_t id, const std::shared_ptr<Array>& dictionary,
+                               bool is_delta) override {
+    // The footer lists the dictionaries for all record batches of the file,
+    // so a dictionary can only be extended
+    if (!is_delta) {
+      std::stringstream ss;
+      ss << "Dictionary with id " << id
+         << " was replaced, which the file format does not support";
+      return Status::Invalid(ss.str());
+    }
+    return BASE::WriteDictionaryChange(id, dictionary, is_delta);
+  }
 
   Status Start() override {
     // It is only necessary to align to 8-byte boundary at the start of the file
@@ -887,11 +1094,16 @@ class RecordBatchFileWriter::RecordBatchFileWriterImpl
 
   Status Close() override {
     // Write metadata
+    std::shared_ptr<KeyValueMetadata> footer_metadata;
+    if (options_.write_statistics && !statistics_.empty()) {
+      footer_metadata = std::make_shared<KeyValueMetadata>();
+      RETURN_NOT_OK(WriteStatistics(footer_metadata.get()));
+    }
     RETURN_NOT_OK(UpdatePosition());
 
     int64_t initial_position = position_;
     RETURN_NOT_OK(WriteFileFooter(*schema_, dictionaries_, record_batches_,
-                                  &dictionary_memo_, sink_));
+                                  &dictionary_memo_, footer_metadata.get(), sink_));
     RETURN_NOT_OK(UpdatePosition());
 
     // Write footer length
@@ -908,6 +1120,13 @@ class RecordBatchFileWriter::RecordBatchFileWriterImpl
     return Write(reinterpret_cast<const uint8_t*>(kArrowMagicBytes),
                  strlen(kArrowMagicBytes));
   }
+
+ private:
+  IpcWriteOptions options_;
+  bool appending_;
+
+  // The statistics of each record batch when writing them
+  std::vector<RecordBatchStatistics> statistics_;
 };
 
 RecordBatchFileWriter::RecordBatchFileWriter() {}
@@ -917,9 +1136,45 @@ RecordBatchFileWriter::~RecordBatchFileWriter() {}
 Status RecordBatchFileWriter::Open(io::OutputStream* sink,
                                    const std::shared_ptr<Schema>& schema,
                                    std::shared_ptr<RecordBatchWriter>* out) {
+  return Open(sink, schema, IpcWriteOptions::Defaults(), out);
+}
+
+Status RecordBatchFileWriter::Open(io::OutputStream* sink,
+                                   const std::shared_ptr<Schema>& schema,
+                                   const IpcWriteOptions& options,
+                                   std::shared_ptr<RecordBatchWriter>* out) {
   // ctor is private
   auto result = std::shared_ptr<RecordBatchFileWriter>(new RecordBatchFileWriter());
-  result->impl_.reset(new RecordBatchFileWriterImpl(sink, schema));
+  result->impl_.reset(new RecordBatchFileWriterImpl(sink, schema, options));
+  *out = result;
+  return Status::OK();
+}
+
+Status RecordBatchFileWriter::OpenForAppend(io::RandomAccessFile* file,
+                                            io::OutputStream* sink,
+                                            std::shared_ptr<RecordBatchWriter>* out) {
+  int64_t file_size;
+  RETURN_NOT_OK(file->GetSize(&file_size));
+
+  // The reader reconstructs the schema with its dictionaries, which the new
+  // footer must describe in the same way
+  std::shared_ptr<RecordBatchFileReader> reader;
+  RETURN_NOT_OK(RecordBatchFileReader::Open(file, file_size, &reader));
+  std::shared_ptr<Buffer> footer;
+  RETURN_NOT_OK(internal::ReadFileFooter(file, file_size, &footer));
+
+  // Keep the statistics of the existing batches
+  IpcWriteOptions options;
+  std::vector<RecordBatchStatistics> statistics;
+  if (reader->has_statistics()) {
+    options.write_statistics = true;
+    RETURN_NOT_OK(reader->ReadStatistics(&statistics));
+  }
+
+  // ctor is private
+  auto result = std::shared_ptr<RecordBatchFileWriter>(new RecordBatchFileWriter());
+  result->impl_.reset(new RecordBatchFileWriterImpl(sink, reader->schema(), options));
+  RETURN_NOT_OK(result->impl_->StartAppend(file_size, *footer, statistics));
   *out = result;
   return Status::OK();
 }
@@ -955,6 +1210,28 @@ Status SerializeRecordBatch(const RecordBatch& batch, MemoryPool* pool,
                           kMaxNestingDepth, true);
 }
 
+Status SerializeRecordBatch(const RecordBatch& batch, MemoryPool* pool,
+                            const std::shared_ptr<Buffer>& region, int memcopy_threads,
+                            int64_t* message_length) {
+  if (!region->is_mutable()) {
+    return Status::Invalid("Region to write the record batch to is not mutable");
+  }
+  int64_t size = 0;
+  RETURN_NOT_OK(GetRecordBatchSize(batch, &size));
+  if (size > region->size()) {
+    std::stringstream ss;
+    ss << "Record batch message of " << size << " bytes does not fit in a region of "
+       << region->size() << " bytes";
+    return Status::Invalid(ss.str());
+  }
+
+  io::FixedSizeBufferWriter stream(region);
+  stream.set_memcopy_threads(memcopy_threads);
+  RETURN_NOT_OK(SerializeRecordBatch(batch, pool, &stream));
+  *message_length = size;
+  return Status::OK();
+}
+
 Status SerializeSchema(const Schema& schema, MemoryPool* pool,
                        std::shared_ptr<Buffer>* out) {
   std::shared_ptr<io::BufferOutputStream> stream;
@@ -970,5 +1247,290 @@ Status SerializeSchema(const Schema& schema, MemoryPool* pool,
   return stream->Finish(out);
 }
 
+// ----------------------------------------------------------------------
+// Writing in place into a memory region
+
+// Allocates by bumping an offset into the body of a region. Freeing or
+// reallocating the most recent allocation reuses its space, like in
+// ArenaMemoryPool. Once the batch is written, the body is sealed: freed
+// buffers must not give their space back to the pool
+class RegionMemoryPool : public MemoryPool {
+ public:
+  RegionMemoryPool(uint8_t* data, int64_t size)
+      : data_(data),
+        size_(size),
+        offset_(0),
+        last_allocation_(nullptr),
+        sealed_(false),
+        bytes_allocated_(0),
+        max_memory_(0) {}
+
+  Status Allocate(int64_t size, uint8_t** out) override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return AllocateUnlocked(size, out);
+  }
+
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (sealed_) {
+      return Status::Invalid("Record batch was already written to the region");
+    }
+    if (*ptr == last_allocation_) {
+      // The most recent allocation can grow into the free space after it
+      const int64_t end = (last_allocation_ - data_) + AllocationSize(new_size);
+      if (end <= size_) {
+        offset_ = end;
+        UpdateBytesAllocated(new_size - old_size);
+        return Status::OK();
+      }
+    } else if (new_size <= old_size) {
+      UpdateBytesAllocated(new_size - old_size);
+      return Status::OK();
+    }
+    uint8_t* out;
+    RETURN_NOT_OK(AllocateUnlocked(new_size, &out));
+    std::memcpy(out, *ptr, static_cast<size_t>(std::min(old_size, new_size)));
+    UpdateBytesAllocated(-old_size);
+    *ptr = out;
+    return Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!sealed_ && buffer != nullptr && buffer == last_allocation_) {
+      offset_ = last_allocation_ - data_;
+      last_allocation_ = nullptr;
+    }
+    UpdateBytesAllocated(-size);
+  }
+
+  int64_t bytes_allocated() const override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return bytes_allocated_;
+  }
+
+  int64_t max_memory() const override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return max_memory_;
+  }
+
+  // The offset of size bytes at data in the allocated part of the body, if
+  // they lie there on an 8-byte boundary
+  bool Contains(const uint8_t* data, int64_t size, int64_t* offset) const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (data < data_ || data + size > data_ + offset_ || (data - data_) % 8 != 0) {
+      return false;
+    }
+    *offset = data - data_;
+    return true;
+  }
+
+  // Stop allocating and return the length of the body
+  int64_t Seal() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    sealed_ = true;
+    return offset_;
+  }
+
+  const uint8_t* data() const { return data_; }
+
+ private:
+  // Every allocation takes at least 64 bytes so that no two of them share an
+  // address, and its padding stays inside the allocation
+  static int64_t AllocationSize(int64_t size) {
+    return std::max<int64_t>(kArrowAlignment, BitUtil::RoundUpToMultipleOf64(size));
+  }
+
+  Status AllocateUnlocked(int64_t size, uint8_t** out) {
+    if (sealed_) {
+      return Status::Invalid("Record batch was already written to the region");
+    }
+    // The region itself may not start on a 64-byte boundary
+    const int64_t address =
+        static_cast<int64_t>(reinterpret_cast<uintptr_t>(data_ + offset_));
+    const int64_t padding = BitUtil::RoundUpToMultipleOf64(address) - address;
+    const int64_t allocation_size = AllocationSize(size);
+    if (size < 0 || allocation_size > size_ - offset_ - padding) {
+      std::stringstream ss;
+      ss << "Region has no room left for " << size << " bytes, " << (size_ - offset_)
+         << " of " << size_ << " bytes are free";
+      return Status::OutOfMemory(ss.str());
+    }
+    *out = data_ + offset_ + padding;
+    offset_ += padding + allocation_size;
+    last_allocation_ = *out;
+    UpdateBytesAllocated(size);
+    return Status::OK();
+  }
+
+  void UpdateBytesAllocated(int64_t diff) {
+    bytes_allocated_ += diff;
+    max_memory_ = std::max(max_memory_, bytes_allocated_);
+  }
+
+  uint8_t* data_;
+  const int64_t size_;
+
+  mutable std::mutex mutex_;
+  int64_t offset_;
+  uint8_t* last_allocation_;
+  bool sealed_;
+  int64_t bytes_allocated_;
+  int64_t max_memory_;
+};
+
+// Lays out the buffers of a record batch in the body of a region. The
+// buffers that already lie in the body stay where they are, the others are
+// copied to new allocations in it. Temporary buffers, e.g. for bitmaps of
+// sliced arrays, are allocated in the body in the first place
+class RegionRecordBatchSerializer : public RecordBatchSerializer {
+ public:
+  RegionRecordBatchSerializer(RegionMemoryPool* pool, io::FixedSizeBufferWriter* region,
+                              int64_t body_start)
+      : RecordBatchSerializer(pool, 0, kMaxNestingDepth, true),
+        region_pool_(pool),
+        region_(region),
+        body_start_(body_start) {}
+
+  Status Assemble(const RecordBatch& batch, int64_t* body_length) {
+    RETURN_NOT_OK(VisitBatch(batch));
+
+    const int32_t kNoPageId = -1;
+    buffer_meta_.reserve(buffers_.size());
+    for (const auto& buffer : buffers_) {
+      // The buffer might be null if we are handling zero row lengths.
+      const int64_t size = buffer ? buffer->size() : 0;
+      const int64_t padded_size = BitUtil::RoundUpToMultipleOf8(size);
+      int64_t offset = 0;
+      if (size > 0 && !region_pool_->Contains(buffer->data(), size, &offset)) {
+        uint8_t* data;
+        RETURN_NOT_OK(region_pool_->Allocate(size, &data));
+        offset = data - region_pool_->data();
+        RETURN_NOT_OK(region_->WriteAt(body_start_ + offset, buffer->data(), size));
+        if (padded_size > size) {
+          RETURN_NOT_OK(region_->WriteAt(body_start_ + offset + size, kPaddingBytes,
+                                         padded_size - size));
+        }
+      }
+      buffer_meta_.push_back({kNoPageId, offset, padded_size});
+    }
+
+    // Everything allocated from the pool is part of the body
+    *body_length = region_pool_->Seal();
+    return Status::OK();
+  }
+
+ private:
+  RegionMemoryPool* region_pool_;
+  io::FixedSizeBufferWriter* region_;
+  int64_t body_start_;
+};
+
+class RecordBatchRegionWriter::RecordBatchRegionWriterImpl {
+ public:
+  RecordBatchRegionWriterImpl(const std::shared_ptr<Buffer>& region,
+                              int64_t metadata_capacity)
+      : region_(region),
+        metadata_capacity_(metadata_capacity),
+        pool_(region->mutable_data() + metadata_capacity,
+              region->size() - metadata_capacity),
+        writer_(region),
+        written_(false) {}
+
+  MemoryPool* pool() { return &pool_; }
+
+  void set_memcopy_threads(int num_threads) { writer_.set_memcopy_threads(num_threads); }
+
+  void set_memcopy_threshold(int64_t threshold) {
+    writer_.set_memcopy_threshold(threshold);
+  }
+
+  Status WriteRecordBatch(const RecordBatch& batch, int64_t* message_length) {
+    if (written_) {
+      return Status::Invalid("Record batch was already written to the region");
+    }
+    written_ = true;
+
+    RegionRecordBatchSerializer serializer(&pool_, &writer_, metadata_capacity_);
+    int64_t body_length = 0;
+    RETURN_NOT_OK(serializer.Assemble(batch, &body_length));
+
+    std::shared_ptr<Buffer> metadata;
+    RETURN_NOT_OK(
+        serializer.WriteMetadataMessage(batch.num_rows(), body_length, &metadata));
+    const int64_t metadata_size =
+        static_cast<int64_t>(sizeof(int32_t)) + metadata->size();
+    if (metadata_size > metadata_capacity_) {
+      std::stringstream ss;
+      ss << "Record batch metadata of " << metadata_size
+         << " bytes does not fit in the " << metadata_capacity_
+         << " bytes reserved for it";
+      return Status::Invalid(ss.str());
+    }
+
+    // The flatbuffer size prefix counts the padding up to the body as well
+    uint8_t* data = region_->mutable_data();
+    const int32_t flatbuffer_size = static_cast<int32_t>(metadata_capacity_) - 4;
+    std::memcpy(data, &flatbuffer_size, sizeof(int32_t));
+    std::memcpy(data + sizeof(int32_t), metadata->data(),
+                static_cast<size_t>(metadata->size()));
+    std::memset(data + metadata_size, 0,
+                static_cast<size_t>(metadata_capacity_ - metadata_size));
+
+    *message_length = metadata_capacity_ + body_length;
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<Buffer> region_;
+  int64_t metadata_capacity_;
+  RegionMemoryPool pool_;
+  io::FixedSizeBufferWriter writer_;
+  bool written_;
+};
+
+RecordBatchRegionWriter::RecordBatchRegionWriter() {}
+
+RecordBatchRegionWriter::~RecordBatchRegionWriter() {}
+
+Status RecordBatchRegionWriter::Open(const std::shared_ptr<Buffer>& region,
+                                     int64_t metadata_capacity,
+                                     std::unique_ptr<RecordBatchRegionWriter>* out) {
+  if (!region->is_mutable()) {
+    return Status::Invalid("Region to write the record batch to is not mutable");
+  }
+  if (reinterpret_cast<uintptr_t>(region->data()) % 8 != 0) {
+    return Status::Invalid("Region to write the record batch to is not 8-byte aligned");
+  }
+  if (metadata_capacity < 8 || metadata_capacity % 8 != 0 ||
+      metadata_capacity >= region->size()) {
+    std::stringstream ss;
+    ss << "Cannot reserve " << metadata_capacity
+       << " bytes for the metadata in a region of " << region->size()
+       << " bytes, it must be a multiple of 8 less than the region size";
+    return Status::Invalid(ss.str());
+  }
+
+  // Private ctor
+  out->reset(new RecordBatchRegionWriter());
+  (*out)->impl_.reset(new RecordBatchRegionWriterImpl(region, metadata_capacity));
+  return Status::OK();
+}
+
+MemoryPool* RecordBatchRegionWriter::pool() { return impl_->pool(); }
+
+void RecordBatchRegionWriter::set_memcopy_threads(int num_threads) {
+  impl_->set_memcopy_threads(num_threads);
+}
+
+void RecordBatchRegionWriter::set_memcopy_threshold(int64_t threshold) {
+  impl_->set_memcopy_threshold(threshold);
+}
+
+Status RecordBatchRegionWriter::WriteRecordBatch(const RecordBatch& batch,
+                                                 int64_t* message_length) {
+  return impl_->WriteRecordBatch(batch, message_length);
+}
+
 }  // namespace ipc
 }  // namespace arrow
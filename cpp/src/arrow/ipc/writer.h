@@ -43,11 +43,26 @@ class Tensor;
 namespace io {
 
 class OutputStream;
+class RandomAccessFile;
 
 }  // namespace io
 
 namespace ipc {
 
+/// \brief Options for writing record batches to files
+struct ARROW_EXPORT IpcWriteOptions {
+  IpcWriteOptions() : write_statistics(false) {}
+
+  /// \brief Compute the statistics of each record batch, see
+  /// ComputeStatistics, and store them in the file
+  ///
+  /// RecordBatchFileReader::SelectRecordBatches uses them to skip batches
+  /// that cannot match a query.
+  bool write_statistics;
+
+  static IpcWriteOptions Defaults() { return IpcWriteOptions(); }
+};
+
 /// \class RecordBatchWriter
 /// \brief Abstract interface for writing a stream of record batches
 class ARROW_EXPORT RecordBatchWriter {
@@ -96,6 +111,12 @@ class ARROW_EXPORT RecordBatchStreamWriter : public RecordBatchWriter {
 
   /// \brief Write a record batch to the stream
   ///
+  /// The dictionaries of the schema are written before the first batch. When
+  /// a top-level dictionary column of a batch has a different dictionary than
+  /// the one last written, the new dictionary is written before the batch: as
+  /// a delta holding only the new entries if it extends the old one, or else
+  /// as a replacement.
+  ///
   /// \param[in] batch the record batch to write
   /// \param[in] allow_64bit allow array lengths over INT32_MAX - 1
   /// \return Status
@@ -131,8 +152,55 @@ class ARROW_EXPORT RecordBatchFileWriter : public RecordBatchStreamWriter {
   static Status Open(io::OutputStream* sink, const std::shared_ptr<Schema>& schema,
                      std::shared_ptr<RecordBatchWriter>* out);
 
+  /// Create a new writer from stream sink and schema
+  ///
+  /// \param[in] sink output stream to write to
+  /// \param[in] schema the schema of the record batches to be written
+  /// \param[in] options options for writing the file
+  /// \param[out] out the created stream writer
+  /// \return Status
+  static Status Open(io::OutputStream* sink, const std::shared_ptr<Schema>& schema,
+                     const IpcWriteOptions& options,
+                     std::shared_ptr<RecordBatchWriter>* out);
+
+  /// \brief Create a writer that appends record batches to an existing file
+  ///
+  /// The new record batches are written after the current end of the file,
+  /// and Close writes a new footer listing both the existing and the new
+  /// batches. The existing bytes, including the old footer, are left as they
+  /// are, so after one append the file is laid out as
+  ///
+  ///     ARROW1 <padding> <schema> <dictionaries> <batches>
+  ///         <footer 1> <int32 footer 1 length> ARROW1
+  ///         <padding> <appended dictionary deltas and batches>
+  ///         <footer 2> <int32 footer 2 length> ARROW1
+  ///
+  /// Readers only follow the last footer, whose blocks point into both
+  /// parts; the old footer is skipped over like padding. Unlike a file
+  /// written in one go, the file is therefore not an Arrow stream after its
+  /// leading magic bytes.
+  ///
+  /// Until Close has written the new footer, the first file_size bytes are
+  /// still a valid Arrow file. After an interrupted append,
+  /// RecordBatchFileReader::FindFooterOffset finds their end, to pass as
+  /// footer_offset to RecordBatchFileReader::Open.
+  ///
+  /// \param[in] file the existing file, to read its footer from
+  /// \param[in] sink output stream positioned at the end of the same file,
+  /// e.g. a FileOutputStream opened in append mode
+  /// \param[out] out the created writer. Appended batches must have the
+  /// schema of the file, except that their dictionaries may extend the ones
+  /// of the file, which is then written as a delta. If the file stores
+  /// statistics, they are computed for the appended batches as well
+  /// \return Status
+  static Status OpenForAppend(io::RandomAccessFile* file, io::OutputStream* sink,
+                              std::shared_ptr<RecordBatchWriter>* out);
+
   /// \brief Write a record batch to the file
   ///
+  /// Dictionaries may be extended as in the stream format, but not replaced,
+  /// as the dictionaries apply to all batches of the file.
+  ///
   /// \param[in] batch the record batch to write
   /// \param[in] allow_64bit allow array lengths over INT32_MAX - 1
   /// \return Status
@@ -204,6 +272,81 @@ ARROW_EXPORT
 Status SerializeRecordBatch(const RecordBatch& batch, MemoryPool* pool,
                             io::OutputStream* out);
 
+/// \brief Write record batch as encapsulated IPC message directly into a
+/// mutable memory region, such as a memory map or a shared memory object
+///
+/// \param[in] batch the record batch to write
+/// \param[in] pool a MemoryPool to use for temporary allocations, if needed
+/// \param[in] region the mutable region to write the message to, of at least
+/// GetRecordBatchSize bytes
+/// \param[in] memcopy_threads the number of threads copying each buffer of
+/// 1MB or more into the region
+/// \param[out] message_length the number of bytes written at the start of the
+/// region
+/// \return Status, Invalid if the region is not mutable or too small
+ARROW_EXPORT
+Status SerializeRecordBatch(const RecordBatch& batch, MemoryPool* pool,
+                            const std::shared_ptr<Buffer>& region, int memcopy_threads,
+                            int64_t* message_length);
+
+/// \class RecordBatchRegionWriter
+/// \brief Lays out a record batch as encapsulated IPC message in place in a
+/// mutable memory region
+///
+/// The start of the region is reserved for the message metadata and the rest
+/// holds the message body. Arrays built with pool() have their buffers
+/// allocated in the body already, so writing a batch of them only writes its
+/// metadata. Buffers of the batch that lie outside the region are copied
+/// into the body, the large ones with several threads.
+///
+/// The writer must outlive the arrays allocated from its pool, and the
+/// region the messages read from it.
+class ARROW_EXPORT RecordBatchRegionWriter {
+ public:
+  ~RecordBatchRegionWriter();
+
+  /// \brief Create a writer for a region
+  ///
+  /// \param[in] region the mutable region, 8-byte aligned
+  /// \param[in] metadata_capacity the number of bytes at the start of the
+  /// region to reserve for the metadata, a multiple of 8
+  /// \param[out] out the writer
+  /// \return Status, Invalid if the region is unsuitable
+  static Status Open(const std::shared_ptr<Buffer>& region, int64_t metadata_capacity,
+                     std::unique_ptr<RecordBatchRegionWriter>* out);
+
+  /// \brief A memory pool allocating from the body of the region
+  ///
+  /// Allocations fail with OutOfMemory once the region is full and with
+  /// Invalid after the batch is written.
+  MemoryPool* pool();
+
+  /// \brief Set the number of threads copying large buffers into the region
+  void set_memcopy_threads(int num_threads);
+
+  /// \brief Set the size from which buffers are copied with several threads
+  void set_memcopy_threshold(int64_t threshold);
+
+  /// \brief Write the metadata of a record batch and copy those of its
+  /// buffers that are not in the region yet
+  ///
+  /// The message occupies the first message_length bytes of the region and
+  /// reads like any other, e.g. with ReadRecordBatch. Only one batch can be
+  /// written.
+  ///
+  /// \param[in] batch the record batch to write
+  /// \param[out] message_length the length of the message
+  /// \return Status, Invalid if the metadata does not fit in the space
+  /// reserved for it, OutOfMemory if the copied buffers do not fit
+  Status WriteRecordBatch(const RecordBatch& batch, int64_t* message_length);
+
+ private:
+  RecordBatchRegionWriter();
+
+  class ARROW_NO_EXPORT RecordBatchRegionWriterImpl;
+  std::unique_ptr<RecordBatchRegionWriterImpl> impl_;
+};
+
 /// \brief Serialize schema using stream writer as a sequence of one or more
 /// IPC messages
 ///
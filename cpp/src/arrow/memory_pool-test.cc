@@ -15,7 +15,20 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include <gtest/gtest.h>
 
@@ -91,4 +104,441 @@ TEST(LoggingMemoryPool, Logging) {
 
   ASSERT_EQ(200, pool->max_memory());
 }
+
+class TestThreadCachingMemoryPool : public ::arrow::test::TestMemoryPoolBase {
+ public:
+  ::arrow::MemoryPool* memory_pool() override { return &pool_; }
+
+ protected:
+  ThreadCachingMemoryPool pool_;
+};
+
+TEST_F(TestThreadCachingMemoryPool, MemoryTracking) { this->TestMemoryTracking(); }
+
+TEST_F(TestThreadCachingMemoryPool, OOM) {
+#ifndef ADDRESS_SANITIZER
+  this->TestOOM();
+#endif
+}
+
+TEST_F(TestThreadCachingMemoryPool, Reallocate) { this->TestReallocate(); }
+
+TEST_F(TestThreadCachingMemoryPool, ReusesFreedBuffers) {
+  uint8_t* data;
+  ASSERT_OK(pool_.Allocate(100, &data));
+  pool_.Free(data, 100);
+  ASSERT_EQ(128, pool_.bytes_cached());
+
+  // The same size class is served from the cache.
+  uint8_t* data2;
+  ASSERT_OK(pool_.Allocate(120, &data2));
+  ASSERT_EQ(data, data2);
+  ASSERT_EQ(0, pool_.bytes_cached());
+  ASSERT_EQ(120, pool_.bytes_allocated());
+
+  // Growing within the size class keeps the buffer.
+  ASSERT_OK(pool_.Reallocate(120, 128, &data2));
+  ASSERT_EQ(data, data2);
+  ASSERT_OK(pool_.Reallocate(128, 4000, &data2));
+  ASSERT_EQ(0, reinterpret_cast<uint64_t>(data2) % 64);
+  ASSERT_EQ(4000, pool_.bytes_allocated());
+  pool_.Free(data2, 4000);
+
+  // Large allocations are not cached.
+  ASSERT_OK(pool_.Allocate(1 << 20, &data));
+  pool_.Free(data, 1 << 20);
+  ASSERT_EQ(128 + 4096, pool_.bytes_cached());
+  ASSERT_EQ(0, pool_.bytes_allocated());
+}
+
+TEST(ThreadCachingMemoryPool, MultipleThreads) {
+  MemoryPool* parent = default_memory_pool();
+  const int64_t parent_bytes = parent->bytes_allocated();
+  {
+    ThreadCachingMemoryPool pool(parent);
+    const int kNumThreads = 8;
+    std::vector<uint8_t*> leftovers(kNumThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back([&pool, &leftovers, i]() {
+        std::vector<uint8_t*> buffers;
+        for (int j = 0; j < 1000; ++j) {
+          uint8_t* data;
+          ASSERT_OK(pool.Allocate(j % 300 + 1, &data));
+          data[0] = static_cast<uint8_t>(j);
+          buffers.push_back(data);
+        }
+        for (int j = 0; j < 1000; ++j) {
+          pool.Free(buffers[j], j % 300 + 1);
+        }
+        // Freed on the main thread below.
+        ASSERT_OK(pool.Allocate(64, &leftovers[i]));
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(kNumThreads * 64, pool.bytes_allocated());
+    // The threads have exited, so their free lists went back to the parent.
+    ASSERT_EQ(0, pool.bytes_cached());
+    for (uint8_t* data : leftovers) {
+      pool.Free(data, 64);
+    }
+    ASSERT_EQ(0, pool.bytes_allocated());
+  }
+  ASSERT_EQ(parent_bytes, parent->bytes_allocated());
+}
+
+class TestArenaMemoryPool : public ::arrow::test::TestMemoryPoolBase {
+ public:
+  ::arrow::MemoryPool* memory_pool() override { return &pool_; }
+
+ protected:
+  ArenaMemoryPool pool_;
+};
+
+TEST_F(TestArenaMemoryPool, MemoryTracking) { this->TestMemoryTracking(); }
+
+TEST_F(TestArenaMemoryPool, OOM) {
+#ifndef ADDRESS_SANITIZER
+  this->TestOOM();
+#endif
+}
+
+TEST_F(TestArenaMemoryPool, Reallocate) { this->TestReallocate(); }
+
+TEST(ArenaMemoryPool, BumpAllocation) {
+  MemoryPool* parent = default_memory_pool();
+  const int64_t parent_bytes = parent->bytes_allocated();
+  {
+    ArenaMemoryPool pool(parent, 4096);
+    uint8_t* data1;
+    uint8_t* data2;
+    ASSERT_OK(pool.Allocate(100, &data1));
+    ASSERT_OK(pool.Allocate(10, &data2));
+    ASSERT_EQ(data1 + 128, data2);
+    ASSERT_EQ(4096, pool.bytes_reserved());
+    ASSERT_EQ(parent_bytes + 4096, parent->bytes_allocated());
+
+    // The last allocation grows in place.
+    ASSERT_OK(pool.Reallocate(10, 1000, &data2));
+    ASSERT_EQ(data1 + 128, data2);
+    ASSERT_EQ(1100, pool.bytes_allocated());
+
+    // Other allocations are copied.
+    data1[0] = 42;
+    ASSERT_OK(pool.Reallocate(100, 200, &data1));
+    ASSERT_EQ(42, data1[0]);
+    ASSERT_EQ(data2 + 1024, data1);
+
+    // Freeing the last allocation makes its space available again.
+    pool.Free(data1, 200);
+    uint8_t* data3;
+    ASSERT_OK(pool.Allocate(50, &data3));
+    ASSERT_EQ(data1, data3);
+
+    // Large allocations that do not fit get their own chunk.
+    uint8_t* large;
+    ASSERT_OK(pool.Allocate(3000, &large));
+    ASSERT_EQ(4096 + 3008, pool.bytes_reserved());
+    uint8_t* data4;
+    ASSERT_OK(pool.Allocate(64, &data4));
+    ASSERT_EQ(data3 + 64, data4);
+
+    // A new chunk is started when the current one is full.
+    uint8_t* data5;
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_OK(pool.Allocate(1000, &data5));
+    }
+    ASSERT_EQ(2 * 4096 + 3008, pool.bytes_reserved());
+
+    pool.Reset();
+    ASSERT_EQ(0, pool.bytes_allocated());
+    ASSERT_EQ(4096, pool.bytes_reserved());
+    ASSERT_EQ(parent_bytes + 4096, parent->bytes_allocated());
+    ASSERT_EQ(7114, pool.max_memory());
+  }
+  ASSERT_EQ(parent_bytes, parent->bytes_allocated());
+}
+
+class TestCappedMemoryPool : public ::arrow::test::TestMemoryPoolBase {
+ public:
+  TestCappedMemoryPool()
+      : pool_(default_memory_pool(), "test", std::numeric_limits<int64_t>::max()) {}
+
+  ::arrow::MemoryPool* memory_pool() override { return &pool_; }
+
+ protected:
+  CappedMemoryPool pool_;
+};
+
+TEST_F(TestCappedMemoryPool, MemoryTracking) { this->TestMemoryTracking(); }
+
+TEST_F(TestCappedMemoryPool, OOM) {
+#ifndef ADDRESS_SANITIZER
+  this->TestOOM();
+#endif
+}
+
+TEST_F(TestCappedMemoryPool, Reallocate) { this->TestReallocate(); }
+
+TEST(CappedMemoryPool, Limit) {
+  CappedMemoryPool query(default_memory_pool(), "query", 1000);
+  CappedMemoryPool op1(&query, "op1", 600);
+  CappedMemoryPool op2(&query, "op2", 600);
+
+  uint8_t* data1;
+  uint8_t* data2;
+  uint8_t* data3;
+  ASSERT_OK(op1.Allocate(500, &data1));
+  ASSERT_RAISES(OutOfMemory, op1.Allocate(200, &data2));
+  ASSERT_RAISES(OutOfMemory, op1.Reallocate(500, 700, &data1));
+  ASSERT_OK(op2.Allocate(400, &data2));
+  // Within op2's limit, but not within the query's.
+  ASSERT_RAISES(OutOfMemory, op2.Allocate(150, &data3));
+  ASSERT_EQ(400, op2.bytes_allocated());
+  ASSERT_EQ(900, query.bytes_allocated());
+
+  op1.Free(data1, 500);
+  ASSERT_OK(op2.Allocate(150, &data3));
+  ASSERT_OK(op2.Reallocate(150, 50, &data3));
+  ASSERT_EQ(450, op2.bytes_allocated());
+  ASSERT_EQ(450, query.bytes_allocated());
+  ASSERT_EQ(900, query.max_memory());
+  op2.Free(data2, 400);
+  op2.Free(data3, 50);
+  ASSERT_EQ(0, query.bytes_allocated());
+
+  MemoryPoolStats stats = op2.stats();
+  ASSERT_EQ(2, stats.num_allocations);
+  ASSERT_EQ(1, stats.num_reallocations);
+  ASSERT_EQ(2, stats.num_frees);
+  ASSERT_EQ(0, stats.num_rejections);
+  // 400 is in [256, 512), 150 in [128, 256), 50 in [32, 64).
+  ASSERT_EQ(1, stats.size_histogram[9]);
+  ASSERT_EQ(1, stats.size_histogram[8]);
+  ASSERT_EQ(1, stats.size_histogram[6]);
+  ASSERT_EQ(2, op1.stats().num_rejections);
+  ASSERT_EQ(1, query.stats().num_rejections);
+  ASSERT_EQ(3, query.stats().num_allocations);
+}
+
+TEST(CappedMemoryPool, Block) {
+  CappedMemoryPool pool(default_memory_pool(), "blocking", 100, CappedMemoryPool::BLOCK);
+  uint8_t* data1;
+  ASSERT_OK(pool.Allocate(80, &data1));
+
+  uint8_t* data2;
+  Status allocate_status;
+  std::thread allocating_thread(
+      [&pool, &data2, &allocate_status]() { allocate_status = pool.Allocate(50, &data2); });
+  // Free the memory only once the other thread is known to be blocked
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (pool.stats().num_waits == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const int64_t num_waits = pool.stats().num_waits;
+  pool.Free(data1, 80);
+  allocating_thread.join();
+  ASSERT_EQ(1, num_waits);
+  ASSERT_OK(allocate_status);
+  // Too large to ever fit.
+  ASSERT_RAISES(OutOfMemory, pool.Allocate(101, &data1));
+  pool.Free(data2, 50);
+
+  CappedMemoryPool timed(default_memory_pool(), "timed", 100, CappedMemoryPool::BLOCK, 1);
+  ASSERT_OK(timed.Allocate(80, &data1));
+  ASSERT_RAISES(OutOfMemory, timed.Allocate(50, &data2));
+  timed.set_limit(200);
+  ASSERT_OK(timed.Allocate(50, &data2));
+  timed.Free(data1, 80);
+  timed.Free(data2, 50);
+}
+
+TEST(CappedMemoryPool, ShrinkAboveLimit) {
+  for (auto policy : {CappedMemoryPool::FAIL, CappedMemoryPool::BLOCK}) {
+    CappedMemoryPool pool(default_memory_pool(), "shrinking", 8192, policy, 1);
+    uint8_t* data;
+    ASSERT_OK(pool.Allocate(4096, &data));
+    pool.set_limit(1024);
+    // Shrinking neither waits nor fails, even while above the lowered limit.
+    ASSERT_OK(pool.Reallocate(4096, 2048, &data));
+    ASSERT_OK(pool.Reallocate(2048, 2048, &data));
+    ASSERT_EQ(2048, pool.bytes_allocated());
+    ASSERT_EQ(0, pool.stats().num_waits);
+    ASSERT_EQ(0, pool.stats().num_rejections);
+    // Growing does not.
+    ASSERT_RAISES(OutOfMemory, pool.Reallocate(2048, 2049, &data));
+    ASSERT_OK(pool.Reallocate(2048, 512, &data));
+    ASSERT_EQ(512, pool.bytes_allocated());
+    pool.Free(data, 512);
+  }
+}
+
+class TestMmapMemoryPool : public ::arrow::test::TestMemoryPoolBase {
+ public:
+  TestMmapMemoryPool() : pool_(SmallThreshold()) {}
+
+  ::arrow::MemoryPool* memory_pool() override { return &pool_; }
+
+ protected:
+  static MmapMemoryPoolOptions SmallThreshold() {
+    MmapMemoryPoolOptions options;
+    options.mmap_threshold = 8;
+    return options;
+  }
+
+  MmapMemoryPool pool_;
+};
+
+TEST_F(TestMmapMemoryPool, MemoryTracking) { this->TestMemoryTracking(); }
+
+TEST_F(TestMmapMemoryPool, OOM) {
+#ifndef ADDRESS_SANITIZER
+  this->TestOOM();
+#endif
+}
+
+TEST_F(TestMmapMemoryPool, Reallocate) { this->TestReallocate(); }
+
+#ifndef _WIN32
+TEST(MmapMemoryPool, LargeAllocations) {
+  MemoryPool* parent = default_memory_pool();
+  const int64_t parent_bytes = parent->bytes_allocated();
+  MmapMemoryPoolOptions options;
+  options.mmap_threshold = 1 << 16;
+  MmapMemoryPool pool(options, parent);
+
+  uint8_t* small;
+  ASSERT_OK(pool.Allocate(1000, &small));
+  ASSERT_EQ(parent_bytes + 1000, parent->bytes_allocated());
+  ASSERT_EQ(0, pool.bytes_mapped());
+
+  // Mappings are aligned to huge pages.
+  uint8_t* large;
+  ASSERT_OK(pool.Allocate(3 << 20, &large));
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(large) % (1 << 21));
+  ASSERT_EQ(4 << 20, pool.bytes_mapped());
+  large[0] = 1;
+  large[(3 << 20) - 1] = 2;
+
+  // Growing within the mapping keeps the address.
+  uint8_t* before = large;
+  ASSERT_OK(pool.Reallocate(3 << 20, 4 << 20, &large));
+  ASSERT_EQ(before, large);
+
+  // Growing a small allocation past the threshold moves it into a mapping.
+  small[999] = 3;
+  ASSERT_OK(pool.Reallocate(1000, 1 << 20, &small));
+  ASSERT_EQ(3, small[999]);
+  ASSERT_EQ(parent_bytes, parent->bytes_allocated());
+  ASSERT_EQ(6 << 20, pool.bytes_mapped());
+  ASSERT_EQ((5 << 20), pool.bytes_allocated());
+
+  // And shrinking it moves it back.
+  small[99] = 4;
+  ASSERT_OK(pool.Reallocate(1 << 20, 100, &small));
+  ASSERT_EQ(4, small[99]);
+  ASSERT_EQ(parent_bytes + 100, parent->bytes_allocated());
+
+  pool.Free(small, 100);
+  pool.Free(large, 4 << 20);
+  ASSERT_EQ(0, pool.bytes_allocated());
+  ASSERT_EQ(0, pool.bytes_mapped());
+  // Both copies existed while the small allocation was moved.
+  ASSERT_EQ((5 << 20) + 1000, pool.max_memory());
+
+  // Explicit huge pages are usually not reserved; the pool then falls back to
+  // regular pages.
+  options.huge_pages = MmapMemoryPoolOptions::HUGETLB_PAGES;
+  MmapMemoryPool hugetlb(options, parent);
+  ASSERT_OK(hugetlb.Allocate(1 << 20, &large));
+  memset(large, 1, 1 << 20);
+  ASSERT_EQ(2 << 20, hugetlb.bytes_mapped());
+  hugetlb.Free(large, 1 << 20);
+
+  options.huge_pages = MmapMemoryPoolOptions::NO_HUGE_PAGES;
+  MmapMemoryPool regular(options, parent);
+  ASSERT_OK(regular.Allocate((1 << 16) + 1, &large));
+  ASSERT_EQ((1 << 16) + sysconf(_SC_PAGESIZE), regular.bytes_mapped());
+  regular.Free(large, (1 << 16) + 1);
+}
+#endif
+
+#ifdef __linux__
+TEST(MmapMemoryPool, Remap) {
+  MmapMemoryPoolOptions options;
+  options.mmap_threshold = 1 << 16;
+  options.huge_pages = MmapMemoryPoolOptions::NO_HUGE_PAGES;
+  MmapMemoryPool pool(options);
+
+  uint8_t* data;
+  ASSERT_OK(pool.Allocate(1 << 16, &data));
+  for (int64_t i = 0; i < (1 << 16); ++i) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  // Grow the mapping far beyond its size; the pages are moved, not copied.
+  ASSERT_OK(pool.Reallocate(1 << 16, 64 << 20, &data));
+  ASSERT_EQ(64 << 20, pool.bytes_mapped());
+  for (int64_t i = 0; i < (1 << 16); ++i) {
+    ASSERT_EQ(static_cast<uint8_t>(i), data[i]);
+  }
+  data[(64 << 20) - 1] = 1;
+
+  ASSERT_OK(pool.Reallocate(64 << 20, 1 << 17, &data));
+  ASSERT_EQ(1 << 17, pool.bytes_mapped());
+  ASSERT_EQ(255, data[(1 << 16) - 1]);
+  ASSERT_EQ(1 << 17, pool.bytes_allocated());
+  ASSERT_EQ(64 << 20, pool.max_memory());
+  pool.Free(data, 1 << 17);
+  ASSERT_EQ(0, pool.bytes_mapped());
+}
+
+#ifdef __NR_get_mempolicy
+// The NUMA node that the page at address was placed on, or -1.
+static int NumaNodeOfPage(uint8_t* address) {
+  // MPOL_F_NODE | MPOL_F_ADDR from <numaif.h>
+  constexpr unsigned long kFlags = 1 | 2;  // NOLINT
+  int node = -1;
+  if (syscall(__NR_get_mempolicy, &node, nullptr, 0, address, kFlags) != 0) {
+    return -1;
+  }
+  return node;
+}
+#endif
+
+TEST(MmapMemoryPool, NumaPlacement) {
+  MmapMemoryPoolOptions options;
+  options.mmap_threshold = 1 << 16;
+  options.numa_node = 0;
+  MmapMemoryPool bound(options);
+  uint8_t* data;
+  Status status = bound.Allocate(1 << 20, &data);
+  if (status.IsNotImplemented()) {
+    // The kernel was built without NUMA support.
+    return;
+  }
+  ASSERT_OK(status);
+  memset(data, 1, 1 << 20);
+#ifdef __NR_get_mempolicy
+  // Every machine has a node 0, so the pages must actually be placed there.
+  ASSERT_EQ(0, NumaNodeOfPage(data));
+  ASSERT_EQ(0, NumaNodeOfPage(data + (1 << 20) - 1));
+#endif
+  bound.Free(data, 1 << 20);
+
+  options.numa_interleave = true;
+  MmapMemoryPool interleaved(options);
+  ASSERT_OK(interleaved.Allocate(1 << 20, &data));
+  memset(data, 1, 1 << 20);
+  interleaved.Free(data, 1 << 20);
+
+  options.numa_interleave = false;
+  options.numa_node = 1 << 20;
+  MmapMemoryPool invalid(options);
+  ASSERT_RAISES(Invalid, invalid.Allocate(1 << 20, &data));
+  ASSERT_EQ(0, invalid.bytes_allocated());
+}
+#endif
+
 }  // namespace arrow
@@ -19,15 +19,30 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <sstream>  // IWYU pragma: keep
+#include <vector>
 
 #include "arrow/status.h"
+#include "arrow/util/bit-util.h"
 #include "arrow/util/logging.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
 #ifdef ARROW_JEMALLOC
 // Needed to support jemalloc 3 and 4
 #define JEMALLOC_MANGLE
@@ -198,4 +213,838 @@ int64_t LoggingMemoryPool::max_memory() const {
   std::cout << "max_memory: " << mem << std::endl;
   return mem;
 }
+
+// ----------------------------------------------------------------------
+// ThreadCachingMemoryPool
+
+namespace {
+
+// Size classes are multiples of 64 bytes up to 1 KiB and powers of two up to
+// 32 KiB.
+constexpr int kNumSmallSizeClasses = 16;
+constexpr int kNumSizeClasses = kNumSmallSizeClasses + 5;
+constexpr int64_t kMaxSmallSize = kNumSmallSizeClasses * kAlignment;
+constexpr int64_t kMaxCachedSize = kMaxSmallSize
+                                   << (kNumSizeClasses - kNumSmallSizeClasses);
+
+// A thread keeps at most this many bytes per size class in its free list.
+constexpr int64_t kMaxCachedBytesPerClass = 256 * 1024;
+
+// A thread merges its statistics into the pool's peak after they changed by
+// this many bytes.
+constexpr int64_t kStatsMergeBytes = 1 << 20;
+
+// Return the size class of an allocation, or -1 if it is not cached.
+int SizeClassIndex(int64_t size) {
+  if (size <= kMaxSmallSize) {
+    return size <= static_cast<int64_t>(kAlignment)
+               ? 0
+               : static_cast<int>((size + kAlignment - 1) / kAlignment) - 1;
+  }
+  if (size > kMaxCachedSize) {
+    return -1;
+  }
+  int index = kNumSmallSizeClasses;
+  for (int64_t class_size = kMaxSmallSize * 2; class_size < size; class_size *= 2) {
+    ++index;
+  }
+  return index;
+}
+
+int64_t SizeClassBytes(int index) {
+  if (index < kNumSmallSizeClasses) {
+    return (index + 1) * static_cast<int64_t>(kAlignment);
+  }
+  return kMaxSmallSize << (index - kNumSmallSizeClasses + 1);
+}
+
+// The free lists and statistics of one thread for one pool. Only the owning
+// thread modifies them; other threads read the atomic counters.
+struct ThreadCache {
+  ThreadCache()
+      : bytes_allocated(0), bytes_cached(0), unmerged_bytes(0), retired(false) {}
+
+  std::vector<uint8_t*> free_lists[kNumSizeClasses];
+  std::atomic<int64_t> bytes_allocated;
+  std::atomic<int64_t> bytes_cached;
+  // The change of bytes_allocated since it was last merged into the pool.
+  int64_t unmerged_bytes;
+  // Set, under the pool's mutex, once the free lists were given back.
+  bool retired;
+};
+
+}  // namespace
+
+class ThreadCachingMemoryPool::Impl {
+ public:
+  explicit Impl(MemoryPool* pool)
+      : pool_(pool),
+        id_(next_id_++),
+        retired_bytes_allocated_(0),
+        merged_bytes_allocated_(0),
+        max_memory_(0) {}
+
+  Status Allocate(int64_t size, uint8_t** out) {
+    ThreadCache* cache = GetThreadCache();
+    const int index = SizeClassIndex(size);
+    if (index < 0) {
+      RETURN_NOT_OK(pool_->Allocate(size, out));
+    } else {
+      std::vector<uint8_t*>& free_list = cache->free_lists[index];
+      if (free_list.empty()) {
+        RETURN_NOT_OK(pool_->Allocate(SizeClassBytes(index), out));
+      } else {
+        *out = free_list.back();
+        free_list.pop_back();
+        AddRelaxed(&cache->bytes_cached, -SizeClassBytes(index));
+      }
+    }
+    UpdateStats(cache, size);
+    return Status::OK();
+  }
+
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+    const int old_index = SizeClassIndex(old_size);
+    const int new_index = SizeClassIndex(new_size);
+    if (old_index < 0 && new_index < 0) {
+      RETURN_NOT_OK(pool_->Reallocate(old_size, new_size, ptr));
+    } else if (old_index != new_index) {
+      uint8_t* out;
+      RETURN_NOT_OK(Allocate(new_size, &out));
+      memcpy(out, *ptr, static_cast<size_t>(std::min(old_size, new_size)));
+      Free(*ptr, old_size);
+      *ptr = out;
+      return Status::OK();
+    }
+    // Same size class: the buffer is already large enough.
+    UpdateStats(GetThreadCache(), new_size - old_size);
+    return Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) {
+    ThreadCache* cache = GetThreadCache();
+    const int index = SizeClassIndex(size);
+    if (index < 0) {
+      pool_->Free(buffer, size);
+    } else {
+      std::vector<uint8_t*>& free_list = cache->free_lists[index];
+      const int64_t class_size = SizeClassBytes(index);
+      const int64_t cached_bytes = static_cast<int64_t>(free_list.size()) * class_size;
+      if (cached_bytes >= kMaxCachedBytesPerClass) {
+        pool_->Free(buffer, class_size);
+      } else {
+        free_list.push_back(buffer);
+        AddRelaxed(&cache->bytes_cached, class_size);
+      }
+    }
+    UpdateStats(cache, -size);
+  }
+
+  int64_t bytes_allocated() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    int64_t total = retired_bytes_allocated_;
+    for (const auto& cache : caches_) {
+      total += cache->bytes_allocated.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  int64_t max_memory() const { return std::max(max_memory_.load(), bytes_allocated()); }
+
+  int64_t bytes_cached() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    int64_t total = 0;
+    for (const auto& cache : caches_) {
+      total += cache->bytes_cached.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  // Give the free lists of all threads back to the parent pool. Called when
+  // the pool is destroyed; threads that still use the pool afterwards would
+  // be a bug in the caller.
+  void Shutdown() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& cache : caches_) {
+      ReleaseFreeLists(cache.get());
+    }
+    caches_.clear();
+  }
+
+ private:
+  // The caches of the calling thread, one per pool it used. On thread exit,
+  // the free lists go back to the pools that are still alive.
+  struct ThreadCacheList {
+    struct Entry {
+      uint64_t pool_id;
+      std::weak_ptr<Impl> pool;
+      std::shared_ptr<ThreadCache> cache;
+    };
+
+    ~ThreadCacheList() {
+      for (auto& entry : entries) {
+        std::shared_ptr<Impl> pool = entry.pool.lock();
+        if (pool) {
+          pool->RetireCache(entry.cache.get());
+        }
+      }
+    }
+
+    std::vector<Entry> entries;
+  };
+
+  ThreadCache* GetThreadCache() {
+    static thread_local ThreadCacheList thread_caches;
+    for (const auto& entry : thread_caches.entries) {
+      if (entry.pool_id == id_) {
+        return entry.cache.get();
+      }
+    }
+    // Forget the caches of destroyed pools before adding a new one.
+    auto& entries = thread_caches.entries;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const ThreadCacheList::Entry& entry) {
+                                   return entry.pool.expired();
+                                 }),
+                  entries.end());
+    auto cache = std::make_shared<ThreadCache>();
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      caches_.push_back(cache);
+    }
+    entries.push_back({id_, self_, cache});
+    return cache.get();
+  }
+
+  void UpdateStats(ThreadCache* cache, int64_t delta) {
+    AddRelaxed(&cache->bytes_allocated, delta);
+    cache->unmerged_bytes += delta;
+    if (cache->unmerged_bytes >= kStatsMergeBytes ||
+        cache->unmerged_bytes <= -kStatsMergeBytes) {
+      const int64_t merged = cache->unmerged_bytes +
+                             merged_bytes_allocated_.fetch_add(cache->unmerged_bytes);
+      cache->unmerged_bytes = 0;
+      int64_t max_memory = max_memory_.load();
+      while (merged > max_memory &&
+             !max_memory_.compare_exchange_weak(max_memory, merged)) {
+      }
+    }
+  }
+
+  void RetireCache(ThreadCache* cache) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (cache->retired) {
+      return;
+    }
+    ReleaseFreeLists(cache);
+    retired_bytes_allocated_ += cache->bytes_allocated.load();
+    merged_bytes_allocated_ += cache->unmerged_bytes;
+    caches_.erase(std::find_if(caches_.begin(), caches_.end(),
+                               [cache](const std::shared_ptr<ThreadCache>& other) {
+                                 return other.get() == cache;
+                               }));
+  }
+
+  // Must be called with mutex_ held.
+  void ReleaseFreeLists(ThreadCache* cache) {
+    for (int index = 0; index < kNumSizeClasses; ++index) {
+      for (uint8_t* buffer : cache->free_lists[index]) {
+        pool_->Free(buffer, SizeClassBytes(index));
+      }
+      cache->free_lists[index].clear();
+    }
+    cache->bytes_cached = 0;
+    cache->retired = true;
+  }
+
+  // Only the owning thread writes the per-thread counters, so a relaxed load
+  // and store are enough and avoid a locked instruction.
+  static void AddRelaxed(std::atomic<int64_t>* counter, int64_t delta) {
+    counter->store(counter->load(std::memory_order_relaxed) + delta,
+                   std::memory_order_relaxed);
+  }
+
+  static std::atomic<uint64_t> next_id_;
+
+  MemoryPool* pool_;
+  // Identifies the pool in the thread-local cache lists; unlike the address it
+  // is never reused.
+  const uint64_t id_;
+  std::weak_ptr<Impl> self_;
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadCache>> caches_;
+  // The bytes allocated by threads that have exited.
+  int64_t retired_bytes_allocated_;
+  std::atomic<int64_t> merged_bytes_allocated_;
+  std::atomic<int64_t> max_memory_;
+
+  friend class ThreadCachingMemoryPool;
+};
+
+std::atomic<uint64_t> ThreadCachingMemoryPool::Impl::next_id_(0);
+
+ThreadCachingMemoryPool::ThreadCachingMemoryPool(MemoryPool* pool)
+    : impl_(std::make_shared<Impl>(pool)) {
+  impl_->self_ = impl_;
+}
+
+ThreadCachingMemoryPool::~ThreadCachingMemoryPool() { impl_->Shutdown(); }
+
+Status ThreadCachingMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  return impl_->Allocate(size, out);
+}
+
+Status ThreadCachingMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                           uint8_t** ptr) {
+  return impl_->Reallocate(old_size, new_size, ptr);
+}
+
+void ThreadCachingMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  impl_->Free(buffer, size);
+}
+
+int64_t ThreadCachingMemoryPool::bytes_allocated() const {
+  return impl_->bytes_allocated();
+}
+
+int64_t ThreadCachingMemoryPool::max_memory() const { return impl_->max_memory(); }
+
+int64_t ThreadCachingMemoryPool::bytes_cached() const { return impl_->bytes_cached(); }
+
+// ----------------------------------------------------------------------
+// ArenaMemoryPool
+
+constexpr int64_t ArenaMemoryPool::kDefaultChunkSize;
+
+ArenaMemoryPool::ArenaMemoryPool(MemoryPool* pool, int64_t chunk_size)
+    : pool_(pool),
+      chunk_size_(BitUtil::RoundUpToMultipleOf64(chunk_size)),
+      current_chunk_(-1),
+      offset_(0),
+      last_allocation_(nullptr),
+      bytes_allocated_(0),
+      bytes_reserved_(0),
+      max_memory_(0) {}
+
+ArenaMemoryPool::~ArenaMemoryPool() {
+  for (const auto& chunk : chunks_) {
+    pool_->Free(chunk.first, chunk.second);
+  }
+}
+
+Status ArenaMemoryPool::AllocateChunk(int64_t size, uint8_t** out) {
+  RETURN_NOT_OK(pool_->Allocate(size, out));
+  chunks_.emplace_back(*out, size);
+  bytes_reserved_ += size;
+  return Status::OK();
+}
+
+Status ArenaMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size > std::numeric_limits<int64_t>::max() - static_cast<int64_t>(kAlignment)) {
+    std::stringstream ss;
+    ss << "malloc of size " << size << " failed";
+    return Status::OutOfMemory(ss.str());
+  }
+  // Every allocation starts on a 64-byte boundary and takes some space, so
+  // that distinct allocations have distinct addresses.
+  const int64_t aligned_size = std::max(BitUtil::RoundUpToMultipleOf64(size),
+                                        static_cast<int64_t>(kAlignment));
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (current_chunk_ >= 0 && offset_ + aligned_size <= chunks_[current_chunk_].second) {
+    *out = chunks_[current_chunk_].first + offset_;
+    offset_ += aligned_size;
+    last_allocation_ = *out;
+  } else if (aligned_size > chunk_size_ / 4) {
+    // Large allocations get their own chunk, and the current chunk stays in
+    // use for small ones.
+    RETURN_NOT_OK(AllocateChunk(aligned_size, out));
+  } else {
+    RETURN_NOT_OK(AllocateChunk(chunk_size_, out));
+    current_chunk_ = static_cast<int64_t>(chunks_.size()) - 1;
+    offset_ = aligned_size;
+    last_allocation_ = *out;
+  }
+  bytes_allocated_ += size;
+  max_memory_ = std::max(max_memory_, bytes_allocated_);
+  return Status::OK();
+}
+
+Status ArenaMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    const int64_t new_aligned_size = BitUtil::RoundUpToMultipleOf64(new_size);
+    bool in_place = new_size <= old_size;
+    if (*ptr == last_allocation_) {
+      // The most recent allocation can grow into the free space of the chunk.
+      const int64_t start = last_allocation_ - chunks_[current_chunk_].first;
+      if (start + new_aligned_size <= chunks_[current_chunk_].second) {
+        offset_ = start + std::max(new_aligned_size, static_cast<int64_t>(kAlignment));
+        in_place = true;
+      }
+    }
+    if (in_place) {
+      bytes_allocated_ += new_size - old_size;
+      max_memory_ = std::max(max_memory_, bytes_allocated_);
+      return Status::OK();
+    }
+  }
+  uint8_t* out;
+  RETURN_NOT_OK(Allocate(new_size, &out));
+  memcpy(out, *ptr, static_cast<size_t>(old_size));
+  Free(*ptr, old_size);
+  *ptr = out;
+  return Status::OK();
+}
+
+void ArenaMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  DCHECK_GE(bytes_allocated_, size);
+  if (buffer != nullptr && buffer == last_allocation_) {
+    offset_ = last_allocation_ - chunks_[current_chunk_].first;
+    last_allocation_ = nullptr;
+  }
+  bytes_allocated_ -= size;
+}
+
+void ArenaMemoryPool::Reset() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  // Keep one regular chunk, which is enough for the next request if the
+  // requests are of similar size.
+  std::pair<uint8_t*, int64_t> kept(nullptr, 0);
+  for (const auto& chunk : chunks_) {
+    if (kept.first == nullptr && chunk.second == chunk_size_) {
+      kept = chunk;
+    } else {
+      pool_->Free(chunk.first, chunk.second);
+    }
+  }
+  chunks_.clear();
+  if (kept.first != nullptr) {
+    chunks_.push_back(kept);
+  }
+  current_chunk_ = chunks_.empty() ? -1 : 0;
+  bytes_reserved_ = kept.second;
+  offset_ = 0;
+  last_allocation_ = nullptr;
+  bytes_allocated_ = 0;
+}
+
+int64_t ArenaMemoryPool::bytes_allocated() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return bytes_allocated_;
+}
+
+int64_t ArenaMemoryPool::max_memory() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return max_memory_;
+}
+
+int64_t ArenaMemoryPool::bytes_reserved() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return bytes_reserved_;
+}
+
+// ----------------------------------------------------------------------
+// CappedMemoryPool
+
+constexpr int MemoryPoolStats::kNumSizeBuckets;
+
+MemoryPoolStats::MemoryPoolStats()
+    : num_allocations(0),
+      num_reallocations(0),
+      num_frees(0),
+      num_rejections(0),
+      num_waits(0) {
+  std::fill(size_histogram, size_histogram + kNumSizeBuckets, 0);
+}
+
+CappedMemoryPool::CappedMemoryPool(MemoryPool* pool, const std::string& name,
+                                   int64_t limit, LimitPolicy policy, int64_t timeout_ms)
+    : pool_(pool),
+      name_(name),
+      policy_(policy),
+      timeout_ms_(timeout_ms),
+      limit_(limit),
+      bytes_allocated_(0),
+      max_memory_(0) {}
+
+CappedMemoryPool::~CappedMemoryPool() {}
+
+Status CappedMemoryPool::Reserve(int64_t size) {
+  if (size == 0) {
+    // Nothing to check, even if the limit was lowered below bytes_allocated_
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto fits = [this, size]() { return bytes_allocated_ + size <= limit_; };
+  if (!fits() && policy_ == BLOCK && size <= limit_) {
+    ++stats_.num_waits;
+    if (timeout_ms_ < 0) {
+      memory_freed_.wait(lock, fits);
+    } else {
+      memory_freed_.wait_for(lock, std::chrono::milliseconds(timeout_ms_), fits);
+    }
+  }
+  if (!fits()) {
+    ++stats_.num_rejections;
+    std::stringstream ss;
+    ss << "allocation of " << size << " bytes exceeds the memory limit of " << name_
+       << " (" << bytes_allocated_ << " of " << limit_ << " bytes allocated)";
+    return Status::OutOfMemory(ss.str());
+  }
+  bytes_allocated_ += size;
+  max_memory_ = std::max(max_memory_, bytes_allocated_);
+  return Status::OK();
+}
+
+void CappedMemoryPool::Unreserve(int64_t size) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    DCHECK_GE(bytes_allocated_, size);
+    bytes_allocated_ -= size;
+  }
+  if (policy_ == BLOCK) {
+    memory_freed_.notify_all();
+  }
+}
+
+namespace {
+
+int SizeBucket(int64_t size) {
+  int bucket = 0;
+  while (bucket < MemoryPoolStats::kNumSizeBuckets - 1 && (size >> bucket) > 0) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace
+
+Status CappedMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  RETURN_NOT_OK(Reserve(size));
+  Status s = pool_->Allocate(size, out);
+  if (!s.ok()) {
+    Unreserve(size);
+    return s;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  ++stats_.num_allocations;
+  ++stats_.size_histogram[SizeBucket(size)];
+  return Status::OK();
+}
+
+Status CappedMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  // Only growth counts against the limit; shrinking always goes through.
+  const int64_t growth = new_size - old_size;
+  if (growth > 0) {
+    RETURN_NOT_OK(Reserve(growth));
+  }
+  Status s = pool_->Reallocate(old_size, new_size, ptr);
+  if (!s.ok()) {
+    if (growth > 0) {
+      Unreserve(growth);
+    }
+    return s;
+  }
+  // Shrinking gives memory back only once the parent succeeded.
+  if (growth < 0) {
+    Unreserve(-growth);
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  ++stats_.num_reallocations;
+  ++stats_.size_histogram[SizeBucket(new_size)];
+  return Status::OK();
+}
+
+void CappedMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  pool_->Free(buffer, size);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++stats_.num_frees;
+  }
+  Unreserve(size);
+}
+
+int64_t CappedMemoryPool::bytes_allocated() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return bytes_allocated_;
+}
+
+int64_t CappedMemoryPool::max_memory() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return max_memory_;
+}
+
+int64_t CappedMemoryPool::limit() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return limit_;
+}
+
+void CappedMemoryPool::set_limit(int64_t limit) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    limit_ = limit;
+  }
+  memory_freed_.notify_all();
+}
+
+MemoryPoolStats CappedMemoryPool::stats() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return stats_;
+}
+
+// ----------------------------------------------------------------------
+// MmapMemoryPool
+
+namespace {
+
+constexpr int64_t kHugePageSize = 1 << 21;
+
+#ifdef __linux__
+// From <numaif.h>, which is part of libnuma and may not be installed.
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr int kMaxNumaNodes = 1024;
+
+// Parse a node list such as "0-3,5" from /sys/devices/system/node/online. A
+// kernel without NUMA support has no such file and a single node 0.
+std::vector<int> OnlineNumaNodes() {
+  std::vector<int> nodes;
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string range;
+  while (std::getline(file, range, ',')) {
+    int first = 0;
+    int last = 0;
+    const int parsed = sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (parsed < 1 || first < 0) {
+      continue;
+    }
+    if (parsed == 1) {
+      last = first;
+    }
+    for (int node = first; node <= last && node < kMaxNumaNodes; ++node) {
+      nodes.push_back(node);
+    }
+  }
+  if (nodes.empty()) {
+    nodes.push_back(0);
+  }
+  return nodes;
+}
+
+// Set the NUMA policy of a mapping before its pages are touched.
+Status BindToNumaNodes(uint8_t* address, int64_t length, int node, bool interleave) {
+#ifdef __NR_mbind
+  std::vector<int> nodes;
+  int mode;
+  if (interleave) {
+    nodes = OnlineNumaNodes();
+    mode = kMpolInterleave;
+  } else {
+    if (node >= kMaxNumaNodes) {
+      return Status::Invalid("NUMA node out of range");
+    }
+    nodes.push_back(node);
+    mode = kMpolBind;
+  }
+  // The kernel rejects masks with bits set beyond the nodes it supports, so
+  // only the requested nodes are set and the mask is sized to the highest one.
+  constexpr int kBitsPerWord = 8 * sizeof(unsigned long);  // NOLINT
+  const int highest_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> nodemask(highest_node / kBitsPerWord + 1, 0);  // NOLINT
+  for (int n : nodes) {
+    nodemask[n / kBitsPerWord] |= 1UL << (n % kBitsPerWord);
+  }
+  // mbind reads maxnode - 1 bits of the mask, like libnuma we pass one more.
+  const unsigned long maxnode = highest_node + 2;  // NOLINT
+  if (syscall(__NR_mbind, address, static_cast<unsigned long>(length), mode,  // NOLINT
+              nodemask.data(), maxnode, 0) != 0) {
+    if (errno == ENOSYS) {
+      return Status::NotImplemented("The kernel was built without NUMA support");
+    }
+    std::stringstream ss;
+    ss << "mbind failed: " << std::strerror(errno);
+    return Status::IOError(ss.str());
+  }
+  return Status::OK();
+#else
+  return Status::NotImplemented("NUMA placement is not supported on this platform");
+#endif
+}
+#endif  // __linux__
+
+}  // namespace
+
+MmapMemoryPool::MmapMemoryPool(const MmapMemoryPoolOptions& options, MemoryPool* pool)
+    : options_(options),
+      pool_(pool),
+      bytes_allocated_(0),
+      bytes_mapped_(0),
+      max_memory_(0) {}
+
+MmapMemoryPool::~MmapMemoryPool() {}
+
+bool MmapMemoryPool::IsMapped(int64_t size) const {
+#ifdef _WIN32
+  return false;
+#else
+  return size >= options_.mmap_threshold;
+#endif
+}
+
+int64_t MmapMemoryPool::MappingSize(int64_t size) const {
+  const int64_t page_size = options_.huge_pages == MmapMemoryPoolOptions::NO_HUGE_PAGES
+                                ? static_cast<int64_t>(sysconf(_SC_PAGESIZE))
+                                : kHugePageSize;
+  return BitUtil::RoundUp(std::max(size, static_cast<int64_t>(1)), page_size);
+}
+
+Status MmapMemoryPool::Map(int64_t size, uint8_t** out) {
+#ifdef _WIN32
+  return Status::NotImplemented("MmapMemoryPool::Map");
+#else
+  if (size > std::numeric_limits<int64_t>::max() / 2) {
+    std::stringstream ss;
+    ss << "mmap of size " << size << " failed";
+    return Status::OutOfMemory(ss.str());
+  }
+  const int64_t length = MappingSize(size);
+  void* address = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (options_.huge_pages == MmapMemoryPoolOptions::HUGETLB_PAGES) {
+    address = mmap(nullptr, static_cast<size_t>(length), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+#endif
+  if (address == MAP_FAILED) {
+    // Map one huge page more than needed so that the mapping can be trimmed to
+    // start on a huge page boundary.
+    const int64_t alignment =
+        options_.huge_pages == MmapMemoryPoolOptions::NO_HUGE_PAGES ? 0 : kHugePageSize;
+    uint8_t* start = reinterpret_cast<uint8_t*>(
+        mmap(nullptr, static_cast<size_t>(length + alignment), PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (start == MAP_FAILED) {
+      std::stringstream ss;
+      ss << "mmap of size " << size << " failed: " << std::strerror(errno);
+      return Status::OutOfMemory(ss.str());
+    }
+    uint8_t* aligned = start;
+    if (alignment > 0) {
+      aligned = reinterpret_cast<uint8_t*>(
+          BitUtil::RoundUp(reinterpret_cast<int64_t>(start), alignment));
+      if (aligned > start) {
+        munmap(start, static_cast<size_t>(aligned - start));
+      }
+      if (aligned + length < start + length + alignment) {
+        munmap(aligned + length,
+               static_cast<size_t>(start + length + alignment - (aligned + length)));
+      }
+#ifdef MADV_HUGEPAGE
+      // Failure only means that the kernel does not support transparent huge
+      // pages, in which case the mapping still works with regular pages.
+      madvise(aligned, static_cast<size_t>(length), MADV_HUGEPAGE);
+#endif
+    }
+    address = aligned;
+  }
+  *out = reinterpret_cast<uint8_t*>(address);
+#ifdef __linux__
+  if (options_.numa_node >= 0 || options_.numa_interleave) {
+    Status s =
+        BindToNumaNodes(*out, length, options_.numa_node, options_.numa_interleave);
+    if (!s.ok()) {
+      munmap(*out, static_cast<size_t>(length));
+      return s;
+    }
+  }
+#endif
+  bytes_mapped_ += length;
+  return Status::OK();
+#endif
+}
+
+void MmapMemoryPool::Unmap(uint8_t* buffer, int64_t size) {
+#ifndef _WIN32
+  const int64_t length = MappingSize(size);
+  DCHECK_EQ(munmap(buffer, static_cast<size_t>(length)), 0);
+  bytes_mapped_ -= length;
+#endif
+}
+
+bool MmapMemoryPool::Remap(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+  const int64_t old_length = MappingSize(old_size);
+  const int64_t new_length = MappingSize(new_size);
+  // The kernel extends the mapping in place if the address range after it is
+  // free, and otherwise moves the page table entries; the data is never copied.
+  // The new address is page-aligned, so a moved mapping may lose its huge page
+  // alignment, but it keeps its NUMA policy.
+  void* address = mremap(*ptr, static_cast<size_t>(old_length),
+                         static_cast<size_t>(new_length), MREMAP_MAYMOVE);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+  *ptr = reinterpret_cast<uint8_t*>(address);
+  bytes_mapped_ += new_length - old_length;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void MmapMemoryPool::UpdateStats(int64_t delta) {
+  const int64_t allocated = bytes_allocated_ += delta;
+  int64_t max_memory = max_memory_.load();
+  while (allocated > max_memory &&
+         !max_memory_.compare_exchange_weak(max_memory, allocated)) {
+  }
+}
+
+Status MmapMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (IsMapped(size)) {
+    RETURN_NOT_OK(Map(size, out));
+  } else {
+    RETURN_NOT_OK(pool_->Allocate(size, out));
+  }
+  UpdateStats(size);
+  return Status::OK();
+}
+
+Status MmapMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  if (!IsMapped(old_size) && !IsMapped(new_size)) {
+    RETURN_NOT_OK(pool_->Reallocate(old_size, new_size, ptr));
+  } else if (IsMapped(old_size) && IsMapped(new_size) &&
+             MappingSize(old_size) == MappingSize(new_size)) {
+    // The mapping is already large enough.
+  } else if (IsMapped(old_size) && IsMapped(new_size) && Remap(old_size, new_size, ptr)) {
+    // The pages were moved without copying them.
+  } else {
+    uint8_t* out;
+    RETURN_NOT_OK(Allocate(new_size, &out));
+    memcpy(out, *ptr, static_cast<size_t>(std::min(old_size, new_size)));
+    Free(*ptr, old_size);
+    *ptr = out;
+    return Status::OK();
+  }
+  UpdateStats(new_size - old_size);
+  return Status::OK();
+}
+
+void MmapMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  DCHECK_GE(bytes_allocated_, size);
+  if (IsMapped(size)) {
+    Unmap(buffer, size);
+  } else {
+    pool_->Free(buffer, size);
+  }
+  bytes_allocated_ -= size;
+}
+
+int64_t MmapMemoryPool::bytes_allocated() const { return bytes_allocated_.load(); }
+
+int64_t MmapMemoryPool::max_memory() const { return max_memory_.load(); }
+
+int64_t MmapMemoryPool::bytes_mapped() const { return bytes_mapped_.load(); }
+
 }  // namespace arrow
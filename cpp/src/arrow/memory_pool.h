@@ -19,7 +19,13 @@
 #define ARROW_MEMORY_POOL_H
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "arrow/util/visibility.h"
 
@@ -94,6 +100,263 @@ ARROW_EXPORT MemoryPool* default_memory_pool();
 #define ARROW_MEMORY_POOL_DEFAULT = default_memory_pool()
 #endif
 
+/// \brief A memory pool that caches freed small buffers per thread
+///
+/// Allocations of up to 32 KiB are rounded up to a size class (multiples of
+/// 64 bytes up to 1 KiB, powers of two above) and served from a free list of
+/// the calling thread, so allocating and freeing small buffers takes no lock
+/// and touches no shared cache line. Larger allocations, and size classes
+/// whose free list is empty, go to the parent pool. A buffer may be freed on a
+/// different thread than the one that allocated it. The free lists of a
+/// thread are returned to the parent pool when the thread exits or the pool is
+/// destroyed.
+///
+/// The statistics are kept per thread and summed when bytes_allocated() is
+/// called. max_memory() is only updated when a thread's statistics change by
+/// more than 1 MiB, so it may miss short peaks below that granularity.
+class ARROW_EXPORT ThreadCachingMemoryPool : public MemoryPool {
+ public:
+  explicit ThreadCachingMemoryPool(MemoryPool* pool ARROW_MEMORY_POOL_DEFAULT);
+  ~ThreadCachingMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+
+  int64_t max_memory() const override;
+
+  /// The number of bytes held in the free lists of all threads.
+  int64_t bytes_cached() const;
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+/// \brief A memory pool for allocations that all die at the same time
+///
+/// Allocations are carved out of large 64-byte-aligned chunks that are
+/// obtained from the parent pool, so allocating costs a pointer increment.
+/// Free does not give memory back, except that freeing or reallocating the
+/// most recent allocation reuses its space. All memory is released at once by
+/// Reset or when the pool is destroyed. Allocations that do not fit into the
+/// current chunk and are larger than a quarter of the chunk size get a chunk
+/// of their own.
+///
+/// This suits request-scoped work that creates many temporary buffers, e.g.
+/// casts, intermediate builders or IPC decoding. Buffers allocated from the
+/// arena must not be used after Reset.
+class ARROW_EXPORT ArenaMemoryPool : public MemoryPool {
+ public:
+  static constexpr int64_t kDefaultChunkSize = 1 << 20;
+
+  explicit ArenaMemoryPool(MemoryPool* pool ARROW_MEMORY_POOL_DEFAULT,
+                           int64_t chunk_size = kDefaultChunkSize);
+  ~ArenaMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  /// Release all allocations. One chunk is kept for the next allocations, the
+  /// others are returned to the parent pool.
+  void Reset();
+
+  int64_t bytes_allocated() const override;
+
+  int64_t max_memory() const override;
+
+  /// The number of bytes of the chunks obtained from the parent pool.
+  int64_t bytes_reserved() const;
+
+ private:
+  Status AllocateChunk(int64_t size, uint8_t** out);
+
+  MemoryPool* pool_;
+  const int64_t chunk_size_;
+  mutable std::mutex mutex_;
+  /// All chunks with their sizes; the current chunk is chunks_[current_chunk_].
+  std::vector<std::pair<uint8_t*, int64_t>> chunks_;
+  int64_t current_chunk_;
+  /// The offset of the free space in the current chunk.
+  int64_t offset_;
+  /// The most recent allocation in the current chunk, or nullptr.
+  uint8_t* last_allocation_;
+  int64_t bytes_allocated_;
+  int64_t bytes_reserved_;
+  int64_t max_memory_;
+};
+
+/// \brief Allocation statistics of a CappedMemoryPool
+struct ARROW_EXPORT MemoryPoolStats {
+  static constexpr int kNumSizeBuckets = 64;
+
+  MemoryPoolStats();
+
+  /// The number of successful calls to Allocate, Reallocate and Free.
+  int64_t num_allocations;
+  int64_t num_reallocations;
+  int64_t num_frees;
+  /// The number of Allocate and Reallocate calls that failed because of the
+  /// limit, including those that timed out waiting.
+  int64_t num_rejections;
+  /// The number of Allocate and Reallocate calls that had to wait for memory
+  /// to be freed.
+  int64_t num_waits;
+  /// Histogram of the requested allocation sizes. Bucket 0 counts empty
+  /// allocations, bucket i > 0 counts sizes in [2^(i-1), 2^i).
+  int64_t size_histogram[kNumSizeBuckets];
+};
+
+/// \brief A memory pool that enforces a limit on the bytes allocated through it
+///
+/// Allocations are forwarded to the parent pool. Pools can be stacked to
+/// account for memory per subsystem: a CappedMemoryPool per operator whose
+/// parent is a CappedMemoryPool per query counts the operator's allocations
+/// against both limits, and the query's statistics include all operators.
+///
+/// An allocation that would exceed the limit either fails with OutOfMemory or
+/// blocks until other threads free enough memory (backpressure), optionally
+/// with a timeout. An allocation larger than the limit always fails.
+class ARROW_EXPORT CappedMemoryPool : public MemoryPool {
+ public:
+  enum LimitPolicy {
+    /// Fail allocations that exceed the limit.
+    FAIL,
+    /// Block allocations that exceed the limit until memory is freed.
+    BLOCK
+  };
+
+  /// \param[in] pool the pool to forward the allocations to, e.g. the pool of
+  /// the enclosing subsystem
+  /// \param[in] name identifies the subsystem in error messages
+  /// \param[in] limit the maximum number of bytes allocated at any time
+  /// \param[in] policy what to do when an allocation exceeds the limit
+  /// \param[in] timeout_ms with BLOCK, how long to wait before failing; -1 to
+  /// wait forever
+  CappedMemoryPool(MemoryPool* pool, const std::string& name, int64_t limit,
+                   LimitPolicy policy = FAIL, int64_t timeout_ms = -1);
+  ~CappedMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+
+  int64_t max_memory() const override;
+
+  const std::string& name() const { return name_; }
+
+  int64_t limit() const;
+
+  /// Change the limit. Raising it wakes up blocked allocations; lowering it
+  /// below bytes_allocated() only affects allocations and reallocations that
+  /// grow, while shrinking reallocations still succeed.
+  void set_limit(int64_t limit);
+
+  MemoryPoolStats stats() const;
+
+ private:
+  /// Account for size more bytes, waiting for memory to be freed if the
+  /// policy says so.
+  Status Reserve(int64_t size);
+  void Unreserve(int64_t size);
+
+  MemoryPool* pool_;
+  const std::string name_;
+  const LimitPolicy policy_;
+  const int64_t timeout_ms_;
+  mutable std::mutex mutex_;
+  std::condition_variable memory_freed_;
+  int64_t limit_;
+  int64_t bytes_allocated_;
+  int64_t max_memory_;
+  MemoryPoolStats stats_;
+};
+
+/// \brief Options of MmapMemoryPool
+struct ARROW_EXPORT MmapMemoryPoolOptions {
+  enum HugePages {
+    /// Use the system's default pages.
+    NO_HUGE_PAGES,
+    /// Align mappings to 2 MiB and ask for transparent huge pages with
+    /// madvise(MADV_HUGEPAGE).
+    TRANSPARENT_HUGE_PAGES,
+    /// Map explicitly reserved huge pages (MAP_HUGETLB). If none are
+    /// available, fall back to transparent huge pages.
+    HUGETLB_PAGES
+  };
+
+  MmapMemoryPoolOptions()
+      : mmap_threshold(1 << 21),
+        huge_pages(TRANSPARENT_HUGE_PAGES),
+        numa_node(-1),
+        numa_interleave(false) {}
+
+  /// Allocations of at least this many bytes are mapped directly; smaller
+  /// ones are forwarded to the parent pool.
+  int64_t mmap_threshold;
+  HugePages huge_pages;
+  /// The NUMA node to place the mapped memory on, or -1 for the default
+  /// placement (on the node of the thread that first touches a page).
+  int numa_node;
+  /// Interleave the pages of each mapping across all NUMA nodes; numa_node is
+  /// ignored.
+  bool numa_interleave;
+};
+
+/// \brief A memory pool that controls page size and NUMA placement of large
+/// allocations
+///
+/// Large allocations, e.g. column buffers that are scanned by threads pinned
+/// to a socket, get their own anonymous mapping. Huge pages reduce TLB misses
+/// when scanning them, and binding them to the socket's NUMA node avoids
+/// cross-socket traffic. On Linux, mappings are grown and shrunk with mremap,
+/// so a builder whose buffers grow past the threshold does not copy the data
+/// on every reallocation. Huge pages and NUMA placement are only supported on
+/// Linux; on other platforms the options are ignored, and on Windows all
+/// allocations are forwarded to the parent pool.
+class ARROW_EXPORT MmapMemoryPool : public MemoryPool {
+ public:
+  explicit MmapMemoryPool(const MmapMemoryPoolOptions& options = MmapMemoryPoolOptions(),
+                          MemoryPool* pool ARROW_MEMORY_POOL_DEFAULT);
+  ~MmapMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+
+  int64_t max_memory() const override;
+
+  /// The number of bytes of the mappings, which are rounded up to the page
+  /// size (2 MiB with huge pages).
+  int64_t bytes_mapped() const;
+
+ private:
+  bool IsMapped(int64_t size) const;
+  int64_t MappingSize(int64_t size) const;
+  Status Map(int64_t size, uint8_t** out);
+  void Unmap(uint8_t* buffer, int64_t size);
+  // Resize a mapping with mremap. Returns false if that is not possible.
+  bool Remap(int64_t old_size, int64_t new_size, uint8_t** ptr);
+  void UpdateStats(int64_t delta);
+
+  const MmapMemoryPoolOptions options_;
+  MemoryPool* pool_;
+  std::atomic<int64_t> bytes_allocated_;
+  std::atomic<int64_t> bytes_mapped_;
+  std::atomic<int64_t> max_memory_;
+};
+
 }  // namespace arrow
 
 #endif  // ARROW_MEMORY_POOL_H
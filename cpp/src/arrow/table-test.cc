@@ -372,6 +372,38 @@ TEST_F(TestTable, ConcatenateTables) {
   ASSERT_RAISES(Invalid, ConcatenateTables({t1, t3}, &result));
 }
 
+TEST_F(TestTable, CombineChunks) {
+  const int64_t length = 10;
+  std::vector<std::shared_ptr<RecordBatch>> batches;
+  for (int i = 0; i < 3; ++i) {
+    MakeExample1(length);
+    batches.push_back(std::make_shared<RecordBatch>(schema_, length, arrays_));
+  }
+  std::shared_ptr<Table> table, result;
+  ASSERT_OK(Table::FromRecordBatches(batches, &table));
+
+  ASSERT_OK(table->CombineChunks(pool_, 0, &result));
+  ASSERT_FALSE(result->IsChunked());
+  ASSERT_EQ(30, result->num_rows());
+  ASSERT_TRUE(result->Equals(*table));
+
+  ASSERT_OK(table->CombineChunks(pool_, 12, &result));
+  ASSERT_TRUE(result->Equals(*table));
+  for (int i = 0; i < result->num_columns(); ++i) {
+    const ChunkedArray& chunks = *result->column(i)->data();
+    ASSERT_EQ(3, chunks.num_chunks());
+    ASSERT_EQ(12, chunks.chunk(0)->length());
+    ASSERT_EQ(12, chunks.chunk(1)->length());
+    ASSERT_EQ(6, chunks.chunk(2)->length());
+  }
+
+  // Chunks of the right size are not copied.
+  ASSERT_OK(table->CombineChunks(pool_, 10, &result));
+  ASSERT_EQ(table->column(0)->data()->chunk(1), result->column(0)->data()->chunk(1));
+
+  ASSERT_RAISES(Invalid, table->CombineChunks(pool_, -1, &result));
+}
+
 TEST_F(TestTable, RemoveColumn) {
   const int64_t length = 10;
   MakeExample1(length);
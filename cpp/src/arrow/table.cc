@@ -476,6 +476,73 @@ bool Table::IsChunked() const {
   return false;
 }
 
+namespace {
+
+Status CombineColumnChunks(const ArrayVector& chunks, int64_t chunk_size,
+                           MemoryPool* pool, ArrayVector* out) {
+  ArrayVector pieces;
+  int64_t pieces_length = 0;
+  auto flush = [&]() -> Status {
+    std::shared_ptr<Array> combined;
+    if (pieces.size() == 1) {
+      combined = pieces[0];
+    } else {
+      RETURN_NOT_OK(Concatenate(pieces, pool, &combined));
+    }
+    out->push_back(combined);
+    pieces.clear();
+    pieces_length = 0;
+    return Status::OK();
+  };
+
+  for (const auto& chunk : chunks) {
+    int64_t position = 0;
+    while (position < chunk->length()) {
+      const int64_t length =
+          std::min(chunk->length() - position, chunk_size - pieces_length);
+      if (position == 0 && length == chunk->length()) {
+        pieces.push_back(chunk);
+      } else {
+        pieces.push_back(chunk->Slice(position, length));
+      }
+      position += length;
+      pieces_length += length;
+      if (pieces_length == chunk_size) {
+        RETURN_NOT_OK(flush());
+      }
+    }
+  }
+  if (!pieces.empty()) {
+    RETURN_NOT_OK(flush());
+  }
+  if (out->empty()) {
+    // Keep the empty chunks of an empty column
+    *out = chunks;
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status Table::CombineChunks(MemoryPool* pool, int64_t chunk_size,
+                            std::shared_ptr<Table>* out) const {
+  if (chunk_size < 0) {
+    return Status::Invalid("Chunk size must not be negative");
+  }
+  if (chunk_size == 0) {
+    chunk_size = std::max(num_rows_, static_cast<int64_t>(1));
+  }
+  std::vector<std::shared_ptr<Column>> columns(columns_.size());
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    ArrayVector chunks;
+    RETURN_NOT_OK(
+        CombineColumnChunks(columns_[i]->data()->chunks(), chunk_size, pool, &chunks));
+    columns[i] = std::make_shared<Column>(columns_[i]->field(), chunks);
+  }
+  *out = std::make_shared<Table>(schema_, columns, num_rows_);
+  return Status::OK();
+}
+
 Status MakeTable(const std::shared_ptr<Schema>& schema,
                  const std::vector<std::shared_ptr<Array>>& arrays,
                  std::shared_ptr<Table>* table) {
@@ -31,6 +31,7 @@
 namespace arrow {
 
 class KeyValueMetadata;
+class MemoryPool;
 class Status;
 
 using ArrayVector = std::vector<std::shared_ptr<Array>>;
@@ -271,6 +272,21 @@ class ARROW_EXPORT Table {
   /// \brief Return true if any column has multiple chunks
   bool IsChunked() const;
 
+  /// \brief Rewrite the columns into chunks of the given number of rows
+  ///
+  /// Consecutive chunks (or parts of chunks) are concatenated into new chunks
+  /// of chunk_size rows; only the last chunk of a column may be shorter. Input
+  /// chunks that already cover a whole output chunk are reused without
+  /// copying.
+  ///
+  /// \param[in] pool memory pool to allocate the new chunks from
+  /// \param[in] chunk_size the number of rows per chunk, 0 to combine each
+  /// column into a single chunk
+  /// \param[out] out the table with the combined chunks
+  /// \return Status
+  Status CombineChunks(MemoryPool* pool, int64_t chunk_size,
+                       std::shared_ptr<Table>* out) const;
+
  private:
   ARROW_DISALLOW_COPY_AND_ASSIGN(Table);
 
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -127,6 +128,132 @@ TEST_F(TestRecordBatchBuilder, Basics) {
   ASSERT_EQ(4096, builder->initial_capacity());
 }
 
+std::shared_ptr<Schema> ExampleRowSchema() {
+  return ::arrow::schema({field("f0", int32()), field("f1", utf8()),
+                          field("f2", float64()), field("f3", boolean())});
+}
+
+TEST_F(TestRecordBatchBuilder, AppendRow) {
+  auto schema = ExampleRowSchema();
+  std::unique_ptr<RecordBatchBuilder> builder;
+  ASSERT_OK(RecordBatchBuilder::Make(schema, pool_, &builder));
+
+  ASSERT_OK(builder->AppendRow(1, std::string("a"), 1.5, true));
+  ASSERT_OK(builder->AppendRow(nullptr, std::string("bb"), nullptr, false));
+  ASSERT_OK(builder->AppendRow(3, nullptr, 3.5, nullptr));
+  ASSERT_EQ(3, builder->num_rows());
+
+  std::shared_ptr<Array> a0, a1, a2, a3;
+  ArrayFromVector<Int32Type, int32_t>({true, false, true}, {1, 0, 3}, &a0);
+  ArrayFromVector<StringType, std::string>({true, true, false}, {"a", "bb", ""}, &a1);
+  ArrayFromVector<DoubleType, double>({true, false, true}, {1.5, 0, 3.5}, &a2);
+  ArrayFromVector<BooleanType, bool>({true, true, false}, {true, false, false}, &a3);
+  RecordBatch expected(schema, 3, {a0, a1, a2, a3});
+
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(builder->Flush(&batch));
+  ASSERT_BATCHES_EQUAL(expected, *batch);
+  ASSERT_EQ(0, builder->num_rows());
+
+  // The same rows as a block
+  std::vector<std::tuple<int32_t, std::string, double, bool>> rows = {
+      std::make_tuple(1, "a", 1.5, true), std::make_tuple(2, "bb", 2.5, false)};
+  ASSERT_OK(builder->AppendRows(rows));
+  ASSERT_OK(builder->Flush(&batch));
+  ASSERT_EQ(2, batch->num_rows());
+  ASSERT_EQ(2.5, static_cast<const DoubleArray&>(*batch->column(2)).Value(1));
+}
+
+TEST_F(TestRecordBatchBuilder, AppendRowInvalid) {
+  auto schema = ::arrow::schema({field("f0", int32()), field("f1", struct_({}))});
+  std::unique_ptr<RecordBatchBuilder> builder;
+  ASSERT_OK(RecordBatchBuilder::Make(schema, pool_, &builder));
+
+  ASSERT_RAISES(Invalid, builder->AppendRow(1));
+  ASSERT_RAISES(Invalid, builder->AppendRow(int64_t(1), nullptr));
+  ASSERT_RAISES(Invalid, builder->AppendRow(1, nullptr));
+  ASSERT_RAISES(Invalid, builder->AppendRow(1, std::string("a")));
+  ASSERT_EQ(0, builder->GetField(0)->length());
+}
+
+TEST_F(TestRecordBatchBuilder, BatchThresholds) {
+  auto schema = ExampleRowSchema();
+  std::unique_ptr<RecordBatchBuilder> builder;
+  ASSERT_OK(RecordBatchBuilder::Make(schema, pool_, &builder));
+
+  // Rows
+  builder->SetBatchThresholds(3, 0);
+  std::vector<std::tuple<int32_t, std::string, double, bool>> rows;
+  for (int32_t i = 0; i < 7; ++i) {
+    rows.emplace_back(i, std::string(100, 'x'), i * 0.5, i % 2 == 0);
+  }
+  ASSERT_OK(builder->AppendRows(rows));
+  ASSERT_EQ(1, builder->num_rows());
+
+  std::vector<std::shared_ptr<RecordBatch>> batches;
+  builder->TakeBatches(&batches);
+  ASSERT_EQ(2, batches.size());
+  for (const auto& batch : batches) {
+    ASSERT_EQ(3, batch->num_rows());
+  }
+  ASSERT_EQ(3, static_cast<const Int32Array&>(*batches[1]->column(0)).Value(0));
+  builder->TakeBatches(&batches);
+  ASSERT_EQ(2, batches.size());
+
+  // The builders of the next batch are sized like the previous batch
+  auto string_builder = builder->GetFieldAs<StringBuilder>(1);
+  ASSERT_GE(string_builder->capacity(), 3);
+  ASSERT_GE(string_builder->value_data_capacity(), 300);
+
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(builder->Flush(&batch));
+  ASSERT_EQ(1, batch->num_rows());
+  ASSERT_EQ(6, static_cast<const Int32Array&>(*batch->column(0)).Value(0));
+
+  // Bytes: each row takes 4 + 100 + 4 + 8 + 1 bytes
+  builder->SetBatchThresholds(0, 300);
+  for (int32_t i = 0; i < 7; ++i) {
+    ASSERT_OK(builder->AppendRow(i, std::string(100, 'x'), 0.5, true));
+  }
+  batches.clear();
+  builder->TakeBatches(&batches);
+  ASSERT_EQ(2, batches.size());
+  ASSERT_EQ(3, batches[0]->num_rows());
+  ASSERT_EQ(1, builder->num_rows());
+}
+
+TEST_F(TestRecordBatchBuilder, LowerBatchThreshold) {
+  auto schema = ExampleRowSchema();
+  std::unique_ptr<RecordBatchBuilder> builder;
+  ASSERT_OK(RecordBatchBuilder::Make(schema, pool_, &builder));
+
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_OK(builder->AppendRow(i, std::string("x"), 0.5, true));
+  }
+  // The current batch already has more rows than the new threshold
+  builder->SetBatchThresholds(5, 0);
+  std::vector<std::tuple<int32_t, std::string, double, bool>> rows;
+  for (int32_t i = 10; i < 13; ++i) {
+    rows.emplace_back(i, std::string("x"), 0.5, true);
+  }
+  ASSERT_OK(builder->AppendRows(rows));
+  ASSERT_EQ(3, builder->num_rows());
+
+  std::vector<std::shared_ptr<RecordBatch>> batches;
+  builder->TakeBatches(&batches);
+  ASSERT_EQ(1, batches.size());
+  ASSERT_EQ(10, batches[0]->num_rows());
+
+  // AppendRow completes the batch including the appended row
+  builder->SetBatchThresholds(2, 0);
+  ASSERT_OK(builder->AppendRow(13, std::string("x"), 0.5, true));
+  ASSERT_EQ(0, builder->num_rows());
+  builder->TakeBatches(&batches);
+  ASSERT_EQ(2, batches.size());
+  ASSERT_EQ(4, batches[1]->num_rows());
+  ASSERT_EQ(13, static_cast<const Int32Array&>(*batches[1]->column(0)).Value(3));
+}
+
 TEST_F(TestRecordBatchBuilder, InvalidFieldLength) {
   auto schema = ExampleSchema1();
 
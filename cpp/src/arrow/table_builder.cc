@@ -36,7 +36,13 @@ namespace arrow {
 
 RecordBatchBuilder::RecordBatchBuilder(const std::shared_ptr<Schema>& schema,
                                        MemoryPool* pool, int64_t initial_capacity)
-    : schema_(schema), initial_capacity_(initial_capacity), pool_(pool) {}
+    : schema_(schema),
+      initial_capacity_(initial_capacity),
+      pool_(pool),
+      max_batch_rows_(0),
+      max_batch_bytes_(0),
+      num_rows_(0),
+      num_bytes_(0) {}
 
 Status RecordBatchBuilder::Make(const std::shared_ptr<Schema>& schema, MemoryPool* pool,
                                 std::unique_ptr<RecordBatchBuilder>* builder) {
@@ -65,6 +71,7 @@ Status RecordBatchBuilder::Flush(bool reset_builders,
     length = fields[i]->length();
   }
   *batch = std::make_shared<RecordBatch>(schema_, length, std::move(fields));
+  num_rows_ = num_bytes_ = 0;
   if (reset_builders) {
     return InitBuilders();
   } else {
@@ -81,12 +88,105 @@ void RecordBatchBuilder::SetInitialCapacity(int64_t capacity) {
   initial_capacity_ = capacity;
 }
 
+void RecordBatchBuilder::SetBatchThresholds(int64_t max_rows, int64_t max_bytes) {
+  DCHECK_GE(max_rows, 0);
+  DCHECK_GE(max_bytes, 0);
+  max_batch_rows_ = max_rows;
+  max_batch_bytes_ = max_bytes;
+}
+
+void RecordBatchBuilder::TakeBatches(std::vector<std::shared_ptr<RecordBatch>>* out) {
+  out->insert(out->end(), completed_batches_.begin(), completed_batches_.end());
+  completed_batches_.clear();
+}
+
+Status RecordBatchBuilder::CompleteBatch() {
+  // Size the next batch like this one
+  const int64_t num_rows = num_rows_;
+  std::vector<int64_t> value_data_lengths(this->num_fields(), 0);
+  for (int i = 0; i < this->num_fields(); ++i) {
+    const Type::type id = raw_field_builders_[i]->type()->id();
+    if (id == Type::STRING || id == Type::BINARY) {
+      value_data_lengths[i] =
+          static_cast<BinaryBuilder*>(raw_field_builders_[i])->value_data_length();
+    }
+  }
+
+  std::shared_ptr<RecordBatch> batch;
+  RETURN_NOT_OK(Flush(false, &batch));
+  completed_batches_.push_back(batch);
+
+  for (int i = 0; i < this->num_fields(); ++i) {
+    RETURN_NOT_OK(raw_field_builders_[i]->Init(std::max(num_rows, initial_capacity_)));
+    if (value_data_lengths[i] > 0) {
+      RETURN_NOT_OK(static_cast<BinaryBuilder*>(raw_field_builders_[i])
+                        ->ReserveData(value_data_lengths[i]));
+    }
+  }
+  return Status::OK();
+}
+
+Status RecordBatchBuilder::ReserveRows(int64_t num_rows) {
+  for (int i = 0; i < this->num_fields(); ++i) {
+    RETURN_NOT_OK(raw_field_builders_[i]->Reserve(num_rows));
+  }
+  return Status::OK();
+}
+
+namespace {
+
+template <typename BuilderType>
+Status AppendNullTo(ArrayBuilder* builder) {
+  return static_cast<BuilderType*>(builder)->AppendNull();
+}
+
+#define NULL_APPENDER_CASE(ENUM, BuilderType) \
+  case Type::ENUM:                            \
+    return &AppendNullTo<BuilderType>;
+
+// Struct fields are left out, as a null struct needs a slot in every child
+Status (*GetNullAppender(const DataType& type))(ArrayBuilder*) {
+  switch (type.id()) {
+    NULL_APPENDER_CASE(NA, NullBuilder);
+    NULL_APPENDER_CASE(UINT8, UInt8Builder);
+    NULL_APPENDER_CASE(INT8, Int8Builder);
+    NULL_APPENDER_CASE(UINT16, UInt16Builder);
+    NULL_APPENDER_CASE(INT16, Int16Builder);
+    NULL_APPENDER_CASE(UINT32, UInt32Builder);
+    NULL_APPENDER_CASE(INT32, Int32Builder);
+    NULL_APPENDER_CASE(UINT64, UInt64Builder);
+    NULL_APPENDER_CASE(INT64, Int64Builder);
+    NULL_APPENDER_CASE(DATE32, Date32Builder);
+    NULL_APPENDER_CASE(DATE64, Date64Builder);
+    NULL_APPENDER_CASE(TIME32, Time32Builder);
+    NULL_APPENDER_CASE(TIME64, Time64Builder);
+    NULL_APPENDER_CASE(TIMESTAMP, TimestampBuilder);
+    NULL_APPENDER_CASE(BOOL, BooleanBuilder);
+    NULL_APPENDER_CASE(HALF_FLOAT, HalfFloatBuilder);
+    NULL_APPENDER_CASE(FLOAT, FloatBuilder);
+    NULL_APPENDER_CASE(DOUBLE, DoubleBuilder);
+    NULL_APPENDER_CASE(STRING, BinaryBuilder);
+    NULL_APPENDER_CASE(BINARY, BinaryBuilder);
+    NULL_APPENDER_CASE(FIXED_SIZE_BINARY, FixedSizeBinaryBuilder);
+    NULL_APPENDER_CASE(DECIMAL, FixedSizeBinaryBuilder);
+    NULL_APPENDER_CASE(LIST, ListBuilder);
+    default:
+      return nullptr;
+  }
+}
+
+#undef NULL_APPENDER_CASE
+
+}  // namespace
+
 Status RecordBatchBuilder::CreateBuilders() {
   field_builders_.resize(this->num_fields());
   raw_field_builders_.resize(this->num_fields());
+  null_appenders_.resize(this->num_fields());
   for (int i = 0; i < this->num_fields(); ++i) {
     RETURN_NOT_OK(MakeBuilder(pool_, schema_->field(i)->type(), &field_builders_[i]));
     raw_field_builders_[i] = field_builders_[i].get();
+    null_appenders_[i] = GetNullAppender(*schema_->field(i)->type());
   }
   return Status::OK();
 }
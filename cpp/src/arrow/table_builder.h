@@ -18,22 +18,83 @@
 #ifndef ARROW_TABLE_BUILDER_H
 #define ARROW_TABLE_BUILDER_H
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "arrow/builder.h"
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/util/visibility.h"
 
 namespace arrow {
 
-class ArrayBuilder;
 class MemoryPool;
 class RecordBatch;
 class Schema;
 
+namespace internal {
+
+/// \brief How AppendRow appends a C++ value to a field builder
+///
+/// Specialized for the C++ types that can appear in a row: the primitive
+/// C types, std::string for binary and string fields, and nullptr for a null
+/// of any field type.
+template <typename T>
+struct RowValueTraits {};
+
+#define ARROW_ROW_VALUE_TRAITS(CType, ArrowType)                          \
+  template <>                                                             \
+  struct RowValueTraits<CType> {                                          \
+    using BuilderType = typename TypeTraits<ArrowType>::BuilderType;      \
+    static bool Accepts(Type::type id) { return id == ArrowType::type_id; } \
+    static int64_t size(CType) { return sizeof(CType); }                  \
+    static Status Append(ArrayBuilder* builder, CType value) {            \
+      return static_cast<BuilderType*>(builder)->Append(value);           \
+    }                                                                     \
+  };
+
+ARROW_ROW_VALUE_TRAITS(bool, BooleanType)
+ARROW_ROW_VALUE_TRAITS(int8_t, Int8Type)
+ARROW_ROW_VALUE_TRAITS(uint8_t, UInt8Type)
+ARROW_ROW_VALUE_TRAITS(int16_t, Int16Type)
+ARROW_ROW_VALUE_TRAITS(uint16_t, UInt16Type)
+ARROW_ROW_VALUE_TRAITS(int32_t, Int32Type)
+ARROW_ROW_VALUE_TRAITS(uint32_t, UInt32Type)
+ARROW_ROW_VALUE_TRAITS(int64_t, Int64Type)
+ARROW_ROW_VALUE_TRAITS(uint64_t, UInt64Type)
+ARROW_ROW_VALUE_TRAITS(float, FloatType)
+ARROW_ROW_VALUE_TRAITS(double, DoubleType)
+
+#undef ARROW_ROW_VALUE_TRAITS
+
+template <>
+struct RowValueTraits<std::string> {
+  static bool Accepts(Type::type id) { return id == Type::STRING || id == Type::BINARY; }
+  static int64_t size(const std::string& value) {
+    return static_cast<int64_t>(value.size() + sizeof(int32_t));
+  }
+  static Status Append(ArrayBuilder* builder, const std::string& value) {
+    return static_cast<BinaryBuilder*>(builder)->Append(value);
+  }
+};
+
+/// \brief Identifies a row signature, the C++ types of the values of a row
+template <typename... Values>
+struct RowSignature {
+  static const char id;
+};
+
+template <typename... Values>
+const char RowSignature<Values...>::id = 0;
+
+}  // namespace internal
+
 /// \class RecordBatchBuilder
 /// \brief Helper class for creating record batches iteratively given a known
 /// schema
@@ -68,6 +129,80 @@ class RecordBatchBuilder {
     return static_cast<T*>(raw_field_builders_[i]);
   }
 
+  /// \brief Append one row to all field builders
+  ///
+  /// Each value is appended to the builder of the field at its position; the
+  /// C++ type of a value selects the builder type (see
+  /// internal::RowValueTraits), and nullptr appends a null. Whether the field
+  /// types accept the C++ types of a row is checked the first time they are
+  /// used, so appending involves no type dispatch. Completes a batch when a
+  /// threshold set with SetBatchThresholds is reached.
+  ///
+  /// If appending a value fails, the values already appended to the fields
+  /// before it are not removed. The fields then differ in length and the
+  /// builder cannot be used any further.
+  ///
+  /// \param[in] values one value per field
+  /// \return Status, Invalid if the number or the types of the values do not
+  /// match the fields
+  template <typename... Values>
+  Status AppendRow(const Values&... values) {
+    RETURN_NOT_OK(CheckRowSignature<Values...>());
+    return AppendTuple<0>(std::tie(values...));
+  }
+
+  /// \brief Append a block of rows to all field builders
+  ///
+  /// Like calling AppendRow for each row, but the builders are reserved for
+  /// the whole block (up to the row threshold) at once. As with AppendRow, the
+  /// builder cannot be used any further after an error.
+  ///
+  /// \param[in] rows the rows, one tuple element per field
+  /// \return Status
+  template <typename... Values>
+  Status AppendRows(const std::vector<std::tuple<Values...>>& rows) {
+    RETURN_NOT_OK(CheckRowSignature<Values...>());
+    int64_t remaining = static_cast<int64_t>(rows.size());
+    auto row = rows.begin();
+    while (remaining > 0) {
+      if (max_batch_rows_ > 0 && num_rows_ >= max_batch_rows_) {
+        // The row threshold was lowered below the size of the current batch
+        RETURN_NOT_OK(CompleteBatch());
+      }
+      int64_t block = remaining;
+      if (max_batch_rows_ > 0) {
+        block = std::min(block, max_batch_rows_ - num_rows_);
+      }
+      RETURN_NOT_OK(ReserveRows(block));
+      for (int64_t i = 0; i < block; ++i, ++row) {
+        RETURN_NOT_OK(AppendTuple<0>(*row));
+      }
+      remaining -= block;
+    }
+    return Status::OK();
+  }
+
+  /// \brief Complete batches automatically while appending rows
+  ///
+  /// When AppendRow or AppendRows brings the current batch to max_rows rows or
+  /// to an estimated max_bytes bytes of value data, the batch is finished and
+  /// queued (see TakeBatches). The builders of the next batch are pre-sized
+  /// from the finished one. Rows appended directly to the field builders are
+  /// not counted. A current batch that already exceeds a new threshold is
+  /// completed by the next append.
+  ///
+  /// \param[in] max_rows the row count that completes a batch, 0 for no limit
+  /// \param[in] max_bytes the estimated size that completes a batch, 0 for no
+  /// limit
+  void SetBatchThresholds(int64_t max_rows, int64_t max_bytes);
+
+  /// \brief Move the batches completed by the thresholds to out, oldest first
+  void TakeBatches(std::vector<std::shared_ptr<RecordBatch>>* out);
+
+  /// \brief The number of rows appended with AppendRow(s) to the current
+  /// batch
+  int64_t num_rows() const { return num_rows_; }
+
   /// \brief Finish current batch and optionally reset
   /// \param[in] reset_builders the resulting RecordBatch
   /// \param[out] batch the resulting RecordBatch
@@ -98,12 +233,95 @@ class RecordBatchBuilder {
   Status CreateBuilders();
   Status InitBuilders();
 
+  // Finish the current batch, queue it and pre-size the builders for the next
+  Status CompleteBatch();
+  Status ReserveRows(int64_t num_rows);
+  Status AppendNull(int i) { return null_appenders_[i](raw_field_builders_[i]); }
+
+  // Check that the fields accept the types of a row once per row signature
+  template <typename... Values>
+  Status CheckRowSignature() {
+    const void* signature = &internal::RowSignature<Values...>::id;
+    if (std::find(checked_signatures_.begin(), checked_signatures_.end(), signature) !=
+        checked_signatures_.end()) {
+      return Status::OK();
+    }
+    if (sizeof...(Values) != static_cast<size_t>(num_fields())) {
+      return Status::Invalid("Number of row values does not match the number of fields");
+    }
+    RETURN_NOT_OK((CheckRowTypes<0, std::tuple<Values...>>()));
+    checked_signatures_.push_back(signature);
+    return Status::OK();
+  }
+
+  template <size_t I, typename Tuple>
+  typename std::enable_if<I == std::tuple_size<Tuple>::value, Status>::type
+  CheckRowTypes() {
+    return Status::OK();
+  }
+
+  template <size_t I, typename Tuple>
+  typename std::enable_if<(I < std::tuple_size<Tuple>::value), Status>::type
+  CheckRowTypes() {
+    using T = typename std::tuple_element<I, Tuple>::type;
+    if (!Accepts(static_cast<int>(I), static_cast<T*>(NULLPTR))) {
+      return Status::Invalid("Row value does not match the type of field " +
+                             schema_->field(static_cast<int>(I))->name());
+    }
+    return CheckRowTypes<I + 1, Tuple>();
+  }
+
+  template <typename T>
+  bool Accepts(int i, T*) const {
+    return internal::RowValueTraits<T>::Accepts(raw_field_builders_[i]->type()->id());
+  }
+
+  bool Accepts(int i, std::nullptr_t*) const { return null_appenders_[i] != NULLPTR; }
+
+  template <typename T>
+  Status AppendValue(int i, const T& value, int64_t* bytes) {
+    *bytes += internal::RowValueTraits<T>::size(value);
+    return internal::RowValueTraits<T>::Append(raw_field_builders_[i], value);
+  }
+
+  Status AppendValue(int i, std::nullptr_t, int64_t*) { return AppendNull(i); }
+
+  template <size_t I, typename Tuple>
+  typename std::enable_if<I == std::tuple_size<Tuple>::value, Status>::type AppendTuple(
+      const Tuple&, int64_t bytes = 0) {
+    ++num_rows_;
+    num_bytes_ += bytes;
+    if ((max_batch_rows_ > 0 && num_rows_ >= max_batch_rows_) ||
+        (max_batch_bytes_ > 0 && num_bytes_ >= max_batch_bytes_)) {
+      return CompleteBatch();
+    }
+    return Status::OK();
+  }
+
+  template <size_t I, typename Tuple>
+  typename std::enable_if<(I < std::tuple_size<Tuple>::value), Status>::type AppendTuple(
+      const Tuple& row, int64_t bytes = 0) {
+    RETURN_NOT_OK(AppendValue(static_cast<int>(I), std::get<I>(row), &bytes));
+    return AppendTuple<I + 1>(row, bytes);
+  }
+
   std::shared_ptr<Schema> schema_;
   int64_t initial_capacity_;
   MemoryPool* pool_;
 
   std::vector<std::unique_ptr<ArrayBuilder>> field_builders_;
   std::vector<ArrayBuilder*> raw_field_builders_;
+
+  // Appends a null to a field builder, resolved from the field type once;
+  // null if nulls cannot be appended to the field with AppendRow
+  std::vector<Status (*)(ArrayBuilder*)> null_appenders_;
+  std::vector<const void*> checked_signatures_;
+
+  int64_t max_batch_rows_;
+  int64_t max_batch_bytes_;
+  int64_t num_rows_;
+  int64_t num_bytes_;
+  std::vector<std::shared_ptr<RecordBatch>> completed_batches_;
 };
 
 }  // namespace arrow
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -182,6 +183,29 @@ TEST(BitUtilTests, TestCopyBitmap) {
   }
 }
 
+TEST(BitUtilTests, TestCopyBitmapInto) {
+  std::vector<uint8_t> src(16);
+  test::random_bytes(16, 0, src.data());
+
+  std::vector<std::pair<int64_t, int64_t>> offsets = {{0, 0}, {8, 16}, {3, 0},
+                                                      {0, 5}, {5, 13}, {7, 7}};
+  for (const auto& offset : offsets) {
+    const int64_t length = 100 - offset.first;
+    std::vector<uint8_t> dest(16, 0xFF);
+    CopyBitmap(src.data(), offset.first, length - 11, dest.data(), offset.second);
+    for (int64_t i = 0; i < offset.second; ++i) {
+      ASSERT_TRUE(BitUtil::GetBit(dest.data(), i));
+    }
+    for (int64_t i = 0; i < length - 11; ++i) {
+      ASSERT_EQ(BitUtil::GetBit(src.data(), offset.first + i),
+                BitUtil::GetBit(dest.data(), offset.second + i));
+    }
+    for (int64_t i = offset.second + length - 11; i < 128; ++i) {
+      ASSERT_TRUE(BitUtil::GetBit(dest.data(), i));
+    }
+  }
+}
+
 TEST(BitUtil, Ceil) {
   EXPECT_EQ(BitUtil::Ceil(0, 1), 0);
   EXPECT_EQ(BitUtil::Ceil(1, 1), 1);
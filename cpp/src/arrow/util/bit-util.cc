@@ -108,14 +108,25 @@ Status CopyBitmap(MemoryPool* pool, const uint8_t* data, int64_t offset, int64_t
                   std::shared_ptr<Buffer>* out) {
   std::shared_ptr<Buffer> buffer;
   RETURN_NOT_OK(GetEmptyBitmap(pool, length, &buffer));
-  uint8_t* dest = buffer->mutable_data();
-  for (int64_t i = 0; i < length; ++i) {
-    BitUtil::SetBitTo(dest, i, BitUtil::GetBit(data, i + offset));
-  }
+  CopyBitmap(data, offset, length, buffer->mutable_data(), 0);
   *out = buffer;
   return Status::OK();
 }
 
+void CopyBitmap(const uint8_t* data, int64_t offset, int64_t length, uint8_t* dest,
+                int64_t dest_offset) {
+  int64_t i = 0;
+  if (offset % 8 == 0 && dest_offset % 8 == 0) {
+    // byte aligned, can use memcpy for the whole bytes
+    std::memcpy(dest + dest_offset / 8, data + offset / 8,
+                static_cast<size_t>(length / 8));
+    i = (length / 8) * 8;
+  }
+  for (; i < length; ++i) {
+    BitUtil::SetBitTo(dest, dest_offset + i, BitUtil::GetBit(data, offset + i));
+  }
+}
+
 bool BitmapEquals(const uint8_t* left, int64_t left_offset, const uint8_t* right,
                   int64_t right_offset, int64_t bit_length) {
   if (left_offset % 8 == 0 && right_offset % 8 == 0) {
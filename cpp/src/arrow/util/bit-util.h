@@ -527,6 +527,19 @@ ARROW_EXPORT
 Status CopyBitmap(MemoryPool* pool, const uint8_t* bitmap, int64_t offset, int64_t length,
                   std::shared_ptr<Buffer>* out);
 
+/// Copy a bit range of an existing bitmap into another bitmap
+///
+/// The bits of dest outside of the range are not modified.
+///
+/// \param[in] data source data
+/// \param[in] offset bit offset into the source data
+/// \param[in] length number of bits to copy
+/// \param[in] dest destination data
+/// \param[in] dest_offset bit offset into the destination data
+ARROW_EXPORT
+void CopyBitmap(const uint8_t* data, int64_t offset, int64_t length, uint8_t* dest,
+                int64_t dest_offset);
+
 /// Compute the number of 1's in the given data array
 ///
 /// \param[in] data a packed LSB-ordered bitmap as a byte array
@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -37,6 +38,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -53,10 +57,151 @@
 
 namespace plasma {
 
-// Number of threads used for memcopy and hash computations.
-constexpr int64_t kThreadPoolSize = 8;
+// Number of chunks that large objects are split into for hashing. Every chunk
+// is hashed separately so the chunks can be processed in parallel. This is part
+// of the digest format, so it does not depend on the number of threads.
+constexpr int64_t kHashNumChunks = 8;
+// Objects smaller than this are hashed in one piece.
 constexpr int64_t kBytesInMB = 1 << 20;
-static std::vector<std::thread> threadpool_(kThreadPoolSize);
+
+/// A fixed set of threads that run data-parallel loops for the client. The
+/// threads are started once and wait on a condition variable between loops,
+/// so hashing or copying an object does not pay for thread creation.
+class ClientThreadPool {
+ public:
+  /// Start num_threads - 1 worker threads; the thread calling ParallelFor
+  /// works on the tasks as well.
+  explicit ClientThreadPool(int num_threads)
+      : func_(nullptr), num_tasks_(0), next_task_(0), pending_tasks_(0),
+        shutdown_(false) {
+    for (int i = 0; i < num_threads - 1; ++i) {
+      workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+  }
+
+  ~ClientThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /// Call func(i) for every i in [0, num_tasks) and return once all calls are
+  /// done. This must not be called concurrently from several threads.
+  void ParallelFor(int num_tasks, const std::function<void(int)>& func) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      func_ = &func;
+      num_tasks_ = num_tasks;
+      next_task_ = 0;
+      pending_tasks_ = num_tasks;
+    }
+    work_available_.notify_all();
+    std::unique_lock<std::mutex> lock(mutex_);
+    RunTasks(&lock);
+    work_done_.wait(lock, [this]() { return pending_tasks_ == 0; });
+    func_ = nullptr;
+  }
+
+ private:
+  // Run tasks of the current loop until there are none left to claim. The lock
+  // must be held on entry and is held on exit.
+  void RunTasks(std::unique_lock<std::mutex>* lock) {
+    while (next_task_ < num_tasks_) {
+      int task = next_task_++;
+      const std::function<void(int)>& func = *func_;
+      lock->unlock();
+      func(task);
+      lock->lock();
+      if (--pending_tasks_ == 0) {
+        work_done_.notify_all();
+      }
+    }
+  }
+
+  void WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_available_.wait(lock,
+                           [this]() { return shutdown_ || next_task_ < num_tasks_; });
+      if (shutdown_) {
+        return;
+      }
+      RunTasks(&lock);
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+  const std::function<void(int)>* func_;
+  int num_tasks_;
+  int next_task_;
+  int pending_tasks_;
+  bool shutdown_;
+};
+
+/// Hash state of an object whose data is hashed while it is being written, see
+/// PlasmaClient::UpdateDigest. This produces the same digest as hashing the
+/// finished object with compute_object_hash.
+struct IncrementalObjectHash {
+  explicit IncrementalObjectHash(int64_t data_size)
+      : data_size(data_size),
+        bytes_hashed(0),
+        chunked(data_size >= kBytesInMB),
+        chunk_size((data_size / BLOCK_SIZE / kHashNumChunks) * BLOCK_SIZE),
+        chunk_index(0) {
+    XXH64_reset(&state, XXH64_DEFAULT_SEED);
+  }
+
+  void Update(const uint8_t* data, int64_t nbytes) {
+    if (!chunked) {
+      XXH64_update(&state, data, nbytes);
+      bytes_hashed += nbytes;
+      return;
+    }
+    while (nbytes > 0) {
+      // The chunk with index kHashNumChunks is the suffix of the object.
+      int64_t chunk_end =
+          chunk_index < kHashNumChunks ? (chunk_index + 1) * chunk_size : data_size;
+      int64_t length = std::min(nbytes, chunk_end - bytes_hashed);
+      XXH64_update(&state, data, length);
+      data += length;
+      nbytes -= length;
+      bytes_hashed += length;
+      if (bytes_hashed == chunk_end && chunk_index < kHashNumChunks) {
+        chunk_hashes[chunk_index++] = XXH64_digest(&state);
+        XXH64_reset(&state, XXH64_DEFAULT_SEED);
+      }
+    }
+  }
+
+  uint64_t Finish(const uint8_t* metadata, int64_t metadata_size) {
+    DCHECK_EQ(bytes_hashed, data_size);
+    if (chunked) {
+      DCHECK_EQ(chunk_index, kHashNumChunks);
+      chunk_hashes[kHashNumChunks] = XXH64_digest(&state);
+      XXH64_reset(&state, XXH64_DEFAULT_SEED);
+      XXH64_update(&state, reinterpret_cast<unsigned char*>(chunk_hashes),
+                   sizeof(chunk_hashes));
+    }
+    XXH64_update(&state, metadata, metadata_size);
+    return XXH64_digest(&state);
+  }
+
+  int64_t data_size;
+  int64_t bytes_hashed;
+  bool chunked;
+  int64_t chunk_size;
+  int64_t chunk_index;
+  uint64_t chunk_hashes[kHashNumChunks + 1];
+  XXH64_state_t state;
+};
 
 struct ObjectInUseEntry {
   /// A count of the number of times this client has called PlasmaClient::Create
@@ -70,9 +215,16 @@ struct ObjectInUseEntry {
   PlasmaObject object;
   /// A flag representing whether the object has been sealed.
   bool is_sealed;
+  /// The digest computed so far if the object is hashed while it is being
+  /// written, otherwise null.
+  std::unique_ptr<IncrementalObjectHash> hash;
 };
 
-PlasmaClient::PlasmaClient() {}
+PlasmaClient::PlasmaClient() : store_conn_(-1), manager_conn_(-1) {
+  config_.num_threads = kDefaultNumThreads;
+  config_.parallel_threshold = kDefaultParallelThreshold;
+  config_.quota = 0;
+}
 
 PlasmaClient::~PlasmaClient() {}
 
@@ -297,32 +449,42 @@ Status PlasmaClient::PerformRelease(const ObjectID& object_id) {
   ARROW_CHECK(object_entry->second->count >= 0);
   // Check if the client is no longer using this object.
   if (object_entry->second->count == 0) {
-    // Decrement the count of the number of objects in this memory-mapped file
-    // that the client is using. The corresponding increment should have
-    // happened in plasma_get.
-    int fd = object_entry->second->object.handle.store_fd;
-    auto entry = mmap_table_.find(fd);
-    ARROW_CHECK(entry != mmap_table_.end());
-    entry->second.count -= 1;
-    ARROW_CHECK(entry->second.count >= 0);
-    // If none are being used then unmap the file.
-    if (entry->second.count == 0) {
-      munmap(entry->second.pointer, entry->second.length);
-      // Remove the corresponding entry from the hash table.
-      mmap_table_.erase(fd);
-    }
+    remove_object_in_use(object_id);
     // Tell the store that the client no longer needs the object.
     RETURN_NOT_OK(SendReleaseRequest(store_conn_, object_id));
-    // Update the in_use_object_bytes_.
-    in_use_object_bytes_ -= (object_entry->second->object.data_size +
-                             object_entry->second->object.metadata_size);
-    DCHECK_GE(in_use_object_bytes_, 0);
-    // Remove the entry from the hash table of objects currently in use.
-    objects_in_use_.erase(object_id);
   }
   return Status::OK();
 }
 
+/// Forget an object that the client no longer uses, and unmap its file if no
+/// other object in it is in use.
+///
+/// @param object_id The ID of the object.
+void PlasmaClient::remove_object_in_use(const ObjectID& object_id) {
+  auto object_entry = objects_in_use_.find(object_id);
+  ARROW_CHECK(object_entry != objects_in_use_.end());
+  // Decrement the count of the number of objects in this memory-mapped file
+  // that the client is using. The corresponding increment should have
+  // happened in plasma_get.
+  int fd = object_entry->second->object.handle.store_fd;
+  auto entry = mmap_table_.find(fd);
+  ARROW_CHECK(entry != mmap_table_.end());
+  entry->second.count -= 1;
+  ARROW_CHECK(entry->second.count >= 0);
+  // If none are being used then unmap the file.
+  if (entry->second.count == 0) {
+    munmap(entry->second.pointer, entry->second.length);
+    // Remove the corresponding entry from the hash table.
+    mmap_table_.erase(fd);
+  }
+  // Update the in_use_object_bytes_.
+  in_use_object_bytes_ -= (object_entry->second->object.data_size +
+                           object_entry->second->object.metadata_size);
+  DCHECK_GE(in_use_object_bytes_, 0);
+  // Remove the entry from the hash table of objects currently in use.
+  objects_in_use_.erase(object_entry);
+}
+
 Status PlasmaClient::Release(const ObjectID& object_id) {
   // If the client is already disconnected, ignore release requests.
   if (store_conn_ < 0) {
@@ -370,49 +532,32 @@ static void ComputeBlockHash(const unsigned char* data, int64_t nbytes, uint64_t
   *hash = XXH64_digest(&hash_state);
 }
 
-static inline bool compute_object_hash_parallel(XXH64_state_t* hash_state,
-                                                const unsigned char* data,
-                                                int64_t nbytes) {
-  // Note that this function will likely be faster if the address of data is
-  // aligned on a 64-byte boundary.
-  const int num_threads = kThreadPoolSize;
-  uint64_t threadhash[num_threads + 1];
-  const uint64_t data_address = reinterpret_cast<uint64_t>(data);
-  const uint64_t num_blocks = nbytes / BLOCK_SIZE;
-  const uint64_t chunk_size = (num_blocks / num_threads) * BLOCK_SIZE;
-  const uint64_t right_address = data_address + chunk_size * num_threads;
-  const uint64_t suffix = (data_address + nbytes) - right_address;
-  // Now the data layout is | k * num_threads * block_size | suffix | ==
-  // | num_threads * chunk_size | suffix |, where chunk_size = k * block_size.
-  // Each thread gets a "chunk" of k blocks, except the suffix thread.
-
-  for (int i = 0; i < num_threads; i++) {
-    threadpool_[i] = std::thread(
-        ComputeBlockHash, reinterpret_cast<uint8_t*>(data_address) + i * chunk_size,
-        chunk_size, &threadhash[i]);
-  }
-  ComputeBlockHash(reinterpret_cast<uint8_t*>(right_address), suffix,
-                   &threadhash[num_threads]);
-
-  // Join the threads.
-  for (auto& t : threadpool_) {
-    if (t.joinable()) {
-      t.join();
-    }
-  }
-
-  XXH64_update(hash_state, reinterpret_cast<unsigned char*>(threadhash),
-               sizeof(threadhash));
-  return true;
-}
-
-static uint64_t compute_object_hash(const ObjectBuffer& obj_buffer) {
+uint64_t PlasmaClient::compute_object_hash(const ObjectBuffer& obj_buffer) {
   XXH64_state_t hash_state;
   XXH64_reset(&hash_state, XXH64_DEFAULT_SEED);
-  if (obj_buffer.data_size >= kBytesInMB) {
-    compute_object_hash_parallel(&hash_state,
-                                 reinterpret_cast<unsigned char*>(obj_buffer.data),
-                                 obj_buffer.data_size);
+  const int64_t nbytes = obj_buffer.data_size;
+  if (nbytes >= kBytesInMB) {
+    // Note that this will likely be faster if the address of data is aligned
+    // on a 64-byte boundary.
+    const uint8_t* data = obj_buffer.data;
+    const int64_t chunk_size = (nbytes / BLOCK_SIZE / kHashNumChunks) * BLOCK_SIZE;
+    // Now the data layout is | kHashNumChunks * chunk_size | suffix |, where
+    // chunk_size is a multiple of the block size. Each chunk and the suffix are
+    // hashed separately, and the digest is the hash of the chunk hashes.
+    uint64_t chunk_hashes[kHashNumChunks + 1];
+    auto hash_chunk = [data, nbytes, chunk_size, &chunk_hashes](int i) {
+      int64_t length = i < kHashNumChunks ? chunk_size : nbytes - i * chunk_size;
+      ComputeBlockHash(data + i * chunk_size, length, &chunk_hashes[i]);
+    };
+    if (thread_pool_ && nbytes >= config_.parallel_threshold) {
+      thread_pool_->ParallelFor(kHashNumChunks + 1, hash_chunk);
+    } else {
+      for (int i = 0; i <= kHashNumChunks; ++i) {
+        hash_chunk(i);
+      }
+    }
+    XXH64_update(&hash_state, reinterpret_cast<unsigned char*>(chunk_hashes),
+                 sizeof(chunk_hashes));
   } else {
     XXH64_update(&hash_state, reinterpret_cast<unsigned char*>(obj_buffer.data),
                  obj_buffer.data_size);
@@ -433,7 +578,18 @@ Status PlasmaClient::Seal(const ObjectID& object_id) {
   object_entry->second->is_sealed = true;
   /// Send the seal request to Plasma.
   static unsigned char digest[kDigestSize];
-  RETURN_NOT_OK(Hash(object_id, &digest[0]));
+  IncrementalObjectHash* hash = object_entry->second->hash.get();
+  if (hash != nullptr && hash->bytes_hashed == hash->data_size) {
+    // The data was hashed while it was written, only the metadata is left.
+    const PlasmaObject& object = object_entry->second->object;
+    uint8_t* metadata = lookup_mmapped_file(object.handle.store_fd) +
+                        object.data_offset + object.data_size;
+    uint64_t digest_value = hash->Finish(metadata, object.metadata_size);
+    memcpy(&digest[0], &digest_value, sizeof(digest_value));
+  } else {
+    RETURN_NOT_OK(Hash(object_id, &digest[0]));
+  }
+  object_entry->second->hash.reset();
   RETURN_NOT_OK(SendSealRequest(store_conn_, object_id, &digest[0]));
   // We call PlasmaClient::Release to decrement the number of instances of this
   // object
@@ -443,6 +599,85 @@ Status PlasmaClient::Seal(const ObjectID& object_id) {
   return Release(object_id);
 }
 
+Status PlasmaClient::Abort(const ObjectID& object_id) {
+  auto object_entry = objects_in_use_.find(object_id);
+  ARROW_CHECK(object_entry != objects_in_use_.end())
+      << "Plasma client called abort on an object without a reference to it";
+  ARROW_CHECK(!object_entry->second->is_sealed)
+      << "Plasma client called abort on a sealed object";
+  RETURN_NOT_OK(SendAbortRequest(store_conn_, object_id));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaAbortReply, &buffer));
+  ObjectID id;
+  RETURN_NOT_OK(ReadAbortReply(buffer.data(), buffer.size(), &id));
+  // Drop both references taken by Create at once. An unsealed object cannot be
+  // gotten, so there are no others, and the store already freed the object.
+  remove_object_in_use(object_id);
+  return Status::OK();
+}
+
+Status PlasmaClient::UpdateDigest(const ObjectID& object_id, int64_t num_bytes) {
+  auto object_entry = objects_in_use_.find(object_id);
+  if (object_entry == objects_in_use_.end() || object_entry->second->is_sealed) {
+    return Status::Invalid("UpdateDigest requires an object created by this client");
+  }
+  const PlasmaObject& object = object_entry->second->object;
+  std::unique_ptr<IncrementalObjectHash>& hash = object_entry->second->hash;
+  if (!hash) {
+    hash.reset(new IncrementalObjectHash(object.data_size));
+  }
+  if (num_bytes < 0 || hash->bytes_hashed + num_bytes > object.data_size) {
+    return Status::Invalid("UpdateDigest called past the end of the object");
+  }
+  const uint8_t* data =
+      lookup_mmapped_file(object.handle.store_fd) + object.data_offset;
+  hash->Update(data + hash->bytes_hashed, num_bytes);
+  return Status::OK();
+}
+
+void PlasmaClient::Memcopy(uint8_t* dst, const uint8_t* src, int64_t num_bytes) {
+  if (!thread_pool_ || config_.num_threads <= 1 ||
+      num_bytes < config_.parallel_threshold) {
+    memcpy(dst, src, num_bytes);
+    return;
+  }
+  // Give each thread a contiguous range that starts on a block boundary.
+  const int num_tasks = config_.num_threads;
+  int64_t chunk_size = (num_bytes + num_tasks - 1) / num_tasks;
+  chunk_size = (chunk_size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+  thread_pool_->ParallelFor(num_tasks, [dst, src, num_bytes, chunk_size](int i) {
+    int64_t offset = std::min(num_bytes, i * chunk_size);
+    int64_t length = std::min(num_bytes - offset, chunk_size);
+    memcpy(dst + offset, src + offset, length);
+  });
+}
+
+Status PlasmaClient::SetNumThreads(int num_threads) {
+  if (thread_pool_) {
+    return Status::Invalid("The number of threads must be set before Connect");
+  }
+  if (num_threads < 1) {
+    return Status::Invalid("The number of threads must be at least 1");
+  }
+  config_.num_threads = num_threads;
+  return Status::OK();
+}
+
+void PlasmaClient::SetParallelThreshold(int64_t threshold) {
+  config_.parallel_threshold = threshold;
+}
+
+Status PlasmaClient::SetQuota(int64_t quota) {
+  if (store_conn_ != -1) {
+    return Status::Invalid("The quota must be set before Connect");
+  }
+  if (quota < 0) {
+    return Status::Invalid("The quota must not be negative");
+  }
+  config_.quota = quota;
+  return Status::OK();
+}
+
 Status PlasmaClient::Delete(const ObjectID& object_id) {
   // TODO(rkn): In the future, we can use this method to give hints to the
   // eviction policy about when an object will no longer be needed.
@@ -459,6 +694,13 @@ Status PlasmaClient::Evict(int64_t num_bytes, int64_t& num_bytes_evicted) {
   return ReadEvictReply(buffer.data(), buffer.size(), num_bytes_evicted);
 }
 
+Status PlasmaClient::Metrics(StoreMetrics* metrics) {
+  RETURN_NOT_OK(SendMetricsRequest(store_conn_));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaMetricsReply, &buffer));
+  return ReadMetricsReply(buffer.data(), buffer.size(), metrics);
+}
+
 Status PlasmaClient::Hash(const ObjectID& object_id, uint8_t* digest) {
   // Get the plasma object data. We pass in a timeout of 0 to indicate that
   // the operation should timeout immediately.
@@ -495,23 +737,64 @@ Status PlasmaClient::Subscribe(int* fd) {
   return Status::OK();
 }
 
-Status PlasmaClient::GetNotification(int fd, ObjectID* object_id, int64_t* data_size,
-                                     int64_t* metadata_size) {
+// Read one batch of notifications from the store and append it to queue.
+Status PlasmaClient::ReadNotificationBatch(int fd,
+                                           std::deque<ObjectNotification>* queue) {
   uint8_t* notification = read_message_async(fd);
   if (notification == NULL) {
     return Status::IOError("Failed to read object notification from Plasma socket");
   }
-  auto object_info = flatbuffers::GetRoot<ObjectInfo>(notification);
-  ARROW_CHECK(object_info->object_id()->size() == sizeof(ObjectID));
-  memcpy(object_id, object_info->object_id()->data(), sizeof(ObjectID));
-  if (object_info->is_deletion()) {
-    *data_size = -1;
-    *metadata_size = -1;
-  } else {
-    *data_size = object_info->data_size();
-    *metadata_size = object_info->metadata_size();
+  auto batch = flatbuffers::GetRoot<ObjectInfoBatch>(notification);
+  for (const auto object_info : *batch->object_info()) {
+    ARROW_CHECK(object_info->object_id()->size() == sizeof(ObjectID));
+    ObjectNotification result;
+    memcpy(&result.object_id, object_info->object_id()->data(), sizeof(ObjectID));
+    if (object_info->is_deletion()) {
+      result.data_size = -1;
+      result.metadata_size = -1;
+    } else {
+      result.data_size = object_info->data_size();
+      result.metadata_size = object_info->metadata_size();
+    }
+    queue->push_back(result);
   }
-  delete[] notification;
+  // The corresponding malloc happened in read_message_async.
+  free(notification);
+  return Status::OK();
+}
+
+Status PlasmaClient::GetNotification(int fd, ObjectID* object_id, int64_t* data_size,
+                                     int64_t* metadata_size) {
+  std::deque<ObjectNotification>& queue = notification_queues_[fd];
+  // A batch may be empty if all of its notifications cancelled each other.
+  while (queue.empty()) {
+    RETURN_NOT_OK(ReadNotificationBatch(fd, &queue));
+  }
+  *object_id = queue.front().object_id;
+  *data_size = queue.front().data_size;
+  *metadata_size = queue.front().metadata_size;
+  queue.pop_front();
+  return Status::OK();
+}
+
+Status PlasmaClient::GetNotifications(int fd,
+                                      std::vector<ObjectNotification>* notifications) {
+  std::deque<ObjectNotification>& queue = notification_queues_[fd];
+  while (queue.empty()) {
+    RETURN_NOT_OK(ReadNotificationBatch(fd, &queue));
+  }
+  // Drain the batches that have already arrived.
+  struct pollfd poll_fd;
+  poll_fd.fd = fd;
+  poll_fd.events = POLLIN;
+  while (poll(&poll_fd, 1, 0) > 0 && (poll_fd.revents & POLLIN)) {
+    // If the socket was closed, the next call will report the error.
+    if (!ReadNotificationBatch(fd, &queue).ok()) {
+      break;
+    }
+  }
+  notifications->insert(notifications->end(), queue.begin(), queue.end());
+  queue.clear();
   return Status::OK();
 }
 
@@ -527,8 +810,12 @@ Status PlasmaClient::Connect(const std::string& store_socket_name,
   }
   config_.release_delay = release_delay;
   in_use_object_bytes_ = 0;
-  // Send a ConnectRequest to the store to get its memory capacity.
-  RETURN_NOT_OK(SendConnectRequest(store_conn_));
+  if (!thread_pool_) {
+    thread_pool_.reset(new ClientThreadPool(config_.num_threads));
+  }
+  // Send a ConnectRequest to the store to set our quota and get its memory
+  // capacity.
+  RETURN_NOT_OK(SendConnectRequest(store_conn_, config_.quota));
   std::vector<uint8_t> buffer;
   RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaConnectReply, &buffer));
   RETURN_NOT_OK(ReadConnectReply(buffer.data(), buffer.size(), &store_capacity_));
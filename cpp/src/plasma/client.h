@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "arrow/status.h"
 #include "arrow/util/visibility.h"
@@ -39,6 +40,12 @@ namespace plasma {
 // Use 100MB as an overestimate of the L3 cache size.
 constexpr int64_t kL3CacheSizeBytes = 100000000;
 
+// Default number of threads used for memcopy and hash computations.
+constexpr int kDefaultNumThreads = 8;
+
+// Default size in bytes above which hashing and memcopy use the thread pool.
+constexpr int64_t kDefaultParallelThreshold = 1 << 20;
+
 /// Object buffer data structure.
 struct ObjectBuffer {
   /// The size in bytes of the data object.
@@ -51,12 +58,31 @@ struct ObjectBuffer {
   uint8_t* metadata;
 };
 
+/// Notification about an object that was sealed or deleted.
+struct ObjectNotification {
+  /// The ID of the object.
+  ObjectID object_id;
+  /// The data size in bytes of the sealed object, -1 if it was deleted.
+  int64_t data_size;
+  /// The metadata size in bytes of the sealed object, -1 if it was deleted.
+  int64_t metadata_size;
+};
+
 /// Configuration options for the plasma client.
 struct PlasmaClientConfig {
   /// Number of release calls we wait until the object is actually released.
   /// This allows us to avoid invalidating the cpu cache on workers if objects
   /// are reused accross tasks.
   size_t release_delay;
+  /// Number of threads (including the calling thread) used to hash and copy
+  /// large objects. The threads are started once in Connect and reused.
+  int num_threads;
+  /// Objects and copies of at least this many bytes are processed in
+  /// parallel; smaller ones are handled on the calling thread.
+  int64_t parallel_threshold;
+  /// The number of bytes of objects that this client asks to be limited to in
+  /// the store, or 0 to use the store's default quota.
+  int64_t quota;
 };
 
 struct ClientMmapTableEntry {
@@ -72,6 +98,7 @@ struct ClientMmapTableEntry {
 struct ObjectInUseEntry;
 struct ObjectRequest;
 struct PlasmaObject;
+class ClientThreadPool;
 
 class ARROW_EXPORT PlasmaClient {
  public:
@@ -95,6 +122,30 @@ class ARROW_EXPORT PlasmaClient {
                  const std::string& manager_socket_name, int release_delay,
                  int num_retries = -1);
 
+  /// Set the number of threads used for hashing and copying large objects.
+  /// This must be called before Connect, which starts the threads.
+  ///
+  /// \param num_threads The number of threads, including the calling thread.
+  /// \return The return status.
+  Status SetNumThreads(int num_threads);
+
+  /// Set the size in bytes above which hashing and copying use the thread
+  /// pool.
+  ///
+  /// \param threshold The size threshold in bytes.
+  void SetParallelThreshold(int64_t threshold);
+
+  /// Ask the store to limit the objects this client created, and that are
+  /// still in the store, to a number of bytes. This must be called before
+  /// Connect. The store may enforce a lower quota. When an object does not
+  /// fit, the store evicts unused objects of this client only, and Create
+  /// returns PlasmaStoreFull if that does not free enough space, so the call
+  /// can be retried after releasing objects.
+  ///
+  /// \param quota The quota in bytes, or 0 to use the store's default.
+  /// \return The return status.
+  Status SetQuota(int64_t quota);
+
   /// Create an object in the Plasma Store. Any metadata for this object must be
   /// be passed in when the object is created.
   ///
@@ -160,6 +211,37 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Seal(const ObjectID& object_id);
 
+  /// Abort an unsealed object in the object store. The object is removed from
+  /// the store without ever becoming visible to other clients, and the
+  /// address returned by Create is no longer valid. This must be called
+  /// instead of Seal, by the client that created the object.
+  ///
+  /// \param object_id The ID of the object to abort.
+  /// \return The return status.
+  Status Abort(const ObjectID& object_id);
+
+  /// Hash part of an object that is being written, so that Seal does not have
+  /// to hash the whole object afterwards. The data must be reported in order:
+  /// each call covers the num_bytes bytes following the ones reported by the
+  /// previous call. If the whole data buffer has been reported by the time
+  /// Seal is called, the digest computed here is used; otherwise Seal hashes
+  /// the object as usual.
+  ///
+  /// \param object_id The ID of an object created but not yet sealed by this
+  ///        client.
+  /// \param num_bytes The number of newly written bytes of the data buffer.
+  /// \return The return status.
+  Status UpdateDigest(const ObjectID& object_id, int64_t num_bytes);
+
+  /// Copy memory into an object buffer, using the client's thread pool if the
+  /// copy is larger than the parallel threshold.
+  ///
+  /// \param dst The destination address, typically inside an object created
+  ///        with Create.
+  /// \param src The source address.
+  /// \param num_bytes The number of bytes to copy.
+  void Memcopy(uint8_t* dst, const uint8_t* src, int64_t num_bytes);
+
   /// Delete an object from the object store. This currently assumes that the
   /// object is present and has been sealed.
   ///
@@ -187,6 +269,14 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Hash(const ObjectID& object_id, uint8_t* digest);
 
+  /// Get the counters and gauges of the store, such as the number of requests
+  /// of each kind, the bytes in use, the free bytes in the arena, and
+  /// percentiles of the time the store takes to process a request.
+  ///
+  /// \param metrics Out parameter for the metrics as (name, value) pairs.
+  /// \return The return status.
+  Status Metrics(StoreMetrics* metrics);
+
   /// Subscribe to notifications when objects are sealed in the object store.
   /// Whenever an object is sealed, a message will be written to the client
   /// socket that is returned by this method.
@@ -207,6 +297,19 @@ class ARROW_EXPORT PlasmaClient {
   Status GetNotification(int fd, ObjectID* object_id, int64_t* data_size,
                          int64_t* metadata_size);
 
+  /// Receive all object notifications that are available for this client if
+  /// Subscribe has been called. This blocks until at least one notification is
+  /// available, and then returns every notification that can be read without
+  /// blocking. The store sends notifications in batches, so this needs far
+  /// fewer calls than GetNotification for subscribers that track every object.
+  ///
+  /// \param fd The file descriptor we are reading the notifications from.
+  /// \param notifications Out parameter, the notifications are appended to
+  ///        this vector in the order in which the objects were sealed or
+  ///        deleted.
+  /// \return The return status.
+  Status GetNotifications(int fd, std::vector<ObjectNotification>* notifications);
+
   /// Disconnect from the local plasma instance, including the local store and
   /// manager.
   ///
@@ -309,6 +412,8 @@ class ARROW_EXPORT PlasmaClient {
  private:
   Status PerformRelease(const ObjectID& object_id);
 
+  void remove_object_in_use(const ObjectID& object_id);
+
   uint8_t* lookup_or_mmap(int fd, int store_fd_val, int64_t map_size);
 
   uint8_t* lookup_mmapped_file(int store_fd_val);
@@ -316,6 +421,10 @@ class ARROW_EXPORT PlasmaClient {
   void increment_object_count(const ObjectID& object_id, PlasmaObject* object,
                               bool is_sealed);
 
+  uint64_t compute_object_hash(const ObjectBuffer& obj_buffer);
+
+  Status ReadNotificationBatch(int fd, std::deque<ObjectNotification>* queue);
+
   /// File descriptor of the Unix domain socket that connects to the store.
   int store_conn_;
   /// File descriptor of the Unix domain socket that connects to the manager.
@@ -344,6 +453,12 @@ class ARROW_EXPORT PlasmaClient {
   /// information to make sure that it does not delay in releasing so much
   /// memory that the store is unable to evict enough objects to free up space.
   int64_t store_capacity_;
+  /// Threads used to hash and copy large objects. These are created in Connect
+  /// and live as long as the client.
+  std::unique_ptr<ClientThreadPool> thread_pool_;
+  /// Notifications that were received in a batch from the store but not yet
+  /// returned by GetNotification, keyed by the notification file descriptor.
+  std::unordered_map<int, std::deque<ObjectNotification>> notification_queues_;
 };
 
 }  // namespace plasma
@@ -20,6 +20,8 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
 // TODO(pcm): Convert getopt and sscanf in the store to use more idiomatic C++
 // and get rid of the next three lines:
 #ifndef __STDC_FORMAT_MACROS
@@ -67,6 +69,9 @@ arrow::Status plasma_error_status(int plasma_error);
 /// Size of object hash digests.
 constexpr int64_t kDigestSize = sizeof(uint64_t);
 
+/// Named counters and gauges that are reported by the Plasma store.
+typedef std::vector<std::pair<std::string, int64_t>> StoreMetrics;
+
 /// Object request data structure. Used for Wait.
 struct ObjectRequest {
   /// The ID of the requested object. If ID_NIL request any object.
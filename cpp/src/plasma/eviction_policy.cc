@@ -48,6 +48,21 @@ int64_t LRUCache::choose_objects_to_evict(int64_t num_bytes_required,
   return bytes_evicted;
 }
 
+int64_t LRUCache::choose_objects_to_evict_if(
+    int64_t num_bytes_required, const std::function<bool(const ObjectID&)>& predicate,
+    std::vector<ObjectID>* objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  auto it = item_list_.end();
+  while (bytes_evicted < num_bytes_required && it != item_list_.begin()) {
+    it--;
+    if (predicate(it->first)) {
+      objects_to_evict->push_back(it->first);
+      bytes_evicted += it->second;
+    }
+  }
+  return bytes_evicted;
+}
+
 EvictionPolicy::EvictionPolicy(PlasmaStoreInfo* store_info)
     : memory_used_(0), store_info_(store_info) {}
 
@@ -64,6 +79,20 @@ int64_t EvictionPolicy::choose_objects_to_evict(int64_t num_bytes_required,
   return bytes_evicted;
 }
 
+int64_t EvictionPolicy::choose_objects_to_evict_if(
+    int64_t num_bytes_required, const std::function<bool(const ObjectID&)>& predicate,
+    std::vector<ObjectID>* objects_to_evict) {
+  std::vector<ObjectID> chosen;
+  int64_t bytes_evicted =
+      cache_.choose_objects_to_evict_if(num_bytes_required, predicate, &chosen);
+  for (auto& object_id : chosen) {
+    cache_.remove(object_id);
+    objects_to_evict->push_back(object_id);
+  }
+  memory_used_ -= bytes_evicted;
+  return bytes_evicted;
+}
+
 void EvictionPolicy::object_created(const ObjectID& object_id) {
   auto entry = store_info_->objects[object_id].get();
   cache_.add(object_id, entry->info.data_size + entry->info.metadata_size);
@@ -18,6 +18,7 @@
 #ifndef PLASMA_EVICTION_POLICY_H
 #define PLASMA_EVICTION_POLICY_H
 
+#include <functional>
 #include <list>
 #include <unordered_map>
 #include <utility>
@@ -45,6 +46,10 @@ class LRUCache {
   int64_t choose_objects_to_evict(int64_t num_bytes_required,
                                   std::vector<ObjectID>* objects_to_evict);
 
+  int64_t choose_objects_to_evict_if(
+      int64_t num_bytes_required, const std::function<bool(const ObjectID&)>& predicate,
+      std::vector<ObjectID>* objects_to_evict);
+
  private:
   /// A doubly-linked list containing the items in the cache and
   /// their sizes in LRU order.
@@ -121,6 +126,20 @@ class EvictionPolicy {
   int64_t choose_objects_to_evict(int64_t num_bytes_required,
                                   std::vector<ObjectID>* objects_to_evict);
 
+  /// Choose some objects to evict among the objects for which predicate
+  /// returns true, in LRU order. This is used to make room within a client's
+  /// quota without evicting objects of other clients. Unlike require_space,
+  /// this frees only as much space as is required.
+  ///
+  /// @param num_bytes_required The number of bytes of space to try to free up.
+  /// @param predicate Returns whether an object may be evicted.
+  /// @param objects_to_evict The object IDs that were chosen for eviction will
+  ///        be stored into this vector.
+  /// @return The total number of bytes of space chosen to be evicted.
+  int64_t choose_objects_to_evict_if(
+      int64_t num_bytes_required, const std::function<bool(const ObjectID&)>& predicate,
+      std::vector<ObjectID>* objects_to_evict);
+
  private:
   /// The amount of memory (in bytes) currently being used.
   int64_t memory_used_;
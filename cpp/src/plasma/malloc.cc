@@ -198,3 +198,10 @@ void get_malloc_mapinfo(void* addr, int* fd, int64_t* map_size, ptrdiff_t* offse
 }
 
 void set_malloc_granularity(int value) { change_mparam(M_GRANULARITY, value); }
+
+void get_malloc_stats(int64_t* footprint, int64_t* allocated, int64_t* num_segments) {
+  struct mallinfo info = dlmallinfo();
+  *footprint = static_cast<int64_t>(dlmalloc_footprint());
+  *allocated = static_cast<int64_t>(info.uordblks);
+  *num_segments = static_cast<int64_t>(mmap_records.size());
+}
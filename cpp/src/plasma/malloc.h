@@ -25,4 +25,12 @@ void get_malloc_mapinfo(void* addr, int* fd, int64_t* map_length, ptrdiff_t* off
 
 void set_malloc_granularity(int value);
 
+/// Get statistics about the memory-mapped arena of the store.
+///
+/// @param footprint The number of bytes obtained from the system.
+/// @param allocated The number of bytes in allocated chunks, including the
+///        per-chunk overhead and padding.
+/// @param num_segments The number of memory-mapped files.
+void get_malloc_stats(int64_t* footprint, int64_t* allocated, int64_t* num_segments);
+
 #endif  // MALLOC_H
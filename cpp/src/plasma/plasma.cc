@@ -21,6 +21,9 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <memory>
+#include <vector>
+
 #include "plasma/common.h"
 #include "plasma/protocol.h"
 
@@ -42,22 +45,30 @@ int warn_if_sigpipe(int status, int client_sock) {
 }
 
 /**
- * This will create a new ObjectInfo buffer. The first sizeof(int64_t) bytes
- * of this buffer are the length of the remaining message and the
- * remaining message is a serialized version of the object info.
+ * This will create a new buffer holding a batch of object notifications. The
+ * first sizeof(int64_t) bytes of this buffer are the length of the remaining
+ * message and the remaining message is a serialized ObjectInfoBatch.
  *
- * @param object_info The object info to be serialized
- * @return The object info buffer. It is the caller's responsibility to free
- *         this buffer with "delete" after it has been used.
+ * @param object_info The object infos to be serialized, null entries are
+ *        skipped.
+ * @param buffer The vector that the buffer is written to.
  */
-uint8_t* create_object_info_buffer(ObjectInfoT* object_info) {
+void create_object_info_buffer(
+    const std::vector<std::unique_ptr<ObjectInfoT>>& object_info,
+    std::vector<uint8_t>* buffer) {
   flatbuffers::FlatBufferBuilder fbb;
-  auto message = CreateObjectInfo(fbb, object_info);
+  std::vector<flatbuffers::Offset<ObjectInfo>> infos;
+  for (const auto& info : object_info) {
+    if (info != nullptr) {
+      infos.push_back(CreateObjectInfo(fbb, info.get()));
+    }
+  }
+  auto message = CreateObjectInfoBatch(fbb, fbb.CreateVector(infos));
   fbb.Finish(message);
-  uint8_t* notification = new uint8_t[sizeof(int64_t) + fbb.GetSize()];
-  *(reinterpret_cast<int64_t*>(notification)) = fbb.GetSize();
-  memcpy(notification + sizeof(int64_t), fbb.GetBufferPointer(), fbb.GetSize());
-  return notification;
+  int64_t size = fbb.GetSize();
+  buffer->resize(sizeof(int64_t) + size);
+  memcpy(buffer->data(), &size, sizeof(int64_t));
+  memcpy(buffer->data() + sizeof(int64_t), fbb.GetBufferPointer(), size);
 }
 
 ObjectTableEntry* get_object_table_entry(PlasmaStoreInfo* store_info,
@@ -27,9 +27,11 @@
 #include <string.h>
 #include <unistd.h>  // pid_t
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "plasma/compat.h"
 
@@ -119,6 +121,9 @@ struct ObjectTableEntry {
   uint8_t* pointer;
   /// Set of clients currently using this object.
   std::unordered_set<Client*> clients;
+  /// The client that created this object and whose quota it counts against,
+  /// or nullptr once that client has disconnected.
+  Client* owner;
   /// The state of the object, e.g., whether it is open or sealed.
   object_state state;
   /// The digest of the object. Used to see if two objects are the same.
@@ -167,7 +172,9 @@ ObjectTableEntry* get_object_table_entry(PlasmaStoreInfo* store_info,
 /// @return The errno set.
 int warn_if_sigpipe(int status, int client_sock);
 
-uint8_t* create_object_info_buffer(ObjectInfoT* object_info);
+void create_object_info_buffer(
+    const std::vector<std::unique_ptr<ObjectInfoT>>& object_info,
+    std::vector<uint8_t>* buffer);
 
 }  // namespace plasma
 
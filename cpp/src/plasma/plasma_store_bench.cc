@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// PLASMA STORE BENCHMARK: Drives a running Plasma store from many client
+// processes and reports the throughput and latency of the requests.
+//
+// Every process connects to the store (-s) and then repeatedly creates an
+// object of the given size (-d data bytes, -m metadata bytes), writes it,
+// seals it, gets it a number of times (-g) and releases it. The processes
+// (-p) start at the same time and each one does this for a number of objects
+// (-n). Afterwards, the percentiles of the time each kind of request took and
+// the metrics of the store are printed.
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "plasma/client.h"
+#include "plasma/common.h"
+#include "plasma/io.h"
+
+namespace plasma {
+
+namespace {
+
+enum Operation { kCreate = 0, kSeal, kGet, kRelease, kNumOperations };
+
+const char* kOperationNames[kNumOperations] = {"create", "seal", "get", "release"};
+
+struct BenchmarkOptions {
+  std::string socket_name;
+  int num_processes;
+  int64_t num_objects;
+  int64_t data_size;
+  int64_t metadata_size;
+  int num_gets;
+};
+
+/// The latencies measured by one process, in nanoseconds, and when the
+/// process started and finished its requests.
+struct ProcessResult {
+  int64_t start_ns;
+  int64_t end_ns;
+  std::vector<int64_t> latencies[kNumOperations];
+};
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+Status RunWorkload(const BenchmarkOptions& options, ProcessResult* result) {
+  PlasmaClient client;
+  RETURN_NOT_OK(client.Connect(options.socket_name, "", 0));
+  std::vector<uint8_t> metadata(options.metadata_size, 1);
+  for (auto& latencies : result->latencies) {
+    latencies.reserve(options.num_objects);
+  }
+  result->latencies[kGet].reserve(options.num_objects * options.num_gets);
+  result->latencies[kRelease].reserve(options.num_objects * (options.num_gets + 1));
+
+  result->start_ns = NowNanos();
+  for (int64_t i = 0; i < options.num_objects; ++i) {
+    ObjectID object_id = ObjectID::from_random();
+    uint8_t* data;
+    int64_t start = NowNanos();
+    RETURN_NOT_OK(client.Create(object_id, options.data_size, metadata.data(),
+                                options.metadata_size, &data));
+    result->latencies[kCreate].push_back(NowNanos() - start);
+    memset(data, static_cast<int>(i), options.data_size);
+
+    start = NowNanos();
+    RETURN_NOT_OK(client.Seal(object_id));
+    result->latencies[kSeal].push_back(NowNanos() - start);
+
+    for (int j = 0; j < options.num_gets; ++j) {
+      ObjectBuffer object_buffer;
+      start = NowNanos();
+      RETURN_NOT_OK(client.Get(&object_id, 1, -1, &object_buffer));
+      result->latencies[kGet].push_back(NowNanos() - start);
+    }
+
+    // Release the reference from Create and the ones from Get.
+    for (int j = 0; j <= options.num_gets; ++j) {
+      start = NowNanos();
+      RETURN_NOT_OK(client.Release(object_id));
+      result->latencies[kRelease].push_back(NowNanos() - start);
+    }
+  }
+  result->end_ns = NowNanos();
+  return client.Disconnect();
+}
+
+// The result is sent to the parent as the start and end times followed by the
+// number of latencies and the latencies of each operation.
+Status WriteResult(int fd, ProcessResult* result) {
+  RETURN_NOT_OK(WriteBytes(fd, reinterpret_cast<uint8_t*>(&result->start_ns),
+                           sizeof(result->start_ns)));
+  RETURN_NOT_OK(WriteBytes(fd, reinterpret_cast<uint8_t*>(&result->end_ns),
+                           sizeof(result->end_ns)));
+  for (auto& latencies : result->latencies) {
+    int64_t length = latencies.size();
+    RETURN_NOT_OK(WriteBytes(fd, reinterpret_cast<uint8_t*>(&length), sizeof(length)));
+    RETURN_NOT_OK(WriteBytes(fd, reinterpret_cast<uint8_t*>(latencies.data()),
+                             length * sizeof(int64_t)));
+  }
+  return Status::OK();
+}
+
+Status ReadResult(int fd, ProcessResult* result) {
+  RETURN_NOT_OK(ReadBytes(fd, reinterpret_cast<uint8_t*>(&result->start_ns),
+                          sizeof(result->start_ns)));
+  RETURN_NOT_OK(
+      ReadBytes(fd, reinterpret_cast<uint8_t*>(&result->end_ns), sizeof(result->end_ns)));
+  for (auto& latencies : result->latencies) {
+    int64_t length;
+    RETURN_NOT_OK(ReadBytes(fd, reinterpret_cast<uint8_t*>(&length), sizeof(length)));
+    latencies.resize(length);
+    RETURN_NOT_OK(ReadBytes(fd, reinterpret_cast<uint8_t*>(latencies.data()),
+                            length * sizeof(int64_t)));
+  }
+  return Status::OK();
+}
+
+// Runs in the forked child. The child waits until the parent closes the start
+// pipe so that all processes send their requests at the same time.
+void RunProcess(const BenchmarkOptions& options, int start_fd, int result_fd) {
+  char byte;
+  ARROW_CHECK(read(start_fd, &byte, 1) == 0);
+  close(start_fd);
+  ProcessResult result;
+  Status s = RunWorkload(options, &result);
+  if (!s.ok()) {
+    ARROW_LOG(FATAL) << "Benchmark process failed: " << s.ToString();
+  }
+  ARROW_CHECK_OK(WriteResult(result_fd, &result));
+  close(result_fd);
+  exit(0);
+}
+
+double Percentile(const std::vector<int64_t>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1));
+  return static_cast<double>(sorted[index]);
+}
+
+void PrintReport(const BenchmarkOptions& options, std::vector<ProcessResult>* results) {
+  int64_t start_ns = results->front().start_ns;
+  int64_t end_ns = results->front().end_ns;
+  for (const auto& result : *results) {
+    start_ns = std::min(start_ns, result.start_ns);
+    end_ns = std::max(end_ns, result.end_ns);
+  }
+  double seconds = static_cast<double>(end_ns - start_ns) / 1e9;
+  int64_t num_objects = options.num_objects * options.num_processes;
+  printf("%d processes, %" PRId64 " objects of %" PRId64 " + %" PRId64
+         " bytes, %d gets per object\n",
+         options.num_processes, num_objects, options.data_size, options.metadata_size,
+         options.num_gets);
+  printf("elapsed: %.3f s, %.1f objects/s, %.1f MB/s\n", seconds,
+         static_cast<double>(num_objects) / seconds,
+         static_cast<double>(num_objects * (options.data_size + options.metadata_size)) /
+             seconds / 1e6);
+  printf("%-8s %12s %12s %10s %10s %10s %10s %10s\n", "request", "count", "ops/s",
+         "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+  for (int op = 0; op < kNumOperations; ++op) {
+    std::vector<int64_t> latencies;
+    for (auto& result : *results) {
+      latencies.insert(latencies.end(), result.latencies[op].begin(),
+                       result.latencies[op].end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-8s %12zu %12.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", kOperationNames[op],
+           latencies.size(), static_cast<double>(latencies.size()) / seconds,
+           Percentile(latencies, 50) / 1e3, Percentile(latencies, 90) / 1e3,
+           Percentile(latencies, 99) / 1e3, Percentile(latencies, 99.9) / 1e3,
+           Percentile(latencies, 100) / 1e3);
+  }
+}
+
+void PrintStoreMetrics(const BenchmarkOptions& options) {
+  PlasmaClient client;
+  ARROW_CHECK_OK(client.Connect(options.socket_name, "", 0));
+  StoreMetrics metrics;
+  ARROW_CHECK_OK(client.Metrics(&metrics));
+  ARROW_CHECK_OK(client.Disconnect());
+  printf("store metrics:\n");
+  for (const auto& metric : metrics) {
+    printf("  %-24s %" PRId64 "\n", metric.first.c_str(), metric.second);
+  }
+}
+
+}  // namespace
+
+void RunBenchmark(const BenchmarkOptions& options) {
+  int start_pipe[2];
+  ARROW_CHECK(pipe(start_pipe) == 0);
+  std::vector<int> result_fds;
+  std::vector<pid_t> pids;
+  for (int i = 0; i < options.num_processes; ++i) {
+    int result_pipe[2];
+    ARROW_CHECK(pipe(result_pipe) == 0);
+    pid_t pid = fork();
+    ARROW_CHECK(pid >= 0);
+    if (pid == 0) {
+      close(start_pipe[1]);
+      close(result_pipe[0]);
+      for (int fd : result_fds) {
+        close(fd);
+      }
+      RunProcess(options, start_pipe[0], result_pipe[1]);
+    }
+    close(result_pipe[1]);
+    result_fds.push_back(result_pipe[0]);
+    pids.push_back(pid);
+  }
+  // Start all processes.
+  close(start_pipe[0]);
+  close(start_pipe[1]);
+
+  std::vector<ProcessResult> results(options.num_processes);
+  for (int i = 0; i < options.num_processes; ++i) {
+    ARROW_CHECK_OK(ReadResult(result_fds[i], &results[i]));
+    close(result_fds[i]);
+  }
+  for (pid_t pid : pids) {
+    int status;
+    ARROW_CHECK(waitpid(pid, &status, 0) == pid);
+    ARROW_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  PrintReport(options, &results);
+  PrintStoreMetrics(options);
+}
+
+}  // namespace plasma
+
+int main(int argc, char* argv[]) {
+  plasma::BenchmarkOptions options;
+  options.num_processes = 4;
+  options.num_objects = 10000;
+  options.data_size = 1024;
+  options.metadata_size = 0;
+  options.num_gets = 1;
+  int c;
+  while ((c = getopt(argc, argv, "s:p:n:d:m:g:")) != -1) {
+    switch (c) {
+      case 's':
+        options.socket_name = optarg;
+        break;
+      case 'p':
+        options.num_processes = atoi(optarg);
+        break;
+      case 'n':
+        options.num_objects = atoll(optarg);
+        break;
+      case 'd':
+        options.data_size = atoll(optarg);
+        break;
+      case 'm':
+        options.metadata_size = atoll(optarg);
+        break;
+      case 'g':
+        options.num_gets = atoi(optarg);
+        break;
+      default:
+        exit(-1);
+    }
+  }
+  if (options.socket_name.empty()) {
+    ARROW_LOG(FATAL) << "please specify the socket of the store with -s switch";
+  }
+  if (options.num_processes < 1 || options.num_objects < 1 || options.data_size < 0 ||
+      options.metadata_size < 0 || options.num_gets < 0) {
+    ARROW_LOG(FATAL) << "the number of processes and objects must be positive, and the "
+                        "sizes and number of gets must not be negative";
+  }
+  plasma::RunBenchmark(options);
+  return 0;
+}
@@ -198,6 +198,37 @@ Status ReadDeleteReply(uint8_t* data, size_t size, ObjectID* object_id) {
   return plasma_error_status(message->error());
 }
 
+// Abort messages.
+
+Status SendAbortRequest(int sock, ObjectID object_id) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaAbortRequest(fbb, fbb.CreateString(object_id.binary()));
+  return PlasmaSend(sock, MessageType_PlasmaAbortRequest, &fbb, message);
+}
+
+Status ReadAbortRequest(uint8_t* data, size_t size, ObjectID* object_id) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaAbortRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *object_id = ObjectID::from_binary(message->object_id()->str());
+  return Status::OK();
+}
+
+Status SendAbortReply(int sock, ObjectID object_id, int error) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaAbortReply(fbb, fbb.CreateString(object_id.binary()),
+                                        static_cast<PlasmaError>(error));
+  return PlasmaSend(sock, MessageType_PlasmaAbortReply, &fbb, message);
+}
+
+Status ReadAbortReply(uint8_t* data, size_t size, ObjectID* object_id) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaAbortReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *object_id = ObjectID::from_binary(message->object_id()->str());
+  return plasma_error_status(message->error());
+}
+
 // Satus messages.
 
 Status SendStatusRequest(int sock, const ObjectID* object_ids, int64_t num_objects) {
@@ -283,13 +314,19 @@ Status ReadContainsReply(uint8_t* data, size_t size, ObjectID* object_id,
 
 // Connect messages.
 
-Status SendConnectRequest(int sock) {
+Status SendConnectRequest(int sock, int64_t quota) {
   flatbuffers::FlatBufferBuilder fbb;
-  auto message = CreatePlasmaConnectRequest(fbb);
+  auto message = CreatePlasmaConnectRequest(fbb, quota);
   return PlasmaSend(sock, MessageType_PlasmaConnectRequest, &fbb, message);
 }
 
-Status ReadConnectRequest(uint8_t* data) { return Status::OK(); }
+Status ReadConnectRequest(uint8_t* data, size_t size, int64_t* quota) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaConnectRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *quota = message->quota();
+  return Status::OK();
+}
 
 Status SendConnectReply(int sock, int64_t memory_capacity) {
   flatbuffers::FlatBufferBuilder fbb;
@@ -305,6 +342,44 @@ Status ReadConnectReply(uint8_t* data, size_t size, int64_t* memory_capacity) {
   return Status::OK();
 }
 
+// Metrics messages.
+
+Status SendMetricsRequest(int sock) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaMetricsRequest(fbb);
+  return PlasmaSend(sock, MessageType_PlasmaMetricsRequest, &fbb, message);
+}
+
+Status ReadMetricsRequest(uint8_t* data, size_t size) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaMetricsRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  return Status::OK();
+}
+
+Status SendMetricsReply(int sock, const StoreMetrics& metrics) {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<PlasmaMetric>> metric_vector;
+  for (const auto& metric : metrics) {
+    metric_vector.push_back(
+        CreatePlasmaMetric(fbb, fbb.CreateString(metric.first), metric.second));
+  }
+  auto message = CreatePlasmaMetricsReply(fbb, fbb.CreateVector(metric_vector));
+  return PlasmaSend(sock, MessageType_PlasmaMetricsReply, &fbb, message);
+}
+
+Status ReadMetricsReply(uint8_t* data, size_t size, StoreMetrics* metrics) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaMetricsReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  metrics->clear();
+  for (uoffset_t i = 0; i < message->metrics()->size(); ++i) {
+    auto metric = message->metrics()->Get(i);
+    metrics->emplace_back(metric->name()->str(), metric->value());
+  }
+  return Status::OK();
+}
+
 // Evict messages.
 
 Status SendEvictRequest(int sock, int64_t num_bytes) {
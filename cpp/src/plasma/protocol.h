@@ -98,6 +98,16 @@ Status SendDeleteReply(int sock, ObjectID object_id, int error);
 
 Status ReadDeleteReply(uint8_t* data, size_t size, ObjectID* object_id);
 
+/* Plasma Abort message functions. */
+
+Status SendAbortRequest(int sock, ObjectID object_id);
+
+Status ReadAbortRequest(uint8_t* data, size_t size, ObjectID* object_id);
+
+Status SendAbortReply(int sock, ObjectID object_id, int error);
+
+Status ReadAbortReply(uint8_t* data, size_t size, ObjectID* object_id);
+
 /* Satus messages. */
 
 Status SendStatusRequest(int sock, const ObjectID* object_ids, int64_t num_objects);
@@ -126,14 +136,24 @@ Status ReadContainsReply(uint8_t* data, size_t size, ObjectID* object_id,
 
 /* Plasma Connect message functions. */
 
-Status SendConnectRequest(int sock);
+Status SendConnectRequest(int sock, int64_t quota);
 
-Status ReadConnectRequest(uint8_t* data, size_t size);
+Status ReadConnectRequest(uint8_t* data, size_t size, int64_t* quota);
 
 Status SendConnectReply(int sock, int64_t memory_capacity);
 
 Status ReadConnectReply(uint8_t* data, size_t size, int64_t* memory_capacity);
 
+/* Plasma Metrics message functions. */
+
+Status SendMetricsRequest(int sock);
+
+Status ReadMetricsRequest(uint8_t* data, size_t size);
+
+Status SendMetricsReply(int sock, const StoreMetrics& metrics);
+
+Status ReadMetricsReply(uint8_t* data, size_t size, StoreMetrics* metrics);
+
 /* Plasma Evict message functions (no reply so far). */
 
 Status SendEvictRequest(int sock, int64_t num_bytes);
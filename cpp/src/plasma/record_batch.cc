@@ -0,0 +1,201 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/record_batch.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/table.h"
+#include "arrow/util/logging.h"
+
+namespace plasma {
+
+namespace {
+
+/// Output stream over the data of an unsealed object that copies through the
+/// client's thread pool.
+class ObjectOutputStream : public arrow::io::OutputStream {
+ public:
+  ObjectOutputStream(PlasmaClient* client, uint8_t* data, int64_t size)
+      : client_(client), data_(data), size_(size), position_(0) {}
+
+  Status Close() override { return Status::OK(); }
+
+  Status Tell(int64_t* position) const override {
+    *position = position_;
+    return Status::OK();
+  }
+
+  Status Write(const uint8_t* data, int64_t nbytes) override {
+    if (position_ + nbytes > size_) {
+      return Status::IOError("Write past the end of the Plasma object");
+    }
+    client_->Memcopy(data_ + position_, data, nbytes);
+    position_ += nbytes;
+    return Status::OK();
+  }
+
+ private:
+  PlasmaClient* client_;
+  uint8_t* data_;
+  int64_t size_;
+  int64_t position_;
+};
+
+/// The data of a sealed object. The object is released when the buffer, and
+/// with it every slice taken from it, is destroyed.
+class ObjectBufferHolder : public arrow::Buffer {
+ public:
+  ObjectBufferHolder(PlasmaClient* client, const ObjectID& object_id,
+                     const ObjectBuffer& object_buffer)
+      : Buffer(object_buffer.data, object_buffer.data_size),
+        client_(client),
+        object_id_(object_id) {}
+
+  ~ObjectBufferHolder() {
+    Status s = client_->Release(object_id_);
+    if (!s.ok()) {
+      ARROW_LOG(ERROR) << "Failed to release Plasma object " << object_id_.hex() << ": "
+                       << s.ToString();
+    }
+  }
+
+ private:
+  PlasmaClient* client_;
+  ObjectID object_id_;
+};
+
+Status WriteStream(
+    arrow::io::OutputStream* sink, const std::shared_ptr<arrow::Schema>& schema,
+    const std::function<Status(arrow::ipc::RecordBatchWriter*)>& write_batches) {
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  RETURN_NOT_OK(arrow::ipc::RecordBatchStreamWriter::Open(sink, schema, &writer));
+  RETURN_NOT_OK(write_batches(writer.get()));
+  return writer->Close();
+}
+
+// Serialize the record batches produced by write_batches as an IPC stream into
+// a new object.
+Status PutStream(
+    PlasmaClient* client, const ObjectID& object_id,
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::function<Status(arrow::ipc::RecordBatchWriter*)>& write_batches) {
+  // The object must be created with its final size, so the stream is written
+  // twice. The first pass into a MockOutputStream only builds the metadata and
+  // counts bytes; no buffer data is copied, except bitmaps of sliced arrays.
+  // Unlike GetRecordBatchSize, this also covers the schema, the dictionaries
+  // and each batch of a table.
+  arrow::io::MockOutputStream mock;
+  RETURN_NOT_OK(WriteStream(&mock, schema, write_batches));
+  const int64_t size = mock.GetExtentBytesWritten();
+
+  uint8_t* data;
+  RETURN_NOT_OK(client->Create(object_id, size, nullptr, 0, &data));
+  ObjectOutputStream stream(client, data, size);
+  Status status = WriteStream(&stream, schema, write_batches);
+  if (!status.ok()) {
+    // Abort rather than seal the partial object, so that no client waiting for
+    // it in Get ever receives it.
+    Status cleanup = client->Abort(object_id);
+    if (!cleanup.ok()) {
+      ARROW_LOG(WARNING) << "Failed to abort Plasma object " << object_id.hex()
+                         << " after a failed put: " << cleanup.ToString();
+    }
+    return status;
+  }
+  RETURN_NOT_OK(client->Seal(object_id));
+  // Drop the reference taken by Create, so that the store can evict the object
+  return client->Release(object_id);
+}
+
+Status GetStream(PlasmaClient* client, const ObjectID& object_id, int64_t timeout_ms,
+                 std::shared_ptr<arrow::RecordBatchReader>* out) {
+  ObjectBuffer object_buffer;
+  RETURN_NOT_OK(client->Get(&object_id, 1, timeout_ms, &object_buffer));
+  if (object_buffer.data_size == -1) {
+    return Status::PlasmaObjectNonexistent("Object not found");
+  }
+  // From here on the holder is responsible for releasing the object.
+  auto holder = std::make_shared<ObjectBufferHolder>(client, object_id, object_buffer);
+  std::shared_ptr<arrow::io::InputStream> source =
+      std::make_shared<arrow::io::BufferReader>(holder);
+  return arrow::ipc::RecordBatchStreamReader::Open(source, out);
+}
+
+}  // namespace
+
+Status PutRecordBatch(PlasmaClient* client, const ObjectID& object_id,
+                      const arrow::RecordBatch& batch) {
+  return PutStream(client, object_id, batch.schema(),
+                   [&batch](arrow::ipc::RecordBatchWriter* writer) {
+                     return writer->WriteRecordBatch(batch, true);
+                   });
+}
+
+Status PutTable(PlasmaClient* client, const ObjectID& object_id,
+                const arrow::Table& table) {
+  return PutStream(client, object_id, table.schema(),
+                   [&table](arrow::ipc::RecordBatchWriter* writer) {
+                     return writer->WriteTable(table);
+                   });
+}
+
+Status GetRecordBatch(PlasmaClient* client, const ObjectID& object_id,
+                      int64_t timeout_ms, std::shared_ptr<arrow::RecordBatch>* out) {
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  RETURN_NOT_OK(GetStream(client, object_id, timeout_ms, &reader));
+  RETURN_NOT_OK(reader->ReadNext(out));
+  if (*out == nullptr) {
+    return Status::Invalid("Plasma object does not contain a record batch");
+  }
+  return Status::OK();
+}
+
+Status GetTable(PlasmaClient* client, const ObjectID& object_id, int64_t timeout_ms,
+                std::shared_ptr<arrow::Table>* out) {
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  RETURN_NOT_OK(GetStream(client, object_id, timeout_ms, &reader));
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    RETURN_NOT_OK(reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(batch);
+  }
+  if (batches.empty()) {
+    std::shared_ptr<arrow::Schema> schema = reader->schema();
+    std::vector<std::shared_ptr<arrow::Column>> columns;
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      columns.push_back(
+          std::make_shared<arrow::Column>(schema->field(i), arrow::ArrayVector{}));
+    }
+    *out = std::make_shared<arrow::Table>(schema, columns, 0);
+    return Status::OK();
+  }
+  return arrow::Table::FromRecordBatches(batches, out);
+}
+
+}  // namespace plasma
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Helpers to store Arrow record batches and tables as Plasma objects. An
+// object holds the batches in the Arrow IPC stream format (schema, record
+// batches, end-of-stream marker), so it is self-describing.
+
+#ifndef PLASMA_RECORD_BATCH_H
+#define PLASMA_RECORD_BATCH_H
+
+#include <memory>
+
+#include "arrow/status.h"
+#include "arrow/util/visibility.h"
+#include "plasma/client.h"
+#include "plasma/common.h"
+
+namespace arrow {
+
+class RecordBatch;
+class Table;
+
+}  // namespace arrow
+
+namespace plasma {
+
+/// \brief Write a record batch into a new Plasma object and seal it
+///
+/// The object is created with exactly the size of the serialized batch, and
+/// large buffers are copied with the client's thread pool. The client does
+/// not keep a reference to the object afterwards. If writing fails, the
+/// object is aborted without being sealed.
+///
+/// \param[in] client a connected Plasma client
+/// \param[in] object_id the ID of the object to create
+/// \param[in] batch the record batch to write
+/// \return Status
+ARROW_EXPORT
+Status PutRecordBatch(PlasmaClient* client, const ObjectID& object_id,
+                      const arrow::RecordBatch& batch);
+
+/// \brief Write all chunks of a table into a new Plasma object and seal it
+///
+/// \param[in] client a connected Plasma client
+/// \param[in] object_id the ID of the object to create
+/// \param[in] table the table to write
+/// \return Status
+ARROW_EXPORT
+Status PutTable(PlasmaClient* client, const ObjectID& object_id,
+                const arrow::Table& table);
+
+/// \brief Read a record batch stored with PutRecordBatch without copying
+///
+/// The buffers of the returned batch point into the shared memory of the
+/// object. The object stays in use by the client until the last of these
+/// buffers is destroyed, so the client must outlive the batch, and the buffers
+/// must be released on a thread that may use the client.
+///
+/// \param[in] client a connected Plasma client
+/// \param[in] object_id the ID of the object to read
+/// \param[in] timeout_ms how long to wait for the object to be sealed, -1 to
+/// wait forever
+/// \param[out] out the record batch
+/// \return Status, PlasmaObjectNonexistent if the object is not available
+ARROW_EXPORT
+Status GetRecordBatch(PlasmaClient* client, const ObjectID& object_id,
+                      int64_t timeout_ms, std::shared_ptr<arrow::RecordBatch>* out);
+
+/// \brief Read a table stored with PutTable (or PutRecordBatch) without copying
+///
+/// Each record batch in the object becomes one chunk of the table. The same
+/// lifetime rules as for GetRecordBatch apply.
+///
+/// \param[in] client a connected Plasma client
+/// \param[in] object_id the ID of the object to read
+/// \param[in] timeout_ms how long to wait for the object to be sealed, -1 to
+/// wait forever
+/// \param[out] out the table
+/// \return Status, PlasmaObjectNonexistent if the object is not available
+ARROW_EXPORT
+Status GetTable(PlasmaClient* client, const ObjectID& object_id, int64_t timeout_ms,
+                std::shared_ptr<arrow::Table>* out);
+
+}  // namespace plasma
+
+#endif  // PLASMA_RECORD_BATCH_H
@@ -43,7 +43,10 @@
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -94,28 +97,74 @@ GetRequest::GetRequest(Client* client, const std::vector<ObjectID>& object_ids)
   num_objects_to_wait_for = unique_ids.size();
 }
 
-Client::Client(int fd) : fd(fd) {}
+LatencyHistogram::LatencyHistogram() : count_(0), max_(0) {
+  std::fill(buckets_, buckets_ + kNumBuckets, 0);
+}
+
+void LatencyHistogram::record(int64_t latency_ns) {
+  int bucket = 0;
+  while (bucket < kNumBuckets - 1 && (latency_ns >> bucket) > 0) {
+    ++bucket;
+  }
+  ++buckets_[bucket];
+  ++count_;
+  max_ = std::max(max_, latency_ns);
+}
+
+int64_t LatencyHistogram::percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  // The number of recorded values that are at most the percentile.
+  int64_t rank = static_cast<int64_t>(percentile / 100 * static_cast<double>(count_));
+  int64_t seen = 0;
+  for (int bucket = 0; bucket < kNumBuckets; ++bucket) {
+    seen += buckets_[bucket];
+    if (seen > rank || seen == count_) {
+      // Bucket b holds latencies of at most 2^b - 1; the top bucket holds
+      // everything larger, and 2^63 does not fit in an int64_t.
+      int64_t upper_bound;
+      if (bucket == 0) {
+        upper_bound = 0;
+      } else if (bucket >= 63) {
+        upper_bound = std::numeric_limits<int64_t>::max();
+      } else {
+        upper_bound = (int64_t(1) << bucket) - 1;
+      }
+      return std::min(upper_bound, max_);
+    }
+  }
+  return max_;
+}
+
+StoreCounters::StoreCounters()
+    : num_requests(0),
+      num_creates(0),
+      num_create_failures(0),
+      num_seals(0),
+      num_gets(0),
+      num_get_misses(0),
+      num_releases(0),
+      num_evictions(0),
+      num_bytes_evicted(0) {}
+
+Client::Client(int fd) : fd(fd), quota(0), object_bytes(0) {}
 
 PlasmaStore::PlasmaStore(EventLoop* loop, int64_t system_memory, std::string directory,
-                         bool hugepages_enabled)
-    : loop_(loop), eviction_policy_(&store_info_) {
+                         bool hugepages_enabled, int64_t client_quota,
+                         int64_t reserved_capacity)
+    : loop_(loop),
+      eviction_policy_(&store_info_),
+      notification_timer_(-1),
+      client_quota_(client_quota),
+      reserved_capacity_(reserved_capacity),
+      quota_object_bytes_(0) {
   store_info_.memory_capacity = system_memory;
   store_info_.directory = directory;
   store_info_.hugepages_enabled = hugepages_enabled;
 }
 
-// TODO(pcm): Get rid of this destructor by using RAII to clean up data.
-PlasmaStore::~PlasmaStore() {
-  for (const auto& element : pending_notifications_) {
-    auto object_notifications = element.second.object_notifications;
-    for (size_t i = 0; i < object_notifications.size(); ++i) {
-      uint8_t* notification = reinterpret_cast<uint8_t*>(object_notifications.at(i));
-      uint8_t* data = notification;
-      // TODO(pcm): Get rid of this delete.
-      delete[] data;
-    }
-  }
-}
+PlasmaStore::~PlasmaStore() {}
 
 const PlasmaStoreInfo* PlasmaStore::get_plasma_store_info() { return &store_info_; }
 
@@ -132,12 +181,55 @@ void PlasmaStore::add_client_to_object_clients(ObjectTableEntry* entry, Client*
     // Tell the eviction policy that this object is being used.
     std::vector<ObjectID> objects_to_evict;
     eviction_policy_.begin_object_access(entry->object_id, &objects_to_evict);
-    delete_objects(objects_to_evict);
+    evict_objects(objects_to_evict);
   }
   // Add the client pointer to the list of clients using this object.
   entry->clients.insert(client);
 }
 
+bool PlasmaStore::make_room_in_quota(Client* client, int64_t size) {
+  if (size > client->quota || size > store_info_.memory_capacity - reserved_capacity_) {
+    // Do not evict anything for an object that can never fit.
+    return false;
+  }
+  // The client must stay below its own quota, and the clients with a quota
+  // together must leave the reserved capacity alone.
+  int64_t required_space =
+      std::max(client->object_bytes + size - client->quota,
+               quota_object_bytes_ + size -
+                   (store_info_.memory_capacity - reserved_capacity_));
+  if (required_space <= 0) {
+    return true;
+  }
+  return evict_client_objects(client, required_space) >= required_space;
+}
+
+int64_t PlasmaStore::evict_client_objects(Client* client, int64_t num_bytes) {
+  std::vector<ObjectID> objects_to_evict;
+  int64_t num_bytes_evicted = eviction_policy_.choose_objects_to_evict_if(
+      num_bytes,
+      [this, client](const ObjectID& object_id) {
+        return store_info_.objects[object_id]->owner == client;
+      },
+      &objects_to_evict);
+  ARROW_LOG(DEBUG) << "evicting " << objects_to_evict.size() << " objects of client on fd "
+                   << client->fd << " to free up " << num_bytes_evicted << " bytes";
+  evict_objects(objects_to_evict);
+  return num_bytes_evicted;
+}
+
+void PlasmaStore::remove_object_owner(ObjectTableEntry* entry) {
+  if (entry->owner == nullptr) {
+    return;
+  }
+  int64_t size = entry->info.data_size + entry->info.metadata_size;
+  entry->owner->object_bytes -= size;
+  if (entry->owner->quota > 0) {
+    quota_object_bytes_ -= size;
+  }
+  entry->owner = nullptr;
+}
+
 // Create a new object buffer in the hash table.
 int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
                                int64_t metadata_size, Client* client,
@@ -148,6 +240,12 @@ int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
     // ignore this requst.
     return PlasmaError_ObjectExists;
   }
+  const int64_t size = data_size + metadata_size;
+  // Clients with a quota only ever evict their own objects, so that they
+  // cannot push the objects of other clients out of the store.
+  if (client->quota > 0 && !make_room_in_quota(client, size)) {
+    return PlasmaError_OutOfMemory;
+  }
   // Try to evict objects until there is enough space.
   uint8_t* pointer;
   do {
@@ -158,14 +256,18 @@ int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
     // plasma_client.cc). Note that even though this pointer is 64-byte aligned,
     // it is not guaranteed that the corresponding pointer in the client will be
     // 64-byte aligned, but in practice it often will be.
-    pointer =
-        reinterpret_cast<uint8_t*>(dlmemalign(BLOCK_SIZE, data_size + metadata_size));
-    if (pointer == NULL) {
+    pointer = reinterpret_cast<uint8_t*>(dlmemalign(BLOCK_SIZE, size));
+    if (pointer == NULL && client->quota > 0) {
+      // The store is full even though the client is within its quota; the
+      // client may still make room among its own objects.
+      if (evict_client_objects(client, size) == 0) {
+        return PlasmaError_OutOfMemory;
+      }
+    } else if (pointer == NULL) {
       // Tell the eviction policy how much space we need to create this object.
       std::vector<ObjectID> objects_to_evict;
-      bool success =
-          eviction_policy_.require_space(data_size + metadata_size, &objects_to_evict);
-      delete_objects(objects_to_evict);
+      bool success = eviction_policy_.require_space(size, &objects_to_evict);
+      evict_objects(objects_to_evict);
       // Return an error to the client if not enough space could be freed to
       // create the object.
       if (!success) {
@@ -190,6 +292,11 @@ int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
   entry->map_size = map_size;
   entry->offset = offset;
   entry->state = PLASMA_CREATED;
+  entry->owner = client;
+  client->object_bytes += size;
+  if (client->quota > 0) {
+    quota_object_bytes_ += size;
+  }
 
   store_info_.objects[object_id] = std::move(entry);
   result->handle.store_fd = fd;
@@ -306,6 +413,7 @@ void PlasmaStore::process_get_request(Client* client,
                                       int64_t timeout_ms) {
   // Create a get request for this object.
   GetRequest* get_req = new GetRequest(client, object_ids);
+  counters_.num_gets += object_ids.size();
 
   for (auto object_id : object_ids) {
     // Check if this object is already present locally. If so, record that the
@@ -323,6 +431,7 @@ void PlasmaStore::process_get_request(Client* client,
       // object is not present. This will be parsed by the client. We set the
       // data size to -1 to indicate that the object is not present.
       get_req->objects[object_id].data_size = -1;
+      counters_.num_get_misses += 1;
       // Add the get request to the relevant data structures.
       object_get_requests_[object_id].push_back(get_req);
     }
@@ -353,7 +462,7 @@ int PlasmaStore::remove_client_from_object_clients(ObjectTableEntry* entry,
       // Tell the eviction policy that this object is no longer being used.
       std::vector<ObjectID> objects_to_evict;
       eviction_policy_.end_object_access(entry->object_id, &objects_to_evict);
-      delete_objects(objects_to_evict);
+      evict_objects(objects_to_evict);
     }
     // Return 1 to indicate that the client was removed.
     return 1;
@@ -368,6 +477,22 @@ void PlasmaStore::release_object(const ObjectID& object_id, Client* client) {
   ARROW_CHECK(entry != NULL);
   // Remove the client from the object's array of clients.
   ARROW_CHECK(remove_client_from_object_clients(entry, client) == 1);
+  counters_.num_releases += 1;
+}
+
+int PlasmaStore::abort_object(const ObjectID& object_id, Client* client) {
+  auto entry = get_object_table_entry(&store_info_, object_id);
+  if (entry == NULL || entry->state != PLASMA_CREATED ||
+      entry->clients.find(client) == entry->clients.end()) {
+    return PlasmaError_ObjectNonexistent;
+  }
+  ARROW_LOG(DEBUG) << "aborting object " << object_id.hex();
+  // The creator still uses the object, so it is not in the eviction policy's
+  // cache, and get requests keep waiting for an object with this ID.
+  remove_object_owner(entry);
+  dlfree(entry->pointer);
+  store_info_.objects.erase(object_id);
+  return PlasmaError_OK;
 }
 
 // Check if an object is present.
@@ -384,6 +509,7 @@ void PlasmaStore::seal_object(const ObjectID& object_id, unsigned char digest[])
   ARROW_CHECK(entry->state == PLASMA_CREATED);
   // Set the state of object to SEALED.
   entry->state = PLASMA_SEALED;
+  counters_.num_seals += 1;
   // Set the object digest.
   entry->info.digest = std::string(reinterpret_cast<char*>(&digest[0]), kDigestSize);
   // Inform all subscribers that a new object has been sealed.
@@ -393,6 +519,16 @@ void PlasmaStore::seal_object(const ObjectID& object_id, unsigned char digest[])
   update_object_get_requests(object_id);
 }
 
+void PlasmaStore::evict_objects(const std::vector<ObjectID>& object_ids) {
+  for (const auto& object_id : object_ids) {
+    auto entry = get_object_table_entry(&store_info_, object_id);
+    ARROW_CHECK(entry != NULL) << "To evict an object it must be in the object table.";
+    counters_.num_evictions += 1;
+    counters_.num_bytes_evicted += entry->info.data_size + entry->info.metadata_size;
+  }
+  delete_objects(object_ids);
+}
+
 void PlasmaStore::delete_objects(const std::vector<ObjectID>& object_ids) {
   for (const auto& object_id : object_ids) {
     ARROW_LOG(DEBUG) << "deleting object " << object_id.hex();
@@ -405,6 +541,7 @@ void PlasmaStore::delete_objects(const std::vector<ObjectID>& object_ids) {
         << "To delete an object it must have been sealed.";
     ARROW_CHECK(entry->clients.size() == 0)
         << "To delete an object, there must be no clients currently using it.";
+    remove_object_owner(entry);
     dlfree(entry->pointer);
     store_info_.objects.erase(object_id);
     // Inform all subscribers that the object has been deleted.
@@ -432,6 +569,21 @@ void PlasmaStore::connect_client(int listener_sock) {
   ARROW_LOG(DEBUG) << "New connection with fd " << client_fd;
 }
 
+void PlasmaStore::set_client_quota(Client* client, int64_t requested_quota) {
+  // A client can only lower the store's default quota. The quota cannot change
+  // while the client has objects in the store.
+  if (client->object_bytes != 0) {
+    ARROW_LOG(WARNING) << "Ignoring quota request of client on fd " << client->fd
+                       << " that already created objects";
+    return;
+  }
+  if (requested_quota > 0 && (client_quota_ == 0 || requested_quota < client_quota_)) {
+    client->quota = requested_quota;
+  } else {
+    client->quota = client_quota_;
+  }
+}
+
 void PlasmaStore::disconnect_client(int client_fd) {
   ARROW_CHECK(client_fd > 0);
   auto it = connected_clients_.find(client_fd);
@@ -445,6 +597,13 @@ void PlasmaStore::disconnect_client(int client_fd) {
   for (const auto& entry : store_info_.objects) {
     remove_client_from_object_clients(entry.second.get(), it->second.get());
   }
+  // The objects of this client stay in the store but no longer count against
+  // any quota.
+  for (const auto& entry : store_info_.objects) {
+    if (entry.second->owner == it->second.get()) {
+      remove_object_owner(entry.second.get());
+    }
+  }
 
   // Note, the store may still attempt to send a message to the disconnected
   // client (for example, when an object ID that the client was waiting for
@@ -454,79 +613,172 @@ void PlasmaStore::disconnect_client(int client_fd) {
 }
 
 /// Send notifications about sealed objects to the subscribers. This is called
-/// in seal_object. If the socket's send buffer is full, the notification will
-/// be
-/// buffered, and this will be called again when the send buffer has room.
+/// once per event loop iteration after objects were sealed or deleted. The
+/// notifications queued since the last call are sent as one message. If the
+/// socket's send buffer is full, the rest of the message will be buffered, and
+/// this will be called again when the send buffer has room.
 ///
 /// @param client_fd The client to send the notification to.
 void PlasmaStore::send_notifications(int client_fd) {
   auto it = pending_notifications_.find(client_fd);
+  if (it == pending_notifications_.end()) {
+    return;
+  }
+  NotificationQueue& queue = it->second;
 
-  int num_processed = 0;
   bool closed = false;
-  // Loop over the array of pending notifications and send as many of them as
-  // possible.
-  for (size_t i = 0; i < it->second.object_notifications.size(); ++i) {
-    uint8_t* notification =
-        reinterpret_cast<uint8_t*>(it->second.object_notifications.at(i));
-    // Decode the length, which is the first bytes of the message.
-    int64_t size = *(reinterpret_cast<int64_t*>(notification));
-
-    // Attempt to send a notification about this object ID.
-    ssize_t nbytes = send(client_fd, notification, sizeof(int64_t) + size, 0);
+  while (true) {
+    if (queue.message.empty()) {
+      if (queue.object_notifications.empty()) {
+        break;
+      }
+      // Batch up everything that was queued while the last message was sent.
+      create_object_info_buffer(queue.object_notifications, &queue.message);
+      queue.object_notifications.clear();
+      queue.pending_seals.clear();
+      queue.bytes_sent = 0;
+    }
+    // Attempt to send the rest of the message.
+    ssize_t nbytes = send(client_fd, queue.message.data() + queue.bytes_sent,
+                          queue.message.size() - queue.bytes_sent, 0);
     if (nbytes >= 0) {
-      ARROW_CHECK(nbytes == static_cast<ssize_t>(sizeof(int64_t)) + size);
+      queue.bytes_sent += nbytes;
+      if (queue.bytes_sent == queue.message.size()) {
+        queue.message.clear();
+      }
     } else if (nbytes == -1 &&
                (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
-      ARROW_LOG(DEBUG) << "The socket's send buffer is full, so we are caching this "
-                          "notification and will send it later.";
+      ARROW_LOG(DEBUG) << "The socket's send buffer is full, so we are caching these "
+                          "notifications and will send them later.";
       // Add a callback to the event loop to send queued notifications whenever
-      // there is room in the socket's send buffer. Callbacks can be added
-      // more than once here and will be overwritten. The callback is removed
-      // at the end of the method.
-      // TODO(pcm): Introduce status codes and check in case the file descriptor
-      // is added twice.
-      loop_->AddFileEvent(client_fd, kEventLoopWrite, [this, client_fd](int events) {
-        send_notifications(client_fd);
-      });
-      break;
+      // there is room in the socket's send buffer. The callback is removed
+      // once everything has been sent.
+      if (!queue.waiting_for_write) {
+        loop_->AddFileEvent(client_fd, kEventLoopWrite, [this, client_fd](int events) {
+          send_notifications(client_fd);
+        });
+        queue.waiting_for_write = true;
+      }
+      return;
     } else {
       ARROW_LOG(WARNING) << "Failed to send notification to client on fd " << client_fd;
       if (errno == EPIPE) {
         closed = true;
         break;
       }
+      // Drop the message.
+      queue.message.clear();
     }
-    num_processed += 1;
-    // The corresponding malloc happened in create_object_info_buffer
-    // within push_notification.
-    delete[] notification;
   }
-  // Remove the sent notifications from the array.
-  it->second.object_notifications.erase(
-      it->second.object_notifications.begin(),
-      it->second.object_notifications.begin() + num_processed);
 
   // Stop sending notifications if the pipe was broken.
   if (closed) {
     close(client_fd);
     pending_notifications_.erase(client_fd);
+  } else {
+    queue.waiting_for_write = false;
   }
 
-  // If we have sent all notifications, remove the fd from the event loop.
-  if (it->second.object_notifications.empty()) {
-    loop_->RemoveFileEvent(client_fd);
+  // We have sent all notifications, remove the fd from the event loop.
+  loop_->RemoveFileEvent(client_fd);
+}
+
+// Append a notification to a subscriber's queue.
+static void queue_notification(NotificationQueue* queue, ObjectInfoT* object_info) {
+  ObjectID object_id = ObjectID::from_binary(object_info->object_id);
+  auto seal = queue->pending_seals.find(object_id);
+  if (object_info->is_deletion && seal != queue->pending_seals.end()) {
+    // The subscriber has not been told about the object yet, so it does not
+    // need to hear about either event.
+    queue->object_notifications[seal->second].reset();
+    queue->pending_seals.erase(seal);
+    return;
+  }
+  if (!object_info->is_deletion) {
+    queue->pending_seals[object_id] = queue->object_notifications.size();
   }
+  queue->object_notifications.emplace_back(new ObjectInfoT(*object_info));
 }
 
 void PlasmaStore::push_notification(ObjectInfoT* object_info) {
   for (auto& element : pending_notifications_) {
-    uint8_t* notification = create_object_info_buffer(object_info);
-    element.second.object_notifications.push_back(notification);
-    send_notifications(element.first);
-    // The notification gets freed in send_notifications when the notification
-    // is sent over the socket.
+    queue_notification(&element.second, object_info);
   }
+  schedule_flush_notifications();
+}
+
+void PlasmaStore::schedule_flush_notifications() {
+  // Send everything that is pushed during this event loop iteration at once.
+  if (notification_timer_ == -1 && !pending_notifications_.empty()) {
+    notification_timer_ = loop_->AddTimer(0, [this](int64_t timer_id) {
+      notification_timer_ = -1;
+      flush_notifications();
+      return kEventLoopTimerDone;
+    });
+  }
+}
+
+void PlasmaStore::flush_notifications() {
+  std::vector<int> subscribers;
+  for (const auto& element : pending_notifications_) {
+    // Subscribers that are still sending the previous message are flushed by
+    // their write callback.
+    if (element.second.message.empty() && !element.second.object_notifications.empty()) {
+      subscribers.push_back(element.first);
+    }
+  }
+  // send_notifications may remove subscribers, so do not iterate over the map.
+  for (int fd : subscribers) {
+    send_notifications(fd);
+  }
+}
+
+void PlasmaStore::get_metrics(StoreMetrics* metrics) {
+  int64_t num_sealed_objects = 0;
+  int64_t bytes_in_use = 0;
+  for (const auto& entry : store_info_.objects) {
+    if (entry.second->state == PLASMA_SEALED) {
+      num_sealed_objects += 1;
+    }
+    bytes_in_use += entry.second->info.data_size + entry.second->info.metadata_size;
+  }
+  int64_t footprint;
+  int64_t allocated;
+  int64_t num_segments;
+  get_malloc_stats(&footprint, &allocated, &num_segments);
+
+  // Gauges.
+  metrics->emplace_back("memory_capacity", store_info_.memory_capacity);
+  metrics->emplace_back("num_clients", connected_clients_.size());
+  metrics->emplace_back("num_subscribers", pending_notifications_.size());
+  metrics->emplace_back("num_objects", store_info_.objects.size());
+  metrics->emplace_back("num_sealed_objects", num_sealed_objects);
+  metrics->emplace_back("bytes_in_use", bytes_in_use);
+  metrics->emplace_back("quota_bytes_in_use", quota_object_bytes_);
+  // The arena: chunk headers and alignment padding are allocated but not part
+  // of any object, free chunks are mapped but cannot hold the next object if
+  // they are too small (fragmentation).
+  metrics->emplace_back("malloc_footprint", footprint);
+  metrics->emplace_back("malloc_num_segments", num_segments);
+  metrics->emplace_back("malloc_overhead_bytes", allocated - bytes_in_use);
+  metrics->emplace_back("malloc_free_bytes", footprint - allocated);
+  // Counters.
+  metrics->emplace_back("num_requests", counters_.num_requests);
+  metrics->emplace_back("num_creates", counters_.num_creates);
+  metrics->emplace_back("num_create_failures", counters_.num_create_failures);
+  metrics->emplace_back("num_seals", counters_.num_seals);
+  metrics->emplace_back("num_gets", counters_.num_gets);
+  metrics->emplace_back("num_get_misses", counters_.num_get_misses);
+  metrics->emplace_back("num_releases", counters_.num_releases);
+  metrics->emplace_back("num_evictions", counters_.num_evictions);
+  metrics->emplace_back("num_bytes_evicted", counters_.num_bytes_evicted);
+  // Time spent processing a message, not including the time a get waits for
+  // the objects to be sealed.
+  metrics->emplace_back("request_latency_p50_ns", request_latency_.percentile(50));
+  metrics->emplace_back("request_latency_p90_ns", request_latency_.percentile(90));
+  metrics->emplace_back("request_latency_p99_ns", request_latency_.percentile(99));
+  metrics->emplace_back("request_latency_p999_ns", request_latency_.percentile(99.9));
+  metrics->emplace_back("request_latency_max_ns", request_latency_.max());
 }
 
 // Subscribe to notifications about sealed objects.
@@ -542,20 +794,19 @@ void PlasmaStore::subscribe_to_updates(Client* client) {
     return;
   }
 
-  // Create a new array to buffer notifications that can't be sent to the
-  // subscriber yet because the socket send buffer is full. TODO(rkn): the queue
-  // never gets freed.
-  // TODO(pcm): Is the following neccessary?
-  pending_notifications_[fd];
+  // Create a new queue to buffer notifications until they are sent to the
+  // subscriber. TODO(rkn): the queue never gets freed.
+  NotificationQueue& queue = pending_notifications_[fd];
 
   // Push notifications to the new subscriber about existing objects.
   for (const auto& entry : store_info_.objects) {
-    push_notification(&entry.second->info);
+    queue_notification(&queue, &entry.second->info);
   }
-  send_notifications(fd);
+  schedule_flush_notifications();
 }
 
 Status PlasmaStore::process_message(Client* client) {
+  auto start = std::chrono::steady_clock::now();
   int64_t type;
   Status s = ReadMessage(client->fd, &type, &input_buffer_);
   ARROW_CHECK(s.ok() || s.IsIOError());
@@ -576,6 +827,11 @@ Status PlasmaStore::process_message(Client* client) {
           ReadCreateRequest(input, input_size, &object_id, &data_size, &metadata_size));
       int error_code =
           create_object(object_id, data_size, metadata_size, client, &object);
+      if (error_code == PlasmaError_OK) {
+        counters_.num_creates += 1;
+      } else {
+        counters_.num_create_failures += 1;
+      }
       HANDLE_SIGPIPE(SendCreateReply(client->fd, object_id, &object, error_code),
                      client->fd);
       if (error_code == PlasmaError_OK) {
@@ -605,6 +861,11 @@ Status PlasmaStore::process_message(Client* client) {
       RETURN_NOT_OK(ReadSealRequest(input, input_size, &object_id, &digest[0]));
       seal_object(object_id, &digest[0]);
     } break;
+    case MessageType_PlasmaAbortRequest: {
+      RETURN_NOT_OK(ReadAbortRequest(input, input_size, &object_id));
+      int error_code = abort_object(object_id, client);
+      HANDLE_SIGPIPE(SendAbortReply(client->fd, object_id, error_code), client->fd);
+    } break;
     case MessageType_PlasmaEvictRequest: {
       // This code path should only be used for testing.
       int64_t num_bytes;
@@ -612,16 +873,25 @@ Status PlasmaStore::process_message(Client* client) {
       std::vector<ObjectID> objects_to_evict;
       int64_t num_bytes_evicted =
           eviction_policy_.choose_objects_to_evict(num_bytes, &objects_to_evict);
-      delete_objects(objects_to_evict);
+      evict_objects(objects_to_evict);
       HANDLE_SIGPIPE(SendEvictReply(client->fd, num_bytes_evicted), client->fd);
     } break;
     case MessageType_PlasmaSubscribeRequest:
       subscribe_to_updates(client);
       break;
     case MessageType_PlasmaConnectRequest: {
+      int64_t quota;
+      RETURN_NOT_OK(ReadConnectRequest(input, input_size, &quota));
+      set_client_quota(client, quota);
       HANDLE_SIGPIPE(SendConnectReply(client->fd, store_info_.memory_capacity),
                      client->fd);
     } break;
+    case MessageType_PlasmaMetricsRequest: {
+      RETURN_NOT_OK(ReadMetricsRequest(input, input_size));
+      StoreMetrics metrics;
+      get_metrics(&metrics);
+      HANDLE_SIGPIPE(SendMetricsReply(client->fd, metrics), client->fd);
+    } break;
     case DISCONNECT_CLIENT:
       ARROW_LOG(DEBUG) << "Disconnecting client on fd " << client->fd;
       disconnect_client(client->fd);
@@ -630,6 +900,10 @@ Status PlasmaStore::process_message(Client* client) {
       // This code should be unreachable.
       ARROW_CHECK(0);
   }
+  counters_.num_requests += 1;
+  request_latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
   return Status::OK();
 }
 
@@ -638,11 +912,11 @@ class PlasmaStoreRunner {
   PlasmaStoreRunner() {}
 
   void Start(char* socket_name, int64_t system_memory, std::string directory,
-             bool hugepages_enabled) {
+             bool hugepages_enabled, int64_t client_quota, int64_t reserved_capacity) {
     // Create the event loop.
     loop_.reset(new EventLoop);
-    store_.reset(
-        new PlasmaStore(loop_.get(), system_memory, directory, hugepages_enabled));
+    store_.reset(new PlasmaStore(loop_.get(), system_memory, directory,
+                                 hugepages_enabled, client_quota, reserved_capacity));
     plasma_config = store_->get_plasma_store_info();
     int socket = bind_ipc_sock(socket_name, true);
     // TODO(pcm): Check return value.
@@ -678,14 +952,16 @@ void HandleSignal(int signal) {
 }
 
 void start_server(char* socket_name, int64_t system_memory, std::string plasma_directory,
-                  bool hugepages_enabled) {
+                  bool hugepages_enabled, int64_t client_quota,
+                  int64_t reserved_capacity) {
   // Ignore SIGPIPE signals. If we don't do this, then when we attempt to write
   // to a client that has already died, the store could die.
   signal(SIGPIPE, SIG_IGN);
 
   g_runner.reset(new PlasmaStoreRunner());
   signal(SIGTERM, HandleSignal);
-  g_runner->Start(socket_name, system_memory, plasma_directory, hugepages_enabled);
+  g_runner->Start(socket_name, system_memory, plasma_directory, hugepages_enabled,
+                  client_quota, reserved_capacity);
 }
 
 }  // namespace plasma
@@ -696,8 +972,12 @@ int main(int argc, char* argv[]) {
   std::string plasma_directory;
   bool hugepages_enabled = false;
   int64_t system_memory = -1;
+  // The default quota per client and the capacity that is kept free of the
+  // objects of clients with a quota.
+  int64_t client_quota = 0;
+  int64_t reserved_capacity = 0;
   int c;
-  while ((c = getopt(argc, argv, "s:m:d:h")) != -1) {
+  while ((c = getopt(argc, argv, "s:m:d:hq:r:")) != -1) {
     switch (c) {
       case 'd':
         plasma_directory = std::string(optarg);
@@ -717,6 +997,18 @@ int main(int argc, char* argv[]) {
                         << "GB of memory.";
         break;
       }
+      case 'q': {
+        char extra;
+        int scanned = sscanf(optarg, "%" SCNd64 "%c", &client_quota, &extra);
+        ARROW_CHECK(scanned == 1 && client_quota >= 0);
+        break;
+      }
+      case 'r': {
+        char extra;
+        int scanned = sscanf(optarg, "%" SCNd64 "%c", &reserved_capacity, &extra);
+        ARROW_CHECK(scanned == 1 && reserved_capacity >= 0);
+        break;
+      }
       default:
         exit(-1);
     }
@@ -728,6 +1020,9 @@ int main(int argc, char* argv[]) {
   if (system_memory == -1) {
     ARROW_LOG(FATAL) << "please specify the amount of system memory with -m switch";
   }
+  if (reserved_capacity > system_memory) {
+    ARROW_LOG(FATAL) << "the reserved capacity (-r) cannot exceed the system memory";
+  }
   if (hugepages_enabled && plasma_directory.empty()) {
     ARROW_LOG(FATAL) << "if you want to use hugepages, please specify path to huge pages "
                         "filesystem with -d";
@@ -770,5 +1065,6 @@ int main(int argc, char* argv[]) {
   // available.
   plasma::dlmalloc_set_footprint_limit((size_t)system_memory);
   ARROW_LOG(DEBUG) << "starting server listening on " << socket_name;
-  plasma::start_server(socket_name, system_memory, plasma_directory, hugepages_enabled);
+  plasma::start_server(socket_name, system_memory, plasma_directory, hugepages_enabled,
+                       client_quota, reserved_capacity);
 }
@@ -19,7 +19,9 @@
 #define PLASMA_STORE_H
 
 #include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "plasma/common.h"
@@ -33,9 +35,78 @@ namespace plasma {
 struct GetRequest;
 
 struct NotificationQueue {
-  /// The object notifications for clients. We notify the client about the
-  /// objects in the order that the objects were sealed or deleted.
-  std::deque<uint8_t*> object_notifications;
+  NotificationQueue() : bytes_sent(0), waiting_for_write(false) {}
+
+  /// The object notifications for clients that have not been serialized yet.
+  /// We notify the client about the objects in the order that the objects were
+  /// sealed or deleted. Entries are null if the notification was cancelled.
+  std::vector<std::unique_ptr<ObjectInfoT>> object_notifications;
+  /// The index in object_notifications of the seal notification for each
+  /// object, so that deleting the object before the subscriber heard about it
+  /// can drop both notifications.
+  std::unordered_map<ObjectID, size_t, UniqueIDHasher> pending_seals;
+  /// The serialized batch of notifications that is being sent. New
+  /// notifications are only serialized once this has been sent completely,
+  /// so that they keep being coalesced while the subscriber is slow.
+  std::vector<uint8_t> message;
+  /// The number of bytes of message that have already been sent.
+  size_t bytes_sent;
+  /// Whether a write callback is registered to send the rest of message.
+  bool waiting_for_write;
+};
+
+/// Histogram of request processing times with power-of-two buckets.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  /// Record the processing time of one request.
+  ///
+  /// @param latency_ns The processing time in nanoseconds.
+  void record(int64_t latency_ns);
+
+  /// Get an upper bound of a percentile of the recorded processing times. The
+  /// bound is less than twice the exact value.
+  ///
+  /// @param percentile The percentile, between 0 and 100.
+  /// @return The bound in nanoseconds, or 0 if nothing was recorded.
+  int64_t percentile(double percentile) const;
+
+  int64_t count() const { return count_; }
+
+  int64_t max() const { return max_; }
+
+ private:
+  static constexpr int kNumBuckets = 64;
+  /// Bucket i counts the processing times t with 2^(i-1) <= t < 2^i.
+  int64_t buckets_[kNumBuckets];
+  int64_t count_;
+  int64_t max_;
+};
+
+/// Counters of the work done by the store since it started.
+struct StoreCounters {
+  StoreCounters();
+
+  /// The number of messages that were processed.
+  int64_t num_requests;
+  /// The number of objects that were created.
+  int64_t num_creates;
+  /// The number of create requests that failed because the object exists or
+  /// does not fit.
+  int64_t num_create_failures;
+  /// The number of objects that were sealed.
+  int64_t num_seals;
+  /// The number of objects that were requested with get.
+  int64_t num_gets;
+  /// The number of objects that were not sealed yet when they were requested.
+  int64_t num_get_misses;
+  /// The number of objects that were released.
+  int64_t num_releases;
+  /// The number of objects that were evicted.
+  int64_t num_evictions;
+  /// The number of bytes of data and metadata that were evicted.
+  int64_t num_bytes_evicted;
 };
 
 /// Contains all information that is associated with a Plasma store client.
@@ -44,12 +115,27 @@ struct Client {
 
   /// The file descriptor used to communicate with the client.
   int fd;
+  /// The maximum number of bytes of objects that this client may have created
+  /// and that are still in the store, or 0 if the client is not limited.
+  int64_t quota;
+  /// The number of bytes of the objects in the store that this client created.
+  int64_t object_bytes;
 };
 
 class PlasmaStore {
  public:
+  /// Create a Plasma store.
+  ///
+  /// @param client_quota The default number of bytes of objects that each
+  ///        client may hold in the store, or 0 for no limit. A client can
+  ///        ask for a lower quota when it connects.
+  /// @param reserved_capacity The number of bytes that clients with a quota
+  ///        cannot fill, so they stay available for the objects of clients
+  ///        without a quota, e.g. the long-lived objects that such clients keep
+  ///        pinned.
   PlasmaStore(EventLoop* loop, int64_t system_memory, std::string directory,
-              bool hugetlbfs_enabled);
+              bool hugetlbfs_enabled, int64_t client_quota = 0,
+              int64_t reserved_capacity = 0);
 
   ~PlasmaStore();
 
@@ -68,13 +154,20 @@ class PlasmaStore {
   ///    present in the store. In this case, the client should not call
   ///    plasma_release.
   ///  - PlasmaError_OutOfMemory, if the store is out of memory and
-  ///    cannot create the object. In this case, the client should not call
-  ///    plasma_release.
+  ///    cannot create the object, or if the object does not fit into the
+  ///    client's quota after evicting the client's own unused objects. In this
+  ///    case, the client should not call plasma_release.
   int create_object(const ObjectID& object_id, int64_t data_size, int64_t metadata_size,
                     Client* client, PlasmaObject* result);
 
-  /// Delete objects that have been created in the hash table. This should only
-  /// be called on objects that are returned by the eviction policy to evict.
+  /// Delete objects that the eviction policy chose to evict, and count them as
+  /// evictions.
+  ///
+  /// @param object_ids Object IDs of the objects to be evicted.
+  void evict_objects(const std::vector<ObjectID>& object_ids);
+
+  /// Delete objects that have been created in the hash table. The objects must
+  /// be sealed and no client may be using them.
   ///
   /// @param object_ids Object IDs of the objects to be deleted.
   void delete_objects(const std::vector<ObjectID>& object_ids);
@@ -114,6 +207,17 @@ class PlasmaStore {
   /// @param client The client making this request.
   void release_object(const ObjectID& object_id, Client* client);
 
+  /// Abort an object that has been created but not sealed. Its memory is freed
+  /// and a later create with the same ID succeeds.
+  ///
+  /// @param object_id Object ID of the object to be aborted.
+  /// @param client The client making this request, which must have created
+  ///        the object.
+  /// @return PlasmaError_OK if the object was aborted, and
+  ///         PlasmaError_ObjectNonexistent if the client did not create the
+  ///         object or has already sealed it.
+  int abort_object(const ObjectID& object_id, Client* client);
+
   /// Subscribe a file descriptor to updates about new sealed objects.
   ///
   /// @param client The client making this request.
@@ -124,6 +228,13 @@ class PlasmaStore {
   /// @param listener_sock The socket that is listening to incoming connections.
   void connect_client(int listener_sock);
 
+  /// Set the quota of a client from its connect request.
+  ///
+  /// @param client The client making this request.
+  /// @param requested_quota The quota the client asked for, or 0 to use the
+  ///        store's default.
+  void set_client_quota(Client* client, int64_t requested_quota);
+
   /// Disconnect a client from the PlasmaStore.
   ///
   /// @param client_fd The client file descriptor that is disconnected.
@@ -131,11 +242,25 @@ class PlasmaStore {
 
   void send_notifications(int client_fd);
 
+  /// Get the counters and gauges of the store.
+  ///
+  /// @param metrics The metrics are appended to this vector.
+  void get_metrics(StoreMetrics* metrics);
+
   Status process_message(Client* client);
 
  private:
+  /// Queue a notification for all subscribers. The notifications are sent in
+  /// one batch per subscriber at the end of the event loop iteration.
   void push_notification(ObjectInfoT* object_notification);
 
+  /// Make sure flush_notifications runs at the end of this event loop
+  /// iteration.
+  void schedule_flush_notifications();
+
+  /// Send the notifications queued in this event loop iteration.
+  void flush_notifications();
+
   void add_client_to_object_clients(ObjectTableEntry* entry, Client* client);
 
   void return_from_get(GetRequest* get_req);
@@ -144,6 +269,20 @@ class PlasmaStore {
 
   int remove_client_from_object_clients(ObjectTableEntry* entry, Client* client);
 
+  /// Evict unused objects that count against the client's quota until the
+  /// client can create an object of the given size.
+  ///
+  /// @return True if the object fits into the quota.
+  bool make_room_in_quota(Client* client, int64_t size);
+
+  /// Evict unused objects that the client created, least recently used first.
+  ///
+  /// @return The number of bytes that were evicted.
+  int64_t evict_client_objects(Client* client, int64_t num_bytes);
+
+  /// Stop counting an object against the quota of the client that created it.
+  void remove_object_owner(ObjectTableEntry* entry);
+
   /// Event loop of the plasma store.
   EventLoop* loop_;
   /// The plasma store information, including the object tables, that is exposed
@@ -164,8 +303,21 @@ class PlasmaStore {
   /// TODO(pcm): Consider putting this into the Client data structure and
   /// reorganize the code slightly.
   std::unordered_map<int, NotificationQueue> pending_notifications_;
+  /// The timer that flushes the notifications at the end of the current event
+  /// loop iteration, or -1 if none is scheduled.
+  int64_t notification_timer_;
+  /// The default quota of the clients, or 0 if clients are not limited.
+  int64_t client_quota_;
+  /// The number of bytes that clients with a quota cannot fill collectively.
+  int64_t reserved_capacity_;
+  /// The number of bytes of objects in the store that count against a quota.
+  int64_t quota_object_bytes_;
 
   std::unordered_map<int, std::unique_ptr<Client>> connected_clients_;
+  /// The counters that are reported by get_metrics.
+  StoreCounters counters_;
+  /// The time it took to process each message.
+  LatencyHistogram request_latency_;
 };
 
 }  // namespace plasma
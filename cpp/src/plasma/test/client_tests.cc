@@ -24,10 +24,17 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
+#include "arrow/builder.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
 #include "plasma/client.h"
 #include "plasma/common.h"
 #include "plasma/plasma.h"
 #include "plasma/protocol.h"
+#include "plasma/record_batch.h"
 
 namespace plasma {
 
@@ -38,13 +45,19 @@ class TestPlasmaStore : public ::testing::Test {
   // TODO(pcm): At the moment, stdout of the test gets mixed up with
   // stdout of the object store. Consider changing that.
   void SetUp() {
+    // Every test starts its own store, on its own socket, so that additional
+    // clients of a test cannot connect to the store of another test.
+    store_socket_name_ =
+        std::string("/tmp/store_") +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
     std::string plasma_directory =
         test_executable.substr(0, test_executable.find_last_of("/"));
-    std::string plasma_command =
-        plasma_directory +
-        "/plasma_store -m 1000000000 -s /tmp/store 1> /dev/null 2> /dev/null &";
+    std::string plasma_command = plasma_directory +
+                                 "/plasma_store -m 1000000000 -s " + store_socket_name_ +
+                                 " 1> /dev/null 2> /dev/null &";
     system(plasma_command.c_str());
-    ARROW_CHECK_OK(client_.Connect("/tmp/store", "", PLASMA_DEFAULT_RELEASE_DELAY));
+    ARROW_CHECK_OK(
+        client_.Connect(store_socket_name_, "", PLASMA_DEFAULT_RELEASE_DELAY));
   }
   virtual void Finish() {
     ARROW_CHECK_OK(client_.Disconnect());
@@ -52,6 +65,7 @@ class TestPlasmaStore : public ::testing::Test {
   }
 
  protected:
+  std::string store_socket_name_;
   PlasmaClient client_;
 };
 
@@ -127,6 +141,231 @@ TEST_F(TestPlasmaStore, MultipleGetTest) {
   ASSERT_EQ(object_buffer[1].data[0], 2);
 }
 
+TEST_F(TestPlasmaStore, NotificationTest) {
+  int fd;
+  ARROW_CHECK_OK(client_.Subscribe(&fd));
+
+  std::vector<ObjectID> object_ids;
+  uint8_t metadata[] = {5};
+  int64_t metadata_size = sizeof(metadata);
+  uint8_t* data;
+  for (int64_t i = 0; i < 10; i++) {
+    ObjectID object_id = ObjectID::from_random();
+    ARROW_CHECK_OK(client_.Create(object_id, i + 1, metadata, metadata_size, &data));
+    ARROW_CHECK_OK(client_.Seal(object_id));
+    object_ids.push_back(object_id);
+  }
+
+  // The subscription also reports objects that existed before, so skip those.
+  std::vector<ObjectNotification> notifications;
+  size_t num_found = 0;
+  while (num_found < object_ids.size()) {
+    notifications.clear();
+    ARROW_CHECK_OK(client_.GetNotifications(fd, &notifications));
+    for (const auto& notification : notifications) {
+      if (num_found < object_ids.size() &&
+          notification.object_id == object_ids[num_found]) {
+        ASSERT_EQ(notification.data_size, static_cast<int64_t>(num_found + 1));
+        ASSERT_EQ(notification.metadata_size, metadata_size);
+        num_found++;
+      }
+    }
+  }
+  close(fd);
+}
+
+TEST_F(TestPlasmaStore, AbortTest) {
+  ObjectID object_id = ObjectID::from_random();
+  uint8_t* data;
+  ARROW_CHECK_OK(client_.Create(object_id, 100, nullptr, 0, &data));
+  ARROW_CHECK_OK(client_.Abort(object_id));
+
+  // The object is gone and its ID can be used again.
+  bool has_object;
+  ARROW_CHECK_OK(client_.Contains(object_id, &has_object));
+  ASSERT_FALSE(has_object);
+  ObjectBuffer object_buffer;
+  ARROW_CHECK_OK(client_.Get(&object_id, 1, 0, &object_buffer));
+  ASSERT_EQ(object_buffer.data_size, -1);
+  ARROW_CHECK_OK(client_.Create(object_id, 100, nullptr, 0, &data));
+  ARROW_CHECK_OK(client_.Seal(object_id));
+  ARROW_CHECK_OK(client_.Get(&object_id, 1, -1, &object_buffer));
+  ASSERT_EQ(object_buffer.data_size, 100);
+  ARROW_CHECK_OK(client_.Release(object_id));
+}
+
+TEST_F(TestPlasmaStore, HashTest) {
+  ObjectID object_id1 = ObjectID::from_random();
+  ObjectID object_id2 = ObjectID::from_random();
+  // Large enough to be hashed in chunks on the thread pool.
+  int64_t data_size = 3 * kDefaultParallelThreshold + 17;
+  uint8_t metadata[] = {5};
+  int64_t metadata_size = sizeof(metadata);
+  uint8_t* data;
+
+  ARROW_CHECK_OK(client_.Create(object_id1, data_size, metadata, metadata_size, &data));
+  for (int64_t i = 0; i < data_size; i++) {
+    data[i] = static_cast<uint8_t>(i % 251);
+  }
+  ARROW_CHECK_OK(client_.Seal(object_id1));
+
+  // Hash the second object while it is being written.
+  uint8_t* data2;
+  ARROW_CHECK_OK(client_.Create(object_id2, data_size, metadata, metadata_size, &data2));
+  int64_t step = data_size / 5;
+  for (int64_t offset = 0; offset < data_size; offset += step) {
+    int64_t length = std::min(step, data_size - offset);
+    client_.Memcopy(data2 + offset, data + offset, length);
+    ARROW_CHECK_OK(client_.UpdateDigest(object_id2, length));
+  }
+  ASSERT_FALSE(client_.UpdateDigest(object_id2, 1).ok());
+  ARROW_CHECK_OK(client_.Seal(object_id2));
+  ASSERT_FALSE(client_.UpdateDigest(object_id2, 1).ok());
+
+  uint8_t digest1[kDigestSize];
+  uint8_t digest2[kDigestSize];
+  ARROW_CHECK_OK(client_.Hash(object_id1, digest1));
+  ARROW_CHECK_OK(client_.Hash(object_id2, digest2));
+  ASSERT_EQ(memcmp(digest1, digest2, kDigestSize), 0);
+
+  // The digest does not depend on the number of threads.
+  PlasmaClient client2;
+  ASSERT_TRUE(client2.SetNumThreads(0).IsInvalid());
+  ARROW_CHECK_OK(client2.SetNumThreads(1));
+  ARROW_CHECK_OK(client2.Connect(store_socket_name_, "", PLASMA_DEFAULT_RELEASE_DELAY));
+  ASSERT_TRUE(client2.SetNumThreads(4).IsInvalid());
+  ARROW_CHECK_OK(client2.Hash(object_id1, digest2));
+  ASSERT_EQ(memcmp(digest1, digest2, kDigestSize), 0);
+  ARROW_CHECK_OK(client2.Disconnect());
+}
+
+TEST_F(TestPlasmaStore, QuotaTest) {
+  PlasmaClient client;
+  ARROW_CHECK_OK(client.SetQuota(1000));
+  ARROW_CHECK_OK(client.Connect(store_socket_name_, "", 0));
+  ASSERT_TRUE(client.SetQuota(2000).IsInvalid());
+
+  ObjectID object_id1 = ObjectID::from_random();
+  ObjectID object_id2 = ObjectID::from_random();
+  ObjectID object_id3 = ObjectID::from_random();
+  uint8_t* data;
+  ARROW_CHECK_OK(client.Create(object_id1, 600, nullptr, 0, &data));
+  ARROW_CHECK_OK(client.Seal(object_id1));
+  ARROW_CHECK_OK(client.Release(object_id1));
+
+  // The client's own unused object is evicted to make room.
+  ARROW_CHECK_OK(client.Create(object_id2, 600, nullptr, 0, &data));
+  bool has_object;
+  ARROW_CHECK_OK(client.Contains(object_id1, &has_object));
+  ASSERT_FALSE(has_object);
+
+  // Objects that are in use are not evicted, so the create fails.
+  ASSERT_TRUE(client.Create(object_id3, 600, nullptr, 0, &data).IsPlasmaStoreFull());
+  ARROW_CHECK_OK(client.Seal(object_id2));
+  ARROW_CHECK_OK(client.Release(object_id2));
+  ARROW_CHECK_OK(client.Create(object_id3, 600, nullptr, 0, &data));
+  ARROW_CHECK_OK(client.Seal(object_id3));
+
+  // Clients without a quota are not affected.
+  ObjectID object_id4 = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Create(object_id4, 2000, nullptr, 0, &data));
+  ARROW_CHECK_OK(client_.Seal(object_id4));
+  ARROW_CHECK_OK(client.Disconnect());
+}
+
+TEST_F(TestPlasmaStore, MetricsTest) {
+  auto get_metric = [](const StoreMetrics& metrics, const std::string& name) {
+    for (const auto& metric : metrics) {
+      if (metric.first == name) {
+        return metric.second;
+      }
+    }
+    return static_cast<int64_t>(-1);
+  };
+  StoreMetrics before;
+  ARROW_CHECK_OK(client_.Metrics(&before));
+
+  ObjectID object_id = ObjectID::from_random();
+  uint8_t* data;
+  ARROW_CHECK_OK(client_.Create(object_id, 100, nullptr, 0, &data));
+  ARROW_CHECK_OK(client_.Seal(object_id));
+  ASSERT_TRUE(client_.Create(object_id, 100, nullptr, 0, &data).IsPlasmaObjectExists());
+
+  StoreMetrics after;
+  ARROW_CHECK_OK(client_.Metrics(&after));
+  ASSERT_EQ(get_metric(before, "num_creates") + 1, get_metric(after, "num_creates"));
+  ASSERT_EQ(get_metric(before, "num_create_failures") + 1,
+            get_metric(after, "num_create_failures"));
+  ASSERT_EQ(get_metric(before, "num_seals") + 1, get_metric(after, "num_seals"));
+  ASSERT_GE(get_metric(after, "bytes_in_use"), 100);
+  ASSERT_GE(get_metric(after, "malloc_footprint"), get_metric(after, "bytes_in_use"));
+  ASSERT_GT(get_metric(after, "request_latency_max_ns"), 0);
+
+  // Only objects deleted by the eviction policy count as evictions.
+  PlasmaClient client;
+  ARROW_CHECK_OK(client.Connect(store_socket_name_, "", 0));
+  ObjectID aborted_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client.Create(aborted_id, 100, nullptr, 0, &data));
+  ARROW_CHECK_OK(client.Abort(aborted_id));
+  ObjectID evicted_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client.Create(evicted_id, 100, nullptr, 0, &data));
+  ARROW_CHECK_OK(client.Seal(evicted_id));
+  ARROW_CHECK_OK(client.Release(evicted_id));
+  int64_t num_bytes_evicted;
+  ARROW_CHECK_OK(client.Evict(1000000000, num_bytes_evicted));
+  ASSERT_GE(num_bytes_evicted, 100);
+  StoreMetrics evicted;
+  ARROW_CHECK_OK(client.Metrics(&evicted));
+  ASSERT_GE(get_metric(evicted, "num_evictions"), get_metric(after, "num_evictions") + 1);
+  ASSERT_EQ(get_metric(evicted, "num_bytes_evicted"),
+            get_metric(after, "num_bytes_evicted") + num_bytes_evicted);
+  ARROW_CHECK_OK(client.Disconnect());
+}
+
+TEST_F(TestPlasmaStore, RecordBatchTest) {
+  arrow::Int64Builder int_builder;
+  arrow::StringBuilder string_builder;
+  for (int64_t i = 0; i < 1000; i++) {
+    ARROW_CHECK_OK(int_builder.Append(i));
+    ARROW_CHECK_OK(string_builder.Append(std::to_string(i)));
+  }
+  std::shared_ptr<arrow::Array> ints;
+  std::shared_ptr<arrow::Array> strings;
+  ARROW_CHECK_OK(int_builder.Finish(&ints));
+  ARROW_CHECK_OK(string_builder.Finish(&strings));
+  auto schema = arrow::schema({arrow::field("ints", ints->type()),
+                               arrow::field("strings", strings->type())});
+  std::vector<std::shared_ptr<arrow::Array>> columns = {ints, strings};
+  auto batch = std::make_shared<arrow::RecordBatch>(schema, ints->length(), columns);
+
+  ObjectID object_id = ObjectID::from_random();
+  ARROW_CHECK_OK(PutRecordBatch(&client_, object_id, *batch));
+
+  std::shared_ptr<arrow::RecordBatch> result;
+  ASSERT_TRUE(GetRecordBatch(&client_, ObjectID::from_random(), 0, &result)
+                  .IsPlasmaObjectNonexistent());
+  ARROW_CHECK_OK(GetRecordBatch(&client_, object_id, -1, &result));
+  ASSERT_TRUE(result->Equals(*batch));
+
+  // The data was not copied out of the object.
+  ObjectBuffer object_buffer;
+  ARROW_CHECK_OK(client_.Get(&object_id, 1, -1, &object_buffer));
+  const uint8_t* values = result->column(0)->data()->buffers[1]->data();
+  ASSERT_GE(values, object_buffer.data);
+  ASSERT_LT(values, object_buffer.data + object_buffer.data_size);
+  ARROW_CHECK_OK(client_.Release(object_id));
+
+  // Store the batch twice as a two-chunk table.
+  std::shared_ptr<arrow::Table> table;
+  ARROW_CHECK_OK(arrow::Table::FromRecordBatches({batch, batch}, &table));
+  ObjectID table_id = ObjectID::from_random();
+  ARROW_CHECK_OK(PutTable(&client_, table_id, *table));
+  std::shared_ptr<arrow::Table> table_result;
+  ARROW_CHECK_OK(GetTable(&client_, table_id, -1, &table_result));
+  ASSERT_TRUE(table_result->Equals(*table));
+  ASSERT_EQ(table_result->column(0)->data()->num_chunks(), 2);
+}
+
 }  // namespace plasma
 
 int main(int argc, char** argv) {
@@ -224,6 +224,29 @@ TEST(PlasmaSerialization, DeleteReply) {
   close(fd);
 }
 
+TEST(PlasmaSerialization, AbortRequest) {
+  int fd = create_temp_file();
+  ObjectID object_id1 = ObjectID::from_random();
+  ARROW_CHECK_OK(SendAbortRequest(fd, object_id1));
+  std::vector<uint8_t> data = read_message_from_file(fd, MessageType_PlasmaAbortRequest);
+  ObjectID object_id2;
+  ARROW_CHECK_OK(ReadAbortRequest(data.data(), data.size(), &object_id2));
+  ASSERT_EQ(object_id1, object_id2);
+  close(fd);
+}
+
+TEST(PlasmaSerialization, AbortReply) {
+  int fd = create_temp_file();
+  ObjectID object_id1 = ObjectID::from_random();
+  ARROW_CHECK_OK(SendAbortReply(fd, object_id1, PlasmaError_ObjectNonexistent));
+  std::vector<uint8_t> data = read_message_from_file(fd, MessageType_PlasmaAbortReply);
+  ObjectID object_id2;
+  Status s = ReadAbortReply(data.data(), data.size(), &object_id2);
+  ASSERT_EQ(object_id1, object_id2);
+  ASSERT_TRUE(s.IsPlasmaObjectNonexistent());
+  close(fd);
+}
+
 TEST(PlasmaSerialization, StatusRequest) {
   int fd = create_temp_file();
   constexpr int64_t num_objects = 2;
@@ -261,6 +284,29 @@ TEST(PlasmaSerialization, StatusReply) {
   close(fd);
 }
 
+TEST(PlasmaSerialization, ConnectRequest) {
+  int fd = create_temp_file();
+  int64_t quota1 = 1000;
+  ARROW_CHECK_OK(SendConnectRequest(fd, quota1));
+  std::vector<uint8_t> data =
+      read_message_from_file(fd, MessageType_PlasmaConnectRequest);
+  int64_t quota2;
+  ARROW_CHECK_OK(ReadConnectRequest(data.data(), data.size(), &quota2));
+  ASSERT_EQ(quota1, quota2);
+  close(fd);
+}
+
+TEST(PlasmaSerialization, MetricsReply) {
+  int fd = create_temp_file();
+  StoreMetrics metrics1 = {{"num_creates", 3}, {"bytes_in_use", 1 << 20}};
+  ARROW_CHECK_OK(SendMetricsReply(fd, metrics1));
+  std::vector<uint8_t> data = read_message_from_file(fd, MessageType_PlasmaMetricsReply);
+  StoreMetrics metrics2;
+  ARROW_CHECK_OK(ReadMetricsReply(data.data(), data.size(), &metrics2));
+  ASSERT_EQ(metrics1, metrics2);
+  close(fd);
+}
+
 TEST(PlasmaSerialization, EvictRequest) {
   int fd = create_temp_file();
   int64_t num_bytes = 111;